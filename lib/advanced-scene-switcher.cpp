@@ -1,6 +1,7 @@
 #include "advanced-scene-switcher.hpp"
 #include "backup.hpp"
 #include "curl-helper.hpp"
+#include "deadline-scheduler.hpp"
 #include "log-helper.hpp"
 #include "macro-helpers.hpp"
 #include "obs-module-helper.hpp"
@@ -12,6 +13,7 @@
 #include "switcher-data.hpp"
 #include "ui-helpers.hpp"
 #include "tab-helpers.hpp"
+#include "tick-watchdog.hpp"
 #include "utility.hpp"
 #include "version.h"
 #include "websocket-api.hpp"
@@ -21,7 +23,6 @@
 #include <QDirIterator>
 #include <QMainWindow>
 #include <QTextStream>
-#include <regex>
 
 namespace advss {
 
@@ -221,6 +222,25 @@ static void SaveSceneSwitcher(obs_data_t *save_data, bool saving, void *)
 /******************************************************************************
  * Main switcher thread
  ******************************************************************************/
+// Minimum time between the start of two checks, if checks were requested
+// using RequestImmediateCheck()
+constexpr std::chrono::milliseconds minRequestedCheckDelay(10);
+
+// Limits the time to wait, so the main loop wakes up as soon as time based
+// conditions expect their state to change
+static std::chrono::milliseconds
+limitToNextDeadline(std::chrono::milliseconds duration)
+{
+	const auto now = DeadlineScheduler::Clock::now();
+	const auto deadline = GetDeadlineScheduler().NextDeadline(now);
+	if (!deadline) {
+		return duration;
+	}
+	const auto untilDeadline =
+		std::chrono::ceil<std::chrono::milliseconds>(*deadline - now);
+	return std::min(duration, untilDeadline);
+}
+
 void SwitcherData::Thread()
 {
 	blog(LOG_INFO, "started");
@@ -247,6 +267,9 @@ void SwitcherData::Thread()
 			std::chrono::duration_cast<std::chrono::milliseconds>(
 				endTime - startTime);
 
+		// Requests arriving after this point have to wake up the wait
+		// below, as they are not accounted for in its duration
+		const bool checkAlreadyRequested = checkRequested;
 		if (sleep) {
 			duration = std::chrono::milliseconds(sleep);
 		} else {
@@ -257,17 +280,36 @@ void SwitcherData::Thread()
 				      "detected busy loop - refusing to sleep less than 1ms");
 				duration = std::chrono::milliseconds(10);
 			}
+			if (checkAlreadyRequested) {
+				// Still limit how often conditions are checked,
+				// if checks are requested continuously
+				duration = std::min(duration,
+						    minRequestedCheckDelay -
+							    runTime);
+			}
+			duration = limitToNextDeadline(duration);
+			// The requested check delay or the next deadline might
+			// already have passed
+			duration = std::max(duration,
+					    std::chrono::milliseconds(1));
 		}
 
 		vblog(LOG_INFO, "try to sleep for %ld",
 		      (long int)duration.count());
 		SetWaitScene();
-		cv.wait_for(lock, duration);
+		cv.wait_for(lock, duration, [this, checkAlreadyRequested]() {
+			return stop || SceneChangedDuringWait() ||
+			       (!checkAlreadyRequested && checkRequested);
+		});
+		checkRequested = false;
 
 		startTime = std::chrono::high_resolution_clock::now();
 		sleep = 0;
 		linger = 0;
 
+		auto &watchdog = GetTickWatchdog();
+		watchdog.StartTick();
+		watchdog.StartPhase(TickWatchdog::Phase::PRUNE);
 		Prune();
 		if (stop) {
 			break;
@@ -275,7 +317,9 @@ void SwitcherData::Thread()
 		if (checkPause()) {
 			continue;
 		}
+		watchdog.StartPhase(TickWatchdog::Phase::PRECONDITIONS);
 		SetPreconditions();
+		watchdog.StartPhase(TickWatchdog::Phase::CHECK);
 		match = CheckForMatch(scene, transition, linger,
 				      setPrevSceneAfterLinger, macroMatch);
 		if (stop) {
@@ -283,6 +327,7 @@ void SwitcherData::Thread()
 		}
 		CheckNoMatchSwitch(match, scene, transition, sleep);
 		checkSwitchCooldown(match);
+		watchdog.EndPhase();
 
 		if (linger) {
 			duration = std::chrono::milliseconds(linger);
@@ -290,7 +335,11 @@ void SwitcherData::Thread()
 			      (long int)duration.count());
 
 			SetWaitScene();
-			cv.wait_for(lock, duration);
+			// Requests to check conditions early must not cut the
+			// linger duration short
+			cv.wait_for(lock, duration, [this]() {
+				return stop || SceneChangedDuringWait();
+			});
 
 			if (stop) {
 				break;
@@ -309,6 +358,7 @@ void SwitcherData::Thread()
 
 		ResetForNextInterval();
 
+		watchdog.StartPhase(TickWatchdog::Phase::RUN);
 		if (match) {
 			if (macroMatch) {
 				RunMacros();
@@ -317,7 +367,9 @@ void SwitcherData::Thread()
 			}
 		}
 
+		watchdog.StartPhase(TickWatchdog::Phase::WRITE_STATUS);
 		writeSceneInfoToFile();
+		watchdog.EndTick(tickBudget > 0 ? tickBudget : interval);
 		switcher->firstInterval = false;
 		switcher->firstIntervalAfterStop = false;
 	}
@@ -332,18 +384,11 @@ void SwitcherData::SetPreconditions()
 	lastTitle = currentTitle;
 	std::string title;
 	GetCurrentWindowTitle(title);
-	for (auto &window : ignoreWindowsSwitches) {
-		bool equals = (title == window);
-		bool matches = false;
-		if (!equals) {
-			try {
-				std::regex expr(window);
-				matches = std::regex_match(title, expr);
-
-			} catch (const std::regex_error &) {
-			}
-		}
-		if (equals || matches) {
+	const auto qTitle = QString::fromStdString(title);
+	for (size_t i = 0; i < ignoreWindowsSwitches.size(); i++) {
+		const bool equals = (title == ignoreWindowsSwitches[i]);
+		if (equals ||
+		    ignoreWindowsExpressions[i].match(qTitle).hasMatch()) {
 			title = lastTitle;
 			break;
 		}
@@ -437,7 +437,10 @@ void SwitcherData::LoadSettings(obs_data_t *obj)
 	}
 
 	// New post load steps to be declared during load
-	postLoadSteps.clear();
+	{
+		std::lock_guard<std::mutex> lock(postLoadStepsMutex);
+		postLoadSteps.clear();
+	}
 
 	// Needs to be loaded before any entries which might rely on scene group
 	// selections to be available.
@@ -510,6 +513,7 @@ void SwitcherData::SaveSettings(obs_data_t *obj)
 void SwitcherData::SaveGeneralSettings(obs_data_t *obj)
 {
 	obs_data_set_int(obj, "interval", interval);
+	obs_data_set_int(obj, "tickBudget", tickBudget);
 
 	std::string nonMatchingSceneName = GetWeakSourceName(nonMatchingScene);
 	obs_data_set_string(obj, "non_matching_scene",
@@ -555,6 +559,7 @@ void SwitcherData::LoadGeneralSettings(obs_data_t *obj)
 {
 	obs_data_set_default_int(obj, "interval", default_interval);
 	interval = obs_data_get_int(obj, "interval");
+	tickBudget = obs_data_get_int(obj, "tickBudget");
 
 	obs_data_set_default_int(obj, "switch_if_not_matching",
 				 static_cast<int>(NoMatchBehavior::NO_SWITCH));
@@ -813,6 +818,31 @@ static int getGeneralTabIdx(QTabWidget *tabWidget)
 	return -1;
 }
 
+static void setupTickBudgetSelection(QGridLayout *layout)
+{
+	auto tickBudget = new QSpinBox();
+	tickBudget->setMinimumWidth(100);
+	tickBudget->setSuffix("ms");
+	tickBudget->setMaximum(60000);
+	tickBudget->setSpecialValueText(obs_module_text(
+		"AdvSceneSwitcher.generalTab.status.tickBudget.checkInterval"));
+	tickBudget->setValue(switcher->tickBudget);
+	tickBudget->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.generalTab.status.tickBudget.tooltip"));
+	QWidget::connect(
+		tickBudget, QOverload<int>::of(&QSpinBox::valueChanged),
+		[](int value) {
+			std::lock_guard<std::mutex> lock(switcher->m);
+			switcher->tickBudget = value;
+		});
+
+	const int row = layout->rowCount();
+	layout->addWidget(new QLabel(obs_module_text(
+				  "AdvSceneSwitcher.generalTab.status.tickBudget")),
+			  row, 0);
+	layout->addWidget(tickBudget, row, 1);
+}
+
 static void setupGeneralTabInactiveWarning(QTabWidget *tabs)
 {
 	auto callback = [tabs]() {
@@ -884,6 +914,7 @@ void AdvSceneSwitcher::SetupGeneralTab()
 
 	ui->checkInterval->setValue(switcher->interval);
 	SetCheckIntervalTooLowVisibility();
+	setupTickBudgetSelection(ui->statusLayout);
 
 	ui->enableCooldown->setChecked(switcher->enableCooldown);
 	ui->cooldownTime->setEnabled(switcher->enableCooldown);
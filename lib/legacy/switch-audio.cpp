@@ -7,8 +7,6 @@
 #include "utility.hpp"
 #include "volume-control.hpp"
 
-#include <float.h>
-
 namespace advss {
 
 bool AudioSwitch::pause = false;
@@ -137,19 +135,17 @@ bool SwitcherData::checkAudioSwitch(OBSWeakSource &scene,
 		}
 
 		// peak will have a value from -60 db to 0 db
+		const float peak = s.getPeakSinceLastCheck();
 		bool volumeThresholdreached = false;
 
 		if (s.condition == ABOVE) {
-			volumeThresholdreached = ((double)s.peak + 60) * 1.7 >
+			volumeThresholdreached = ((double)peak + 60) * 1.7 >
 						 s.volumeThreshold;
 		} else {
-			volumeThresholdreached = ((double)s.peak + 60) * 1.7 <
+			volumeThresholdreached = ((double)peak + 60) * 1.7 <
 						 s.volumeThreshold;
 		}
 
-		// Reset for next check
-		s.peak = -FLT_MAX;
-
 		if (!volumeThresholdreached) {
 			s.duration.Reset();
 		}
@@ -246,40 +242,21 @@ void AdvSceneSwitcher::SetupAudioTab()
 	ui->audioFallback->setChecked(switcher->audioFallback.enable);
 }
 
-void AudioSwitch::setVolumeLevel(void *data, const float *,
-				 const float peak[MAX_AUDIO_CHANNELS],
-				 const float *)
-{
-	AudioSwitch *s = static_cast<AudioSwitch *>(data);
-
-	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
-		if (peak[i] > s->peak) {
-			s->peak = peak[i];
-		}
-	}
-}
-
-obs_volmeter_t *AddVolmeterToSource(AudioSwitch *entry, obs_weak_source *source)
+float AudioSwitch::getPeakSinceLastCheck()
 {
-	obs_volmeter_t *volmeter = obs_volmeter_create(OBS_FADER_LOG);
-	obs_volmeter_add_callback(volmeter, AudioSwitch::setVolumeLevel, entry);
-	obs_source_t *as = obs_weak_source_get_source(source);
-	if (!obs_volmeter_attach_source(volmeter, as)) {
-		const char *name = obs_source_get_name(as);
-		blog(LOG_WARNING, "failed to attach volmeter to source %s",
-		     name);
+	if (!levelTap) {
+		return -std::numeric_limits<float>::infinity();
 	}
-	obs_source_release(as);
 
-	return volmeter;
+	const auto now = AudioLevelTap::Clock::now();
+	const auto stats = levelTap->GetStatistics(lastCheck);
+	lastCheck = now;
+	return stats.maxPeak;
 }
 
-void AudioSwitch::resetVolmeter()
+void AudioSwitch::updateLevelTap()
 {
-	obs_volmeter_remove_callback(volmeter, setVolumeLevel, this);
-	obs_volmeter_destroy(volmeter);
-
-	volmeter = AddVolmeterToSource(this, audioSource);
+	levelTap = AudioLevelTap::Get(audioSource);
 }
 
 bool AudioSwitch::initialized()
@@ -318,7 +295,7 @@ void AudioSwitch::load(obs_data_t *obj)
 	duration.Load(obj, "duration");
 	ignoreInactiveSource = obs_data_get_bool(obj, "ignoreInactiveSource");
 
-	volmeter = AddVolmeterToSource(this, audioSource);
+	updateLevelTap();
 }
 
 void AudioSwitchFallback::save(obs_data_t *obj)
@@ -347,9 +324,9 @@ AudioSwitch::AudioSwitch(const AudioSwitch &other)
 	  audioSource(other.audioSource),
 	  volumeThreshold(other.volumeThreshold),
 	  condition(other.condition),
-	  duration(other.duration)
+	  duration(other.duration),
+	  levelTap(other.levelTap)
 {
-	volmeter = AddVolmeterToSource(this, other.audioSource);
 }
 
 AudioSwitch::AudioSwitch(AudioSwitch &&other) noexcept
@@ -359,15 +336,9 @@ AudioSwitch::AudioSwitch(AudioSwitch &&other) noexcept
 	  volumeThreshold(other.volumeThreshold),
 	  condition(other.condition),
 	  duration(other.duration),
-	  volmeter(other.volmeter)
+	  levelTap(std::move(other.levelTap)),
+	  lastCheck(other.lastCheck)
 {
-	other.volmeter = nullptr;
-}
-
-AudioSwitch::~AudioSwitch()
-{
-	obs_volmeter_remove_callback(volmeter, setVolumeLevel, this);
-	obs_volmeter_destroy(volmeter);
 }
 
 AudioSwitch &AudioSwitch::operator=(const AudioSwitch &other)
@@ -384,10 +355,7 @@ AudioSwitch &AudioSwitch::operator=(AudioSwitch &&other) noexcept
 	}
 
 	swap(*this, other);
-
-	obs_volmeter_remove_callback(other.volmeter, setVolumeLevel, this);
-	obs_volmeter_destroy(other.volmeter);
-	other.volmeter = nullptr;
+	other.levelTap.reset();
 
 	return *this;
 }
@@ -403,10 +371,8 @@ void swap(AudioSwitch &first, AudioSwitch &second)
 	std::swap(first.volumeThreshold, second.volumeThreshold);
 	std::swap(first.condition, second.condition);
 	std::swap(first.duration, second.duration);
-	std::swap(first.peak, second.peak);
-	std::swap(first.volmeter, second.volmeter);
-	first.resetVolmeter();
-	second.resetVolmeter();
+	std::swap(first.levelTap, second.levelTap);
+	std::swap(first.lastCheck, second.lastCheck);
 }
 
 static inline void populateConditionSelection(QComboBox *list)
@@ -550,7 +516,7 @@ void AudioSwitchWidget::SourceChanged(const QString &text)
 
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switchData->audioSource = GetWeakSourceByQString(text);
-	switchData->resetVolmeter();
+	switchData->updateLevelTap();
 	UpdateVolmeterSource();
 }
 
@@ -10,6 +10,7 @@
 #include <limits>
 
 #include "switch-generic.hpp"
+#include "audio-level-tap.hpp"
 #include "duration-control.hpp"
 #include "volume-control.hpp"
 
@@ -29,24 +30,20 @@ struct AudioSwitch : virtual SceneSwitcherEntry {
 	audioCondition condition = ABOVE;
 	Duration duration;
 	bool ignoreInactiveSource = true;
-	float peak = -std::numeric_limits<float>::infinity();
-	obs_volmeter_t *volmeter = nullptr;
+	std::shared_ptr<AudioLevelTap> levelTap;
+	AudioLevelTap::Clock::time_point lastCheck{};
 
 	const char *getType() { return "audio"; }
 	bool initialized();
 	bool valid();
 	void save(obs_data_t *obj);
 	void load(obs_data_t *obj);
-	static void setVolumeLevel(void *data,
-				   const float magnitude[MAX_AUDIO_CHANNELS],
-				   const float peak[MAX_AUDIO_CHANNELS],
-				   const float inputPeak[MAX_AUDIO_CHANNELS]);
-	void resetVolmeter();
+	float getPeakSinceLastCheck();
+	void updateLevelTap();
 
 	AudioSwitch(){};
 	AudioSwitch(const AudioSwitch &other);
 	AudioSwitch(AudioSwitch &&other) noexcept;
-	~AudioSwitch();
 	AudioSwitch &operator=(const AudioSwitch &other);
 	AudioSwitch &operator=(AudioSwitch &&other) noexcept;
 	friend void swap(AudioSwitch &first, AudioSwitch &second);
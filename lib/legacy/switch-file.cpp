@@ -1,5 +1,6 @@
 #include "advanced-scene-switcher.hpp"
 #include "curl-helper.hpp"
+#include "file-writer.hpp"
 #include "layout-helpers.hpp"
 #include "source-helpers.hpp"
 #include "switcher-data.hpp"
@@ -7,7 +8,6 @@
 #include "utility.hpp"
 
 #include <obs-frontend-api.h>
-#include <QtGlobal>
 #include <QFileDialog>
 #include <QTextStream>
 #include <QDateTime>
@@ -101,16 +101,12 @@ void SwitcherData::writeSceneInfoToFile()
 		return;
 	}
 
-	QFile file(QString::fromStdString(fileIO.writePath));
-	if (file.open(QIODevice::WriteOnly)) {
-		// switcher->currentScene cannot be used here as scene might
-		// have changed already
-		obs_source_t *source = obs_frontend_get_current_scene();
-		auto msg = obs_source_get_name(source);
-		obs_source_release(source);
-		file.write(msg, qstrlen(msg));
-		file.close();
-	}
+	// switcher->currentScene cannot be used here as scene might have
+	// changed already
+	OBSSourceAutoRelease source = obs_frontend_get_current_scene();
+	const char *name = obs_source_get_name(source);
+	// The file is only actually rewritten if the scene changed
+	GetFileWriter().Write(fileIO.writePath, name ? name : "");
 }
 
 void SwitcherData::writeToStatusFile(const QString &msg)
@@ -119,16 +115,7 @@ void SwitcherData::writeToStatusFile(const QString &msg)
 		return;
 	}
 
-	QFile file(QString::fromStdString(fileIO.writePath));
-	if (file.open(QIODevice::ReadWrite)) {
-		QTextStream stream(&file);
-#if QT_VERSION < QT_VERSION_CHECK(6, 0, 0)
-		stream << msg << "\n";
-#else
-		stream << msg << Qt::endl;
-#endif
-	}
-	file.close();
+	GetFileWriter().Write(fileIO.writePath, msg.toStdString() + "\n");
 }
 
 bool SwitcherData::checkSwitchInfoFromFile(OBSWeakSource &scene,
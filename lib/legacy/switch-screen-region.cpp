@@ -6,6 +6,7 @@
 #include "ui-helpers.hpp"
 #include "utility.hpp"
 
+#include <algorithm>
 #include <QTimer>
 
 namespace advss {
@@ -75,6 +76,7 @@ void AdvSceneSwitcher::on_screenRegionAdd_clicked()
 {
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switcher->screenRegionSwitches.emplace_back();
+	switcher->screenRegionIndex.Invalidate();
 
 	listAddClicked(ui->screenRegionSwitches,
 		       new ScreenRegionWidget(
@@ -96,6 +98,7 @@ void AdvSceneSwitcher::on_screenRegionRemove_clicked()
 		int idx = ui->screenRegionSwitches->currentRow();
 		auto &switches = switcher->screenRegionSwitches;
 		switches.erase(switches.begin() + idx);
+		switcher->screenRegionIndex.Invalidate();
 	}
 
 	delete item;
@@ -120,6 +123,7 @@ void AdvSceneSwitcher::on_screenRegionUp_clicked()
 
 	std::swap(switcher->screenRegionSwitches[index],
 		  switcher->screenRegionSwitches[index - 1]);
+	switcher->screenRegionIndex.Invalidate();
 }
 
 void AdvSceneSwitcher::on_screenRegionDown_clicked()
@@ -142,6 +146,7 @@ void AdvSceneSwitcher::on_screenRegionDown_clicked()
 
 	std::swap(switcher->screenRegionSwitches[index],
 		  switcher->screenRegionSwitches[index + 1]);
+	switcher->screenRegionIndex.Invalidate();
 }
 
 bool shouldIgnoreSceneSwitch(ScreenRegionSwitch &matchingRegion)
@@ -164,35 +169,89 @@ bool SwitcherData::checkScreenRegionSwitch(OBSWeakSource &scene,
 	int minRegionSize = 99999;
 	bool match = false;
 
-	for (auto &s : screenRegionSwitches) {
+	const auto &regions = screenRegionIndex.Find(
+		screenRegionSwitches, cursorPos.first, cursorPos.second);
+	for (const auto idx : regions) {
+		auto &s = screenRegionSwitches[idx];
 		if (!s.initialized()) {
 			continue;
 		}
 
-		if (cursorPos.first >= s.minX && cursorPos.second >= s.minY &&
-		    cursorPos.first <= s.maxX && cursorPos.second <= s.maxY) {
-			int regionSize = (s.maxX - s.minX) + (s.maxY - s.minY);
-			if (regionSize < minRegionSize) {
-				if (shouldIgnoreSceneSwitch(s)) {
-					// We technically have a match.
-					// But just ignore it.
-					return false;
-				}
-				match = true;
-				scene = s.getScene();
-				transition = s.transition;
-				minRegionSize = regionSize;
-
-				if (VerboseLoggingEnabled()) {
-					s.logMatch();
-				}
-				break;
+		int regionSize = (s.maxX - s.minX) + (s.maxY - s.minY);
+		if (regionSize < minRegionSize) {
+			if (shouldIgnoreSceneSwitch(s)) {
+				// We technically have a match.
+				// But just ignore it.
+				return false;
 			}
+			match = true;
+			scene = s.getScene();
+			transition = s.transition;
+			minRegionSize = regionSize;
+
+			if (VerboseLoggingEnabled()) {
+				s.logMatch();
+			}
+			break;
 		}
 	}
 	return match;
 }
 
+void ScreenRegionIndex::Build(const std::deque<ScreenRegionSwitch> &regions)
+{
+	_borders.clear();
+	_slabs.clear();
+	for (const auto &region : regions) {
+		if (region.minX > region.maxX) {
+			continue;
+		}
+		_borders.push_back(region.minX);
+		_borders.push_back(int64_t(region.maxX) + 1);
+	}
+	std::sort(_borders.begin(), _borders.end());
+	_borders.erase(std::unique(_borders.begin(), _borders.end()),
+		       _borders.end());
+
+	_slabs.resize(_borders.size());
+	for (size_t idx = 0; idx < regions.size(); idx++) {
+		const auto &region = regions[idx];
+		if (region.minX > region.maxX) {
+			continue;
+		}
+		const auto end = int64_t(region.maxX) + 1;
+		auto it = std::lower_bound(_borders.begin(), _borders.end(),
+					   int64_t(region.minX));
+		for (; it != _borders.end() && *it < end; ++it) {
+			_slabs[it - _borders.begin()].push_back(idx);
+		}
+	}
+	_valid = true;
+}
+
+const std::vector<size_t> &
+ScreenRegionIndex::Find(const std::deque<ScreenRegionSwitch> &regions, int x,
+			int y)
+{
+	if (!_valid) {
+		Build(regions);
+	}
+
+	_result.clear();
+	auto it = std::upper_bound(_borders.begin(), _borders.end(),
+				   int64_t(x));
+	if (it == _borders.begin()) {
+		return _result;
+	}
+	for (const auto idx : _slabs[it - _borders.begin() - 1]) {
+		const auto &region = regions[idx];
+		if (y >= region.minY && y <= region.maxY) {
+			_result.push_back(idx);
+		}
+	}
+	return _result;
+}
+
 void AdvSceneSwitcher::updateScreenRegionCursorPos()
 {
 	std::pair<int, int> position = GetCursorPos();
@@ -233,6 +292,7 @@ void SwitcherData::loadScreenRegionSwitches(obs_data_t *obj)
 		obs_data_release(array_obj);
 	}
 	obs_data_array_release(screenRegionArray);
+	screenRegionIndex.Invalidate();
 }
 
 void AdvSceneSwitcher::SetupRegionTab()
@@ -407,6 +467,7 @@ void ScreenRegionWidget::MinXChanged(int pos)
 
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switchData->minX = pos;
+	switcher->screenRegionIndex.Invalidate();
 
 	drawFrame();
 }
@@ -419,6 +480,7 @@ void ScreenRegionWidget::MinYChanged(int pos)
 
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switchData->minY = pos;
+	switcher->screenRegionIndex.Invalidate();
 
 	drawFrame();
 }
@@ -431,6 +493,7 @@ void ScreenRegionWidget::MaxXChanged(int pos)
 
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switchData->maxX = pos;
+	switcher->screenRegionIndex.Invalidate();
 
 	drawFrame();
 }
@@ -443,6 +506,7 @@ void ScreenRegionWidget::MaxYChanged(int pos)
 
 	std::lock_guard<std::mutex> lock(switcher->m);
 	switchData->maxY = pos;
+	switcher->screenRegionIndex.Invalidate();
 
 	drawFrame();
 }
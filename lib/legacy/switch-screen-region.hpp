@@ -9,6 +9,9 @@
 #include <QSpinBox>
 #include "switch-generic.hpp"
 
+#include <deque>
+#include <vector>
+
 namespace advss {
 
 constexpr auto screen_region_func = 4;
@@ -23,6 +26,30 @@ struct ScreenRegionSwitch : SceneSwitcherEntry {
 	void load(obs_data_t *obj);
 };
 
+// Maps screen positions to the regions containing them, so the cursor position
+// does not have to be compared against every region on each interval.
+// The screen is split into vertical slabs at the horizontal borders of all
+// regions, so each slab is either fully covered by a region or not at all.
+class ScreenRegionIndex {
+public:
+	// Must be called whenever regions are added, removed, reordered or
+	// their coordinates are modified
+	void Invalidate() { _valid = false; }
+	// Returns the indices of the regions containing the given position in
+	// ascending order
+	const std::vector<size_t> &
+	Find(const std::deque<ScreenRegionSwitch> &regions, int x, int y);
+
+private:
+	void Build(const std::deque<ScreenRegionSwitch> &regions);
+
+	bool _valid = false;
+	std::vector<int64_t> _borders;
+	// Regions covering the range from the respective border up to the next
+	std::vector<std::vector<size_t>> _slabs;
+	std::vector<size_t> _result;
+};
+
 class ScreenRegionWidget : public SwitchWidget {
 	Q_OBJECT
 
@@ -1,4 +1,5 @@
 #include "advanced-scene-switcher.hpp"
+#include "deadline-scheduler.hpp"
 #include "layout-helpers.hpp"
 #include "switcher-data.hpp"
 #include "ui-helpers.hpp"
@@ -118,13 +119,66 @@ bool checkRegularTime(TimeSwitch &s, int &interval)
 	return timesAreInInterval(s.time, now, interval);
 }
 
+static QDateTime getNextSwitchTime(const TimeSwitch &s,
+				   const QDateTime &liveTime,
+				   const QDateTime &now)
+{
+	if (s.time.isNull()) {
+		return {};
+	}
+
+	if (s.trigger == LIVE) {
+		if (liveTime.isNull()) {
+			return {};
+		}
+		return liveTime.addMSecs(s.time.msecsSinceStartOfDay());
+	}
+
+	QDateTime next(now.date(), s.time);
+	if (next <= now) {
+		next = next.addDays(1);
+	}
+	while (s.trigger != ANY_DAY && next.date().dayOfWeek() != s.trigger) {
+		next = next.addDays(1);
+	}
+	return next;
+}
+
+// Wakes up the main loop right when the next time switch is due instead of
+// only noticing it with the next interval
+static void scheduleNextTimeSwitch(const std::deque<TimeSwitch> &switches,
+				   const QDateTime &liveTime)
+{
+	const auto now = QDateTime::currentDateTime();
+	QDateTime next;
+	for (const auto &s : switches) {
+		const auto time = getNextSwitchTime(s, liveTime, now);
+		if (time.isValid() && time > now &&
+		    (!next.isValid() || time < next)) {
+			next = time;
+		}
+	}
+
+	auto &scheduler = GetDeadlineScheduler();
+	if (!next.isValid()) {
+		scheduler.Cancel(&switches);
+		return;
+	}
+	const auto deadline = DeadlineScheduler::Clock::now() +
+			      std::chrono::milliseconds(now.msecsTo(next));
+	scheduler.Schedule(&switches, deadline);
+}
+
 bool SwitcherData::checkTimeSwitch(OBSWeakSource &scene,
 				   OBSWeakSource &transition)
 {
 	if (TimeSwitch::pause) {
+		GetDeadlineScheduler().Cancel(&timeSwitches);
 		return false;
 	}
 
+	scheduleNextTimeSwitch(timeSwitches, liveTime);
+
 	bool match = false;
 	for (TimeSwitch &s : timeSwitches) {
 		if (!s.initialized()) {
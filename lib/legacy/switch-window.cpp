@@ -6,7 +6,7 @@
 #include "ui-helpers.hpp"
 #include "utility.hpp"
 
-#include <regex>
+#include <unordered_set>
 
 namespace advss {
 
@@ -107,6 +107,7 @@ void AdvSceneSwitcher::on_ignoreWindowsAdd_clicked()
 		std::lock_guard<std::mutex> lock(switcher->m);
 		switcher->ignoreWindowsSwitches.emplace_back(
 			windowName.toUtf8().constData());
+		switcher->updateIgnoreWindowsExpressions();
 	}
 
 	ui->ignoreWindowHelp->setVisible(false);
@@ -133,6 +134,7 @@ void AdvSceneSwitcher::on_ignoreWindowsRemove_clicked()
 				break;
 			}
 		}
+		switcher->updateIgnoreWindowsExpressions();
 	}
 
 	delete item;
@@ -178,6 +180,29 @@ void AdvSceneSwitcher::on_ignoreWindows_currentRowChanged(int idx)
 	}
 }
 
+QRegularExpression CompileWindowTitleExpression(const std::string &title)
+{
+	QRegularExpression expression(QRegularExpression::anchoredPattern(
+		QString::fromStdString(title)));
+	expression.optimize();
+	return expression;
+}
+
+void WindowSwitch::setWindow(const std::string &title)
+{
+	window = title;
+	windowExpression = CompileWindowTitleExpression(title);
+}
+
+void SwitcherData::updateIgnoreWindowsExpressions()
+{
+	ignoreWindowsExpressions.clear();
+	for (const auto &window : ignoreWindowsSwitches) {
+		ignoreWindowsExpressions.emplace_back(
+			CompileWindowTitleExpression(window));
+	}
+}
+
 void checkWindowTitleSwitchDirect(WindowSwitch &s,
 				  std::string &currentWindowTitle, bool &match,
 				  OBSWeakSource &scene,
@@ -196,17 +221,18 @@ void checkWindowTitleSwitchDirect(WindowSwitch &s,
 
 void checkWindowTitleSwitchRegex(WindowSwitch &s,
 				 std::string &currentWindowTitle,
-				 std::vector<std::string> windowList,
+				 const std::vector<std::string> &windowList,
+				 const std::vector<QString> &windowTitles,
 				 bool &match, OBSWeakSource &scene,
 				 OBSWeakSource &transition)
 {
-	for (auto &window : windowList) {
-		try {
-			std::regex expr(s.window);
-			if (!std::regex_match(window, expr)) {
-				continue;
-			}
-		} catch (const std::regex_error &) {
+	// Invalid expressions never prevented a match, so keep it that way
+	const bool isValid = s.windowExpression.isValid();
+	for (size_t i = 0; i < windowList.size(); i++) {
+		const auto &window = windowList[i];
+		if (isValid &&
+		    !s.windowExpression.match(windowTitles[i]).hasMatch()) {
+			continue;
 		}
 
 		bool focus = (!s.focus || window == currentWindowTitle);
@@ -233,19 +259,27 @@ bool SwitcherData::checkWindowTitleSwitch(OBSWeakSource &scene,
 	std::vector<std::string> windowList;
 	GetWindowList(windowList);
 
+	// Only convert the window titles once instead of for every switch
+	const std::unordered_set<std::string> windows(windowList.begin(),
+						      windowList.end());
+	std::vector<QString> windowTitles;
+	windowTitles.reserve(windowList.size());
+	for (const auto &window : windowList) {
+		windowTitles.emplace_back(QString::fromStdString(window));
+	}
+
 	for (WindowSwitch &s : windowSwitches) {
 		if (!s.initialized()) {
 			continue;
 		}
 
-		if (std::find(windowList.begin(), windowList.end(), s.window) !=
-		    windowList.end()) {
+		if (windows.count(s.window) > 0) {
 			checkWindowTitleSwitchDirect(s, currentWindowTitle,
 						     match, scene, transition);
 		} else {
 			checkWindowTitleSwitchRegex(s, currentWindowTitle,
-						    windowList, match, scene,
-						    transition);
+						    windowList, windowTitles,
+						    match, scene, transition);
 		}
 
 		if (match) {
@@ -320,6 +354,7 @@ void SwitcherData::loadWindowTitleSwitches(obs_data_t *obj)
 		obs_data_release(array_obj);
 	}
 	obs_data_array_release(ignoreWindowsArray);
+	updateIgnoreWindowsExpressions();
 }
 
 void AdvSceneSwitcher::SetupTitleTab()
@@ -374,7 +409,7 @@ void WindowSwitch::load(obs_data_t *obj)
 {
 	SceneSwitcherEntry::load(obj);
 
-	window = obs_data_get_string(obj, "windowTitle");
+	setWindow(obs_data_get_string(obj, "windowTitle"));
 	fullscreen = obs_data_get_bool(obj, "fullscreen");
 	maximized = obs_data_get_bool(obj, "maximized");
 	focus = obs_data_get_bool(obj, "focus") ||
@@ -457,7 +492,7 @@ void WindowSwitchWidget::WindowChanged(const QString &text)
 	}
 
 	std::lock_guard<std::mutex> lock(switcher->m);
-	switchData->window = text.toStdString();
+	switchData->setWindow(text.toStdString());
 }
 
 void WindowSwitchWidget::FullscreenChanged(int state)
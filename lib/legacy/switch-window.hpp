@@ -8,17 +8,27 @@
 #pragma once
 #include "switch-generic.hpp"
 
+#include <QRegularExpression>
+
 namespace advss {
 
 constexpr auto window_title_func = 5;
 
+// Window titles might be specified as regular expressions, which have to match
+// the whole title.
+// The expressions are compiled whenever the title is changed instead of for
+// every window on every interval.
+QRegularExpression CompileWindowTitleExpression(const std::string &);
+
 struct WindowSwitch : SceneSwitcherEntry {
 	static bool pause;
 	std::string window = "";
 	bool fullscreen = false;
 	bool maximized = false;
 	bool focus = true;
+	QRegularExpression windowExpression = CompileWindowTitleExpression("");
 
+	void setWindow(const std::string &);
 	const char *getType() { return "window"; }
 	void save(obs_data_t *obj);
 	void load(obs_data_t *obj);
@@ -102,12 +102,14 @@ void MacroActionEdit::UpdateEntryData(const std::string &id)
 	const bool enabled = (*_entryData)->Enabled();
 	_enable->setChecked(enabled);
 	SetDisableEffect(!enabled);
-	auto widget = MacroActionFactory::CreateWidget(id, this, *_entryData);
-	QWidget::connect(widget, SIGNAL(HeaderInfoChanged(const QString &)),
-			 this, SLOT(HeaderInfoChanged(const QString &)));
 	HeaderInfoChanged(
 		QString::fromStdString((*_entryData)->GetShortDesc()));
-	_section->SetContent(widget, (*_entryData)->GetCollapsed());
+	SetLazyContent(
+		[this]() {
+			return MacroActionFactory::CreateWidget(
+				(*_entryData)->GetId(), this, *_entryData);
+		},
+		(*_entryData)->GetCollapsed());
 	SetFocusPolicyOfWidgets();
 }
 
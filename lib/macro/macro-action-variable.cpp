@@ -85,16 +85,7 @@ static void apppend(Variable &var, const std::string &value)
 
 static void modifyNumValue(Variable &var, double val, const bool increment)
 {
-	auto current = var.DoubleValue();
-	if (!current.has_value()) {
-		return;
-	}
-
-	if (increment) {
-		var.SetValue(*current + val);
-	} else {
-		var.SetValue(*current - val);
-	}
+	var.IncrementValue(increment ? val : -val);
 }
 
 MacroActionVariable::~MacroActionVariable()
@@ -163,9 +154,31 @@ void MacroActionVariable::HandleFindAndReplace(Variable *var)
 	var->SetValue(result.toStdString());
 }
 
+static std::optional<double> getVariableValue(const std::string &name)
+{
+	auto var = GetVariableByName(name);
+	if (!var) {
+		return {};
+	}
+	return var->DoubleValue();
+}
+
+static std::variant<double, std::string>
+evalMathExpression(const StringVariable &expression)
+{
+	auto result = EvalMathExpression(expression.UnresolvedValue(),
+					 getVariableValue);
+	if (std::holds_alternative<double>(result)) {
+		return result;
+	}
+	// Variables with non-numeric values might still form a valid expression
+	// when substituted as text
+	return EvalMathExpression(expression);
+}
+
 void MacroActionVariable::HandleMathExpression(Variable *var)
 {
-	auto result = EvalMathExpression(_mathExpression);
+	auto result = evalMathExpression(_mathExpression);
 	if (std::holds_alternative<std::string>(result)) {
 		blog(LOG_WARNING, "%s", std::get<std::string>(result).c_str());
 		return;
@@ -1242,7 +1255,7 @@ void MacroActionVariableEdit::MathExpressionChanged()
 	_entryData->_mathExpression = _mathExpression->text().toStdString();
 
 	// In case of invalid expression display an error
-	auto result = EvalMathExpression(_entryData->_mathExpression);
+	auto result = evalMathExpression(_entryData->_mathExpression);
 	auto hasError = std::holds_alternative<std::string>(result);
 	if (hasError) {
 		_mathExpressionResult->setText(
@@ -1,4 +1,5 @@
 #include "macro-condition.hpp"
+#include "macro.hpp"
 
 namespace advss {
 
@@ -45,6 +46,15 @@ void MacroCondition::ValidateLogicSelection(bool isRootCondition,
 	     context);
 }
 
+void MacroCondition::QueueMessageRun()
+{
+	auto macro = GetMacro();
+	if (!macro) {
+		return;
+	}
+	macro->AddMessageRun(this);
+}
+
 void MacroCondition::ResetDuration()
 {
 	_durationModifier.ResetDuration();
@@ -3,6 +3,7 @@
 #include "condition-logic.hpp"
 #include "duration-modifier.hpp"
 #include "macro-ref.hpp"
+#include "message-buffer.hpp"
 
 namespace advss {
 
@@ -26,8 +27,20 @@ public:
 	void ResetDuration();
 	bool CheckDurationModifier(bool conditionValue);
 
+	// Conditions reacting to received messages should return the buffer
+	// they are using, so its statistics can be queried
+	virtual std::shared_ptr<MessageBufferBase> GetMessageBuffer() const
+	{
+		return {};
+	}
+
 	static std::string_view GetDefaultID();
 
+protected:
+	// Requests a dedicated run of the macro's actions using the current temp
+	// var values of this condition
+	void QueueMessageRun();
+
 private:
 	Logic _logic = Logic(Logic::Type::ROOT_NONE);
 	DurationModifier _durationModifier;
@@ -9,6 +9,7 @@
 #include <QMouseEvent>
 #include <QScrollBar>
 #include <QSpacerItem>
+#include <QTimer>
 #include <QtGlobal>
 
 namespace advss {
@@ -35,6 +36,9 @@ MacroSegmentList::MacroSegmentList(QWidget *parent)
 	setWidget(wrapper);
 	setWidgetResizable(true);
 	setAcceptDrops(true);
+
+	connect(verticalScrollBar(), &QScrollBar::valueChanged, this,
+		[this]() { ScheduleContentCreation(); });
 }
 
 MacroSegmentList::~MacroSegmentList()
@@ -102,12 +106,14 @@ void MacroSegmentList::Insert(int idx, MacroSegmentEdit *widget)
 {
 	widget->installEventFilter(this);
 	_contentLayout->insertWidget(idx, widget);
+	ScheduleContentCreation();
 }
 
 void MacroSegmentList::Add(QWidget *widget)
 {
 	widget->installEventFilter(this);
 	_contentLayout->addWidget(widget);
+	ScheduleContentCreation();
 }
 
 void MacroSegmentList::Remove(int idx) const
@@ -156,6 +162,62 @@ void MacroSegmentList::SetSelection(int idx) const
 	}
 }
 
+void MacroSegmentList::resizeEvent(QResizeEvent *event)
+{
+	QScrollArea::resizeEvent(event);
+	ScheduleContentCreation();
+}
+
+void MacroSegmentList::showEvent(QShowEvent *event)
+{
+	QScrollArea::showEvent(event);
+	ScheduleContentCreation();
+}
+
+void MacroSegmentList::ScheduleContentCreation()
+{
+	// Coalesce multiple requests, e.g. when adding many segments at once,
+	// and wait for the layout to be updated
+	if (_contentCreationScheduled) {
+		return;
+	}
+	_contentCreationScheduled = true;
+	QTimer::singleShot(0, this, [this]() {
+		_contentCreationScheduled = false;
+		CreateVisibleContent();
+	});
+}
+
+void MacroSegmentList::CreateVisibleContent()
+{
+	if (!isVisible()) {
+		return;
+	}
+
+	bool contentCreated = false;
+	for (int i = 0; i < _contentLayout->count(); i++) {
+		auto item = _contentLayout->itemAt(i);
+		auto segment = dynamic_cast<MacroSegmentEdit *>(item->widget());
+		if (!segment || !segment->HasPendingContent() ||
+		    segment->visibleRegion().isEmpty()) {
+			continue;
+		}
+		// Collapsed segments only create their content once expanded
+		const auto data = segment->Data();
+		if (data && data->GetCollapsed()) {
+			continue;
+		}
+		segment->CreateContent();
+		contentCreated = true;
+	}
+
+	// Newly created content might have pushed other segments out of view
+	// or made room for further segments
+	if (contentCreated) {
+		ScheduleContentCreation();
+	}
+}
+
 bool MacroSegmentList::eventFilter(QObject *object, QEvent *event)
 {
 	switch (event->type()) {
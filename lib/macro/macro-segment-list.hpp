@@ -35,6 +35,8 @@ signals:
 
 protected:
 	bool eventFilter(QObject *object, QEvent *event);
+	void resizeEvent(QResizeEvent *event);
+	void showEvent(QShowEvent *event);
 	void mousePressEvent(QMouseEvent *event);
 	void mouseMoveEvent(QMouseEvent *event);
 	void mouseReleaseEvent(QMouseEvent *event);
@@ -52,12 +54,15 @@ private:
 	bool IsInListArea(const QPoint &) const;
 	QRect GetContentItemRectWithPadding(int idx) const;
 	void HideLastDropLine();
+	void ScheduleContentCreation();
+	void CreateVisibleContent();
 
 	int _dragPosition = -1;
 	int _dropLineIdx = -1;
 	QPoint _dragCursorPos;
 	std::thread _autoScrollThread;
 	std::atomic_bool _autoScroll{false};
+	bool _contentCreationScheduled = false;
 
 	QVBoxLayout *_layout;
 	QVBoxLayout *_contentLayout;
@@ -333,6 +333,35 @@ void MacroSegmentEdit::SetFocusPolicyOfWidgets()
 	}
 }
 
+void MacroSegmentEdit::SetLazyContent(
+	const std::function<QWidget *()> &createWidget, bool collapsed)
+{
+	_section->SetLazyContent(
+		[this, createWidget]() {
+			auto widget = createWidget();
+			QWidget::connect(
+				widget,
+				SIGNAL(HeaderInfoChanged(const QString &)),
+				this, SLOT(HeaderInfoChanged(const QString &)));
+			PreventMouseWheelAdjustWithoutFocus(widget);
+			for (auto w : widget->findChildren<QWidget *>()) {
+				PreventMouseWheelAdjustWithoutFocus(w);
+			}
+			return widget;
+		},
+		collapsed);
+}
+
+void MacroSegmentEdit::CreateContent()
+{
+	_section->CreateLazyContent();
+}
+
+bool MacroSegmentEdit::HasPendingContent() const
+{
+	return _section->HasLazyContent();
+}
+
 void MacroSegmentEdit::SetCollapsed(bool collapsed)
 {
 	_section->SetCollapsed(collapsed);
@@ -12,6 +12,7 @@
 #include <QVBoxLayout>
 #include <QTimer>
 #include <obs-data.h>
+#include <functional>
 
 class QLabel;
 
@@ -103,6 +104,9 @@ public:
 	void SetCollapsed(bool collapsed);
 	void SetSelected(bool);
 	virtual std::shared_ptr<MacroSegment> Data() const = 0;
+	// Creates the segment specific edit widget if it was deferred
+	void CreateContent();
+	bool HasPendingContent() const;
 
 public slots:
 	void HeaderInfoChanged(const QString &);
@@ -119,6 +123,10 @@ signals:
 
 protected:
 	bool eventFilter(QObject *obj, QEvent *ev) override;
+	// Only create the segment specific edit widget once the segment is
+	// expanded or scrolled into view, as creating it can be expensive
+	void SetLazyContent(const std::function<QWidget *()> &createWidget,
+			    bool collapsed);
 
 	Section *_section;
 	QLabel *_headerInfo;
@@ -25,7 +25,6 @@
 namespace advss {
 
 static QObject *addPulse = nullptr;
-static QTimer onChangeHighlightTimer;
 
 static bool macroNameExists(const std::string &name)
 {
@@ -927,6 +926,10 @@ void AdvSceneSwitcher::SetupMacroTab()
 		SLOT(MacroSelectionAboutToChange()));
 	connect(ui->macros, SIGNAL(MacroSelectionChanged()), this,
 		SLOT(MacroSelectionChanged()));
+	connect(this, &AdvSceneSwitcher::HighlightMacrosChanged, ui->macros,
+		&MacroTree::EnableHighlight);
+	connect(ui->macros, &MacroTree::StatusRefreshed, this,
+		&AdvSceneSwitcher::HighlightOnChange);
 	ui->runMacro->SetMacroTree(ui->macros);
 
 	ui->conditionsList->SetHelpMsg(
@@ -967,11 +970,6 @@ void AdvSceneSwitcher::SetupMacroTab()
 	ui->macroPriorityWarning->setVisible(
 		switcher->functionNamesByPriority[0] != macro_func);
 
-	onChangeHighlightTimer.setInterval(1500);
-	connect(&onChangeHighlightTimer, SIGNAL(timeout()), this,
-		SLOT(HighlightOnChange()));
-	onChangeHighlightTimer.start();
-
 	// Set action and condition toolbars
 	const std::string pathPrefix =
 		GetDataFilePath("res/images/" + GetThemeTypeName());
@@ -1043,10 +1041,8 @@ void AdvSceneSwitcher::SetupMacroTab()
 	SetupSegmentCopyPasteShortcutHandlers(this);
 
 	// Macro segment highlight
-	auto timer = new QTimer(this);
-	connect(timer, &QTimer::timeout,
+	connect(ui->macros, &MacroTree::StatusRefreshed, this,
 		[this]() { runSegmentHighligtChecks(this); });
-	timer->start(1500);
 }
 
 void AdvSceneSwitcher::ShowMacroContextMenu(const QPoint &pos)
@@ -14,16 +14,16 @@
 #include <QVBoxLayout>
 #include <QHBoxLayout>
 #include <QMouseEvent>
+#include <QScrollBar>
 #include <QStylePainter>
 
 Q_DECLARE_METATYPE(std::shared_ptr<advss::Macro>);
 
 namespace advss {
 
-MacroTreeItem::MacroTreeItem(MacroTree *tree, std::shared_ptr<Macro> macroItem,
-			     bool highlight)
+MacroTreeItem::MacroTreeItem(MacroTree *tree, std::shared_ptr<Macro> macroItem)
 	: _tree(tree),
-	  _highlight(highlight),
+	  _statusVersion(macroItem->GetStatusVersion()),
 	  _macro(macroItem)
 {
 	setAttribute(Qt::WA_TranslucentBackground);
@@ -79,38 +79,26 @@ MacroTreeItem::MacroTreeItem(MacroTree *tree, std::shared_ptr<Macro> macroItem,
 		_macro->SetPaused(!val);
 	};
 	connect(_running, &QAbstractButton::clicked, setRunning);
-	connect(_tree->window(), SIGNAL(HighlightMacrosChanged(bool)), this,
-		SLOT(EnableHighlight(bool)));
 	connect(_tree->window(),
 		SIGNAL(MacroRenamed(const QString &, const QString &)), this,
 		SLOT(MacroRenamed(const QString &, const QString &)));
-	connect(&_timer, SIGNAL(timeout()), this, SLOT(HighlightIfExecuted()));
-	connect(&_timer, SIGNAL(timeout()), this, SLOT(UpdatePaused()));
-	_timer.start(1500);
 }
 
-void MacroTreeItem::EnableHighlight(bool enable)
+bool MacroTreeItem::RefreshStatus(bool highlight, const TimePoint &lastRefresh)
 {
-	_highlight = enable;
-}
+	const auto version = _macro->GetStatusVersion();
+	if (version == _statusVersion) {
+		return false;
+	}
+	_statusVersion = version;
 
-void MacroTreeItem::UpdatePaused()
-{
 	const QSignalBlocker blocker(_running);
 	_running->setChecked(!_macro->Paused());
-}
 
-void MacroTreeItem::HighlightIfExecuted()
-{
-	if (!_highlight || !_macro) {
-		return;
-	}
-
-	if (_lastHighlightCheckTime.time_since_epoch().count() != 0 &&
-	    _macro->WasExecutedSince(_lastHighlightCheckTime)) {
+	if (highlight && _macro->WasExecutedSince(lastRefresh)) {
 		HighlightWidget(this, Qt::green, QColor(0, 0, 0, 0), true);
 	}
-	_lastHighlightCheckTime = std::chrono::high_resolution_clock::now();
+	return true;
 }
 
 void MacroTreeItem::MacroRenamed(const QString &oldName, const QString &newName)
@@ -813,6 +801,79 @@ MacroTree::MacroTree(QWidget *parent_) : QListView(parent_)
 		"*[bgColor=\"8\"]{background-color:rgba(255,255,255,33%);}"));
 
 	setItemDelegate(new MacroTreeDelegate(this));
+
+	_lastStatusRefreshTime = std::chrono::high_resolution_clock::now();
+	connect(&_statusRefreshTimer, &QTimer::timeout, this,
+		&MacroTree::RefreshStatus);
+	_statusRefreshTimer.start(1500);
+
+	// Items scrolled into view might have missed status updates
+	connect(verticalScrollBar(), &QScrollBar::valueChanged, this,
+		&MacroTree::SyncVisibleItems);
+}
+
+void MacroTree::EnableHighlight(bool enable)
+{
+	_highlight = enable;
+}
+
+void MacroTree::RefreshStatus()
+{
+	const auto now = std::chrono::high_resolution_clock::now();
+
+	// Only check the visible items if any macro changed its status since
+	// the last refresh
+	const auto version = GetMacroStatusVersion();
+	if (isVisible() && version != _lastStatusVersion) {
+		_lastStatusVersion = version;
+		RefreshVisibleItems(_highlight);
+	}
+	_lastStatusRefreshTime = now;
+	emit StatusRefreshed();
+}
+
+void MacroTree::SyncVisibleItems()
+{
+	RefreshVisibleItems(false);
+}
+
+void MacroTree::RefreshVisibleItems(bool highlight)
+{
+	MacroTreeModel *mtm = GetModel();
+	if (!mtm) {
+		return;
+	}
+
+	const auto rect = viewport()->rect();
+	const int first = indexAt(rect.topLeft()).row();
+	if (first == -1) {
+		return;
+	}
+	int last = indexAt(rect.bottomLeft()).row();
+	if (last == -1) {
+		last = mtm->rowCount(QModelIndex()) - 1;
+	}
+
+	const auto notifyChanged = [mtm](int from, int to) {
+		emit mtm->dataChanged(mtm->index(from), mtm->index(to));
+	};
+
+	int changedFrom = -1;
+	for (int row = first; row <= last; row++) {
+		auto item = GetItemWidget(row);
+		const bool changed =
+			item &&
+			item->RefreshStatus(highlight, _lastStatusRefreshTime);
+		if (changed && changedFrom == -1) {
+			changedFrom = row;
+		} else if (!changed && changedFrom != -1) {
+			notifyChanged(changedFrom, row - 1);
+			changedFrom = -1;
+		}
+	}
+	if (changedFrom != -1) {
+		notifyChanged(changedFrom, last);
+	}
 }
 
 void MacroTree::ResetWidgets()
@@ -823,8 +884,7 @@ void MacroTree::ResetWidgets()
 	for (int i = 0; i < (int)mtm->_macros.size(); i++) {
 		QModelIndex index = mtm->createIndex(modelIdx, 0, nullptr);
 		const auto &macro = mtm->_macros[i];
-		setIndexWidget(index,
-			       new MacroTreeItem(this, macro, _highlight));
+		setIndexWidget(index, new MacroTreeItem(this, macro));
 
 		// Skip items of collapsed groups
 		if (macro->IsGroup() && macro->IsCollapsed()) {
@@ -838,7 +898,7 @@ void MacroTree::ResetWidgets()
 void MacroTree::UpdateWidget(const QModelIndex &idx,
 			     std::shared_ptr<Macro> item)
 {
-	setIndexWidget(idx, new MacroTreeItem(this, item, _highlight));
+	setIndexWidget(idx, new MacroTreeItem(this, item));
 }
 
 void MacroTree::UpdateWidgets(bool force)
@@ -29,22 +29,20 @@ class MacroTree;
 
 class MacroTreeItem : public QFrame {
 	Q_OBJECT
+	using TimePoint = std::chrono::high_resolution_clock::time_point;
 
 public:
-	explicit MacroTreeItem(MacroTree *tree, std::shared_ptr<Macro> macro,
-			       bool highlight);
+	explicit MacroTreeItem(MacroTree *tree, std::shared_ptr<Macro> macro);
 
 private slots:
 	void ExpandClicked(bool checked);
-	void EnableHighlight(bool enable);
-	void UpdatePaused();
-	void HighlightIfExecuted();
 	void MacroRenamed(const QString &, const QString &);
 
 private:
 	virtual void paintEvent(QPaintEvent *event) override;
 	void mouseDoubleClickEvent(QMouseEvent *event) override;
 	void Update(bool force);
+	bool RefreshStatus(bool highlight, const TimePoint &lastRefresh);
 
 	enum class Type {
 		Unknown,
@@ -62,9 +60,7 @@ private:
 	QHBoxLayout *_boxLayout = nullptr;
 	QLabel *_label = nullptr;
 	MacroTree *_tree;
-	bool _highlight;
-	std::chrono::high_resolution_clock::time_point _lastHighlightCheckTime{};
-	QTimer _timer;
+	uint64_t _statusVersion = 0;
 	std::shared_ptr<Macro> _macro;
 
 	friend class MacroTree;
@@ -141,10 +137,17 @@ public slots:
 	void UngroupSelectedGroups();
 	void SelectionChangedHelper(const QItemSelection &,
 				    const QItemSelection &);
+	void EnableHighlight(bool enable);
 
 signals:
 	void MacroSelectionAboutToChange();
 	void MacroSelectionChanged();
+	// Emitted periodically after the macro status was refreshed
+	void StatusRefreshed();
+
+private slots:
+	void RefreshStatus();
+	void SyncVisibleItems();
 
 protected:
 	virtual void dropEvent(QDropEvent *event) override;
@@ -160,9 +163,16 @@ private:
 	void MoveItemAfter(const std::shared_ptr<Macro> &item,
 			   const std::shared_ptr<Macro> &after) const;
 	MacroTreeModel *GetModel() const;
+	void RefreshVisibleItems(bool highlight);
 
 	bool _highlight = false;
 
+	// A single timer refreshes the status of all visible items instead of
+	// each item polling the state of its macro
+	QTimer _statusRefreshTimer;
+	uint64_t _lastStatusVersion = 0;
+	std::chrono::high_resolution_clock::time_point _lastStatusRefreshTime;
+
 	friend class MacroTreeModel;
 	friend class MacroTreeItem;
 };
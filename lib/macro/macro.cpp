@@ -6,7 +6,10 @@
 #include "plugin-state-helpers.hpp"
 #include "splitter-helpers.hpp"
 #include "sync-helpers.hpp"
+#include "tick-watchdog.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <limits>
 #undef max
@@ -75,6 +78,15 @@ static void obs_frontend_remove_dock(const char *id)
 namespace advss {
 
 static std::deque<std::shared_ptr<Macro>> macros;
+static std::atomic<uint64_t> macroStatusVersion = 0;
+
+// Limits the number of action runs waiting to be executed per macro if the
+// actions cannot keep up with the rate of incoming messages
+constexpr size_t maxQueuedMessageRuns = 1000;
+
+// Temp var values captured for the message run executed by the current thread
+static thread_local const std::vector<TempVariable> *activeTempVarSnapshot =
+	nullptr;
 
 Macro::Macro(const std::string &name, const bool addHotkey,
 	     const bool shortCircuitEvaluation)
@@ -246,6 +258,10 @@ bool Macro::CheckConditions(bool ignorePause)
 
 	_stop = false;
 	_matched = false;
+	{
+		std::lock_guard<std::mutex> lock(_messageRunMutex);
+		_pendingMessageRuns.clear();
+	}
 	for (auto &condition : _conditions) {
 		if (!condition) {
 			continue;
@@ -273,7 +289,19 @@ bool Macro::CheckConditions(bool ignorePause)
 
 bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 {
-	if (!_done) {
+	if (match && HasPendingMessageRuns()) {
+		QueueMessageRuns();
+		_lastExecutionTime = std::chrono::high_resolution_clock::now();
+		MarkStatusChanged();
+		auto group = _parent.lock();
+		if (group) {
+			group->_lastExecutionTime = _lastExecutionTime;
+			group->MarkStatusChanged();
+		}
+		return true;
+	}
+
+	if (!TryStartActionRun()) {
 		vblog(LOG_INFO, "Macro %s already running", _name.c_str());
 
 		if (!_stopActionsIfNotDone) {
@@ -283,6 +311,7 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 		Stop();
 		vblog(LOG_INFO, "Stopped macro %s actions to rerun them",
 		      _name.c_str());
+		_done = false;
 	}
 
 	std::function<bool(bool)> runFunc =
@@ -291,7 +320,6 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 		      : std::bind(&Macro::RunElseActions, this,
 				  std::placeholders::_1);
 	_stop = false;
-	_done = false;
 	bool ret = true;
 	if (_runInParallel || forceParallel) {
 		if (_backgroundThread.joinable()) {
@@ -304,9 +332,11 @@ bool Macro::PerformActions(bool match, bool forceParallel, bool ignorePause)
 	}
 
 	_lastExecutionTime = std::chrono::high_resolution_clock::now();
+	MarkStatusChanged();
 	auto group = _parent.lock();
 	if (group) {
 		group->_lastExecutionTime = _lastExecutionTime;
+		group->MarkStatusChanged();
 	}
 	if (_runCount != std::numeric_limits<int>::max()) {
 		_runCount++;
@@ -319,6 +349,11 @@ bool Macro::WasExecutedSince(const TimePoint &time) const
 	return _lastExecutionTime > time;
 }
 
+void Macro::MarkStatusChanged()
+{
+	_statusVersion = ++macroStatusVersion;
+}
+
 bool Macro::ConditionsShouldBeChecked() const
 {
 	if (!_useCustomConditionCheckInterval) {
@@ -336,6 +371,12 @@ bool Macro::ConditionsShouldBeChecked() const
 
 bool Macro::ShouldRunActions() const
 {
+	// Each message is expected to trigger a run of the actions, so the
+	// "on change" setting does not apply
+	if (!_paused && _matched && HasPendingMessageRuns()) {
+		return true;
+	}
+
 	const bool hasActionsToExecute =
 		!_paused && (_matched || _elseActions.size() > 0) &&
 		(!_performActionsOnChange || _conditionSateChanged);
@@ -408,10 +449,39 @@ bool Macro::RunActionsHelper(
 			action->EnableHighlight();
 		}
 	}
-	_done = true;
+	FinishActionRun();
 	return actionsExecutedSuccessfully;
 }
 
+bool Macro::TryStartActionRun()
+{
+	bool done = true;
+	return _done.compare_exchange_strong(done, false);
+}
+
+void Macro::FinishActionRun()
+{
+	{
+		std::lock_guard<std::mutex> lock(_actionRunMutex);
+		_done = true;
+	}
+	_actionRunCV.notify_all();
+}
+
+bool Macro::WaitForActionRun()
+{
+	bool started = false;
+	std::unique_lock<std::mutex> lock(_actionRunMutex);
+	_actionRunCV.wait(lock, [this, &started]() {
+		if (_stop || _die) {
+			return true;
+		}
+		started = TryStartActionRun();
+		return started;
+	});
+	return started;
+}
+
 bool Macro::RunActions(bool ignorePause)
 {
 	mblog(LOG_INFO, "running actions of %s", _name.c_str());
@@ -475,7 +545,17 @@ void Macro::SetPaused(bool pause)
 		_lastUnpauseTime = std::chrono::high_resolution_clock::now();
 		ResetTimers();
 	}
-	_paused = pause;
+	if (!_paused && pause) {
+		// Runs triggered before pausing must not be performed with
+		// outdated temp var values once the macro is unpaused
+		std::lock_guard<std::mutex> lock(_messageRunMutex);
+		_pendingMessageRuns.clear();
+		_queuedMessageRuns.clear();
+	}
+	if (_paused != pause) {
+		_paused = pause;
+		MarkStatusChanged();
+	}
 }
 
 void Macro::AddHelperThread(std::thread &&newThread)
@@ -503,6 +583,7 @@ void Macro::Stop()
 {
 	_stop = true;
 	GetMacroWaitCV().notify_all();
+	StopMessageRuns();
 	for (auto &t : _helperThreads) {
 		if (t.joinable()) {
 			t.join();
@@ -626,9 +707,110 @@ std::optional<const TempVariable> Macro::GetTempVar(const MacroSegment *segment,
 	if (!segment) {
 		return {};
 	}
+	if (activeTempVarSnapshot) {
+		for (const auto &var : *activeTempVarSnapshot) {
+			if (var.ID() == id &&
+			    var.Segment().lock().get() == segment) {
+				return var;
+			}
+		}
+	}
 	return segment->GetTempVar(id);
 }
 
+void Macro::AddMessageRun(const MacroSegment *segment)
+{
+	if (!segment) {
+		return;
+	}
+	std::lock_guard<std::mutex> lock(_messageRunMutex);
+	_pendingMessageRuns.emplace_back(segment->_tempVariables);
+}
+
+bool Macro::HasPendingMessageRuns() const
+{
+	std::lock_guard<std::mutex> lock(_messageRunMutex);
+	return !_pendingMessageRuns.empty();
+}
+
+void Macro::QueueMessageRuns()
+{
+	std::lock_guard<std::mutex> lock(_messageRunMutex);
+	for (auto &snapshot : _pendingMessageRuns) {
+		_queuedMessageRuns.emplace_back(std::move(snapshot));
+		if (_runCount != std::numeric_limits<int>::max()) {
+			_runCount++;
+		}
+	}
+	_pendingMessageRuns.clear();
+
+	if (_queuedMessageRuns.size() > maxQueuedMessageRuns) {
+		blog(LOG_WARNING,
+		     "dropping %zu action runs of macro %s as the actions "
+		     "cannot keep up with the received messages",
+		     _queuedMessageRuns.size() - maxQueuedMessageRuns,
+		     _name.c_str());
+		_queuedMessageRuns.erase(_queuedMessageRuns.begin(),
+					 _queuedMessageRuns.end() -
+						 maxQueuedMessageRuns);
+	}
+
+	if (_messageRunThreadActive) {
+		return;
+	}
+	if (_messageRunThread.joinable()) {
+		_messageRunThread.join();
+	}
+	_messageRunThreadActive = true;
+	_messageRunThread = std::thread([this]() { RunQueuedMessageRuns(); });
+}
+
+void Macro::RunQueuedMessageRuns()
+{
+	while (true) {
+		TempVarSnapshot snapshot;
+		{
+			std::lock_guard<std::mutex> lock(_messageRunMutex);
+			if (_queuedMessageRuns.empty() || _stop || _die) {
+				_queuedMessageRuns.clear();
+				_messageRunThreadActive = false;
+				return;
+			}
+			snapshot = std::move(_queuedMessageRuns.front());
+			_queuedMessageRuns.pop_front();
+		}
+
+		// Never run the actions while they are already being executed
+		// by a regular or another message triggered run
+		if (!WaitForActionRun()) {
+			continue;
+		}
+
+		mblog(LOG_INFO, "running actions of %s for message",
+		      _name.c_str());
+		activeTempVarSnapshot = &snapshot;
+		RunActionsHelper(_actions, false);
+		activeTempVarSnapshot = nullptr;
+	}
+}
+
+void Macro::StopMessageRuns()
+{
+	std::thread thread;
+	{
+		std::lock_guard<std::mutex> lock(_messageRunMutex);
+		_queuedMessageRuns.clear();
+		thread = std::move(_messageRunThread);
+	}
+	{
+		std::lock_guard<std::mutex> lock(_actionRunMutex);
+	}
+	_actionRunCV.notify_all();
+	if (thread.joinable()) {
+		thread.join();
+	}
+}
+
 void Macro::InvalidateTempVarValues() const
 {
 	auto invalidateHelper =
@@ -767,6 +949,16 @@ bool Macro::Save(obs_data_t *obj, bool saveForCopy) const
 }
 
 bool Macro::Load(obs_data_t *obj)
+{
+	if (!LoadConfig(obj)) {
+		return false;
+	}
+	LoadSegments(obj);
+	LoadFrontendSettings(obj);
+	return true;
+}
+
+bool Macro::LoadConfig(obs_data_t *obj)
 {
 	_name = obs_data_get_string(obj, "name");
 
@@ -804,7 +996,6 @@ bool Macro::Load(obs_data_t *obj)
 		obs_data_get_bool(obj, "useShortCircuitEvaluation");
 	_useCustomConditionCheckInterval =
 		obs_data_get_bool(obj, "useCustomConditionCheckInterval");
-	_customConditionCheckInterval.Load(obj, "customConditionCheckInterval");
 
 	LoadDockSettings(obj);
 
@@ -815,19 +1006,17 @@ bool Macro::Load(obs_data_t *obj)
 
 	obs_data_set_default_bool(obj, "registerHotkeys", true);
 	_registerHotkeys = obs_data_get_bool(obj, "registerHotkeys");
-	if (_registerHotkeys) {
-		SetupHotkeys();
+	return true;
+}
+
+void Macro::LoadSegments(obs_data_t *obj)
+{
+	if (_isGroup) {
+		return;
 	}
-	OBSDataArrayAutoRelease pauseHotkey =
-		obs_data_get_array(obj, "pauseHotkey");
-	obs_hotkey_load(_pauseHotkey, pauseHotkey);
-	OBSDataArrayAutoRelease unpauseHotkey =
-		obs_data_get_array(obj, "unpauseHotkey");
-	obs_hotkey_load(_unpauseHotkey, unpauseHotkey);
-	OBSDataArrayAutoRelease togglePauseHotkey =
-		obs_data_get_array(obj, "togglePauseHotkey");
-	obs_hotkey_load(_togglePauseHotkey, togglePauseHotkey);
-	SetHotkeysDesc();
+
+	// Refers to variables by name
+	_customConditionCheckInterval.Load(obj, "customConditionCheckInterval");
 
 	bool root = true;
 	OBSDataArrayAutoRelease conditions =
@@ -889,8 +1078,29 @@ bool Macro::Load(obs_data_t *obj)
 	UpdateElseActionIndices();
 
 	_inputVariables.Load(obj);
+}
 
-	return true;
+void Macro::LoadFrontendSettings(obs_data_t *obj)
+{
+	if (_isGroup) {
+		return;
+	}
+
+	if (_registerHotkeys) {
+		SetupHotkeys();
+	}
+	OBSDataArrayAutoRelease pauseHotkey =
+		obs_data_get_array(obj, "pauseHotkey");
+	obs_hotkey_load(_pauseHotkey, pauseHotkey);
+	OBSDataArrayAutoRelease unpauseHotkey =
+		obs_data_get_array(obj, "unpauseHotkey");
+	obs_hotkey_load(_unpauseHotkey, unpauseHotkey);
+	OBSDataArrayAutoRelease togglePauseHotkey =
+		obs_data_get_array(obj, "togglePauseHotkey");
+	obs_hotkey_load(_togglePauseHotkey, togglePauseHotkey);
+	SetHotkeysDesc();
+
+	EnableDock(_registerDock);
 }
 
 bool Macro::PostLoad()
@@ -1023,7 +1233,7 @@ void Macro::LoadDockSettings(obs_data_t *obj)
 		_dockHasRunButton = obs_data_get_bool(obj, "dockHasRunButton");
 		_dockHasPauseButton =
 			obs_data_get_bool(obj, "dockHasPauseButton");
-		EnableDock(obs_data_get_bool(obj, "registerDock"));
+		_registerDock = obs_data_get_bool(obj, "registerDock");
 		return;
 	}
 
@@ -1062,7 +1272,8 @@ void Macro::LoadDockSettings(obs_data_t *obj)
 		_dockHighlight = obs_data_get_bool(dockSettings,
 						   "highlightIfConditionsTrue");
 	}
-	EnableDock(dockEnabled);
+	// The dock itself is only created in LoadFrontendSettings()
+	_registerDock = dockEnabled;
 	obs_data_release(dockSettings);
 }
 
@@ -1306,20 +1517,84 @@ void SaveMacros(obs_data_t *obj)
 	obs_data_array_release(macroArray);
 }
 
+static void loadMacroConfigs(const std::vector<OBSData> &data)
+{
+	const size_t count = data.size();
+	const size_t threadCount = std::min<size_t>(
+		std::max(std::thread::hardware_concurrency(), 1u), count);
+	std::atomic_size_t nextIdx = 0;
+
+	const auto loadWorker = [&]() {
+		for (size_t i = nextIdx++; i < count; i = nextIdx++) {
+			macros[i]->LoadConfig(data[i]);
+		}
+	};
+
+	if (threadCount <= 1) {
+		loadWorker();
+		return;
+	}
+
+	std::vector<std::thread> workers;
+	workers.reserve(threadCount - 1);
+	for (size_t i = 1; i < threadCount; i++) {
+		workers.emplace_back(loadWorker);
+	}
+	loadWorker();
+	for (auto &worker : workers) {
+		worker.join();
+	}
+}
+
+static long long msSince(std::chrono::high_resolution_clock::time_point start)
+{
+	return std::chrono::duration_cast<std::chrono::milliseconds>(
+		       std::chrono::high_resolution_clock::now() - start)
+		.count();
+}
+
 void LoadMacros(obs_data_t *obj)
 {
 	macros.clear();
-	obs_data_array_t *macroArray = obs_data_get_array(obj, "macros");
+	OBSDataArrayAutoRelease macroArray = obs_data_get_array(obj, "macros");
 	size_t count = obs_data_array_count(macroArray);
 
+	std::vector<OBSData> macroData;
+	macroData.reserve(count);
 	for (size_t i = 0; i < count; i++) {
-		obs_data_t *array_obj = obs_data_array_item(macroArray, i);
+		OBSDataAutoRelease arrayObj = obs_data_array_item(macroArray, i);
+		macroData.emplace_back(arrayObj.Get());
 		macros.emplace_back(std::make_shared<Macro>());
-		macros.back()->Load(array_obj);
-		obs_data_release(array_obj);
 	}
-	obs_data_array_release(macroArray);
 
+	// Only the plain macro settings are read by worker threads.
+	// Segments are loaded on the main thread in the order of the macros, as
+	// they look up sources and variables by name and register hotkeys.
+	auto startTime = std::chrono::high_resolution_clock::now();
+	loadMacroConfigs(macroData);
+	blog(LOG_INFO, "loaded config of %zu macros in %lld ms", count,
+	     msSince(startTime));
+
+	startTime = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < count; i++) {
+		macros[i]->LoadSegments(macroData[i]);
+		const size_t done = i + 1;
+		if (done % 100 == 0 || done == count) {
+			vblog(LOG_INFO, "loaded segments of %zu of %zu macros",
+			      done, count);
+		}
+	}
+	blog(LOG_INFO, "loaded segments of %zu macros in %lld ms", count,
+	     msSince(startTime));
+
+	startTime = std::chrono::high_resolution_clock::now();
+	for (size_t i = 0; i < count; i++) {
+		macros[i]->LoadFrontendSettings(macroData[i]);
+	}
+	blog(LOG_INFO, "set up hotkeys and docks of %zu macros in %lld ms",
+	     count, msSince(startTime));
+
+	startTime = std::chrono::high_resolution_clock::now();
 	int groupCount = 0;
 	std::shared_ptr<Macro> group;
 	std::vector<std::shared_ptr<Macro>> invalidGroups;
@@ -1341,6 +1616,8 @@ void LoadMacros(obs_data_t *obj)
 		}
 		m->PostLoad();
 	}
+	blog(LOG_INFO, "post load of %zu macros done in %lld ms", count,
+	     msSince(startTime));
 
 	if (groupCount) {
 		blog(LOG_ERROR,
@@ -1363,6 +1640,16 @@ std::deque<std::shared_ptr<Macro>> &GetMacros()
 	return macros;
 }
 
+static void recordMacroDuration(const Macro &macro, TickWatchdog::Phase phase,
+				const TickWatchdog::Clock::time_point &start)
+{
+	auto &watchdog = GetTickWatchdog();
+	const auto duration = TickWatchdog::Clock::now() - start;
+	if (watchdog.ShouldRecordMacro(duration)) {
+		watchdog.RecordMacro(macro.Name(), phase, duration);
+	}
+}
+
 bool CheckMacros()
 {
 	bool matchFound = false;
@@ -1375,7 +1662,10 @@ bool CheckMacros()
 			continue;
 		}
 
-		if (m->CheckConditions() || m->ElseActions().size() > 0) {
+		const auto start = TickWatchdog::Clock::now();
+		const bool conditionsMatched = m->CheckConditions();
+		recordMacroDuration(*m, TickWatchdog::Phase::CHECK, start);
+		if (conditionsMatched || m->ElseActions().size() > 0) {
 			matchFound = true;
 			// This has to be performed here for now as actions are
 			// not performed immediately after checking conditions.
@@ -1421,9 +1711,11 @@ bool RunMacros()
 			continue;
 		}
 		vblog(LOG_INFO, "running macro: %s", m->Name().c_str());
+		const auto start = TickWatchdog::Clock::now();
 		if (!m->PerformActions(m->ConditionsMatched())) {
 			blog(LOG_WARNING, "abort macro: %s", m->Name().c_str());
 		}
+		recordMacroDuration(*m, TickWatchdog::Phase::RUN, start);
 	}
 	if (lock) {
 		lock->lock();
@@ -1495,4 +1787,9 @@ std::shared_ptr<Macro> GetMacroWithInvalidConditionInterval()
 	return {};
 }
 
+uint64_t GetMacroStatusVersion()
+{
+	return macroStatusVersion;
+}
+
 } // namespace advss
@@ -7,6 +7,9 @@
 #include "variable-string.hpp"
 #include "temp-variable.hpp"
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <QString>
 #include <QByteArray>
 #include <string>
@@ -45,6 +48,8 @@ public:
 
 	void SetPaused(bool pause = true);
 	bool Paused() const { return _paused; }
+	// Updated whenever the execution or pause state changes
+	uint64_t GetStatusVersion() const { return _statusVersion; }
 	bool WasPausedSince(const TimePoint &) const;
 
 	void SetPauseStateSaveBehavior(PauseStateSaveBehavior);
@@ -88,6 +93,12 @@ public:
 	GetTempVar(const MacroSegment *, const std::string &id) const;
 	void InvalidateTempVarValues() const;
 
+	// Requests a dedicated run of the actions using the current temp var
+	// values of the given segment, e.g. for each received message, instead
+	// of a single run per interval.
+	// The runs are performed if the conditions of the macro match.
+	void AddMessageRun(const MacroSegment *);
+
 	// Macro segments
 	std::deque<std::shared_ptr<MacroCondition>> &Conditions();
 	std::deque<std::shared_ptr<MacroAction>> &Actions();
@@ -117,6 +128,15 @@ public:
 	// Saving and loading
 	bool Save(obs_data_t *obj, bool saveForCopy = false) const;
 	bool Load(obs_data_t *obj);
+	// Loads the plain macro settings without creating any segments or
+	// accessing OBS, so it can be called from a worker thread.
+	bool LoadConfig(obs_data_t *obj);
+	// Creates the segments of the macro.
+	// Must be called from the main thread after LoadConfig().
+	void LoadSegments(obs_data_t *obj);
+	// Registers hotkeys and docks based on the settings read by
+	// LoadConfig(). Must be called from the main thread.
+	void LoadFrontendSettings(obs_data_t *obj);
 	// Some macros can refer to other macros, which are not yet loaded.
 	// Use this function to set these references after loading is complete.
 	bool PostLoad();
@@ -173,6 +193,16 @@ private:
 		bool ignorePause);
 	bool RunActions(bool ignorePause);
 	bool RunElseActions(bool ignorePause);
+	void MarkStatusChanged();
+
+	using TempVarSnapshot = std::vector<TempVariable>;
+	bool HasPendingMessageRuns() const;
+	void QueueMessageRuns();
+	void RunQueuedMessageRuns();
+	void StopMessageRuns();
+	bool TryStartActionRun();
+	void FinishActionRun();
+	bool WaitForActionRun();
 
 	void SaveDockSettings(obs_data_t *obj, bool saveForCopy) const;
 	void LoadDockSettings(obs_data_t *obj);
@@ -182,13 +212,26 @@ private:
 	std::string _name = "";
 	bool _die = false;
 	bool _stop = false;
-	bool _done = true;
+	// Set while no action run is active.
+	// Regular and message triggered runs must acquire it before executing
+	// the actions, so the actions of a macro never run concurrently.
+	std::atomic_bool _done{true};
+	std::mutex _actionRunMutex;
+	std::condition_variable _actionRunCV;
 	TimePoint _lastCheckTime{};
 	TimePoint _lastUnpauseTime{};
 	TimePoint _lastExecutionTime{};
 	std::thread _backgroundThread;
 	std::vector<std::thread> _helperThreads;
 
+	// Action runs requested by the conditions in the current interval and
+	// runs waiting to be executed by the message run thread
+	mutable std::mutex _messageRunMutex;
+	std::vector<TempVarSnapshot> _pendingMessageRuns;
+	std::deque<TempVarSnapshot> _queuedMessageRuns;
+	std::thread _messageRunThread;
+	bool _messageRunThreadActive = false;
+
 	std::deque<std::shared_ptr<MacroCondition>> _conditions;
 	std::deque<std::shared_ptr<MacroAction>> _actions;
 	std::deque<std::shared_ptr<MacroAction>> _elseActions;
@@ -210,6 +253,7 @@ private:
 	bool _skipExecOnStart = false;
 	bool _stopActionsIfNotDone = false;
 	bool _paused = false;
+	std::atomic<uint64_t> _statusVersion{0};
 	int _runCount = 0;
 	bool _registerHotkeys = true;
 	obs_hotkey_id _pauseHotkey = OBS_INVALID_HOTKEY_ID;
@@ -257,5 +301,9 @@ Macro *GetMacroByQString(const QString &name);
 std::weak_ptr<Macro> GetWeakMacroByName(const char *name);
 void InvalidateMacroTempVarValues();
 std::shared_ptr<Macro> GetMacroWithInvalidConditionInterval();
+// Returns the status version of the macro which changed most recently.
+// Macros with a status version greater than a previously retrieved value
+// changed their state since then.
+uint64_t GetMacroStatusVersion();
 
 } // namespace advss
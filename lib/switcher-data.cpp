@@ -56,13 +56,19 @@ void SwitcherData::Prune()
 		}
 	}
 
+	bool screenRegionsChanged = false;
 	for (size_t i = 0; i < screenRegionSwitches.size(); i++) {
 		ScreenRegionSwitch &s = screenRegionSwitches[i];
 		if (!s.valid()) {
 			screenRegionSwitches.erase(
 				screenRegionSwitches.begin() + i--);
+			screenRegionsChanged = true;
 		}
 	}
+	// Prune() runs on every interval, so only rebuild the index when needed
+	if (screenRegionsChanged) {
+		screenRegionIndex.Invalidate();
+	}
 
 	for (size_t i = 0; i < pauseEntries.size(); i++) {
 		PauseEntry &s = pauseEntries[i];
@@ -181,10 +187,14 @@ void SwitcherData::AddIntervalResetStep(std::function<void()> function,
 
 void SwitcherData::RunPostLoadSteps()
 {
-	for (const auto &func : postLoadSteps) {
+	std::vector<std::function<void()>> steps;
+	{
+		std::lock_guard<std::mutex> lock(postLoadStepsMutex);
+		steps.swap(postLoadSteps);
+	}
+	for (const auto &func : steps) {
 		func();
 	}
-	postLoadSteps.clear();
 }
 
 void SwitcherData::AddSaveStep(std::function<void(obs_data_t *)> function)
@@ -201,6 +211,8 @@ void SwitcherData::AddLoadStep(std::function<void(obs_data_t *)> function)
 
 void SwitcherData::AddPostLoadStep(std::function<void()> function)
 {
+	// Can be called from any thread
+	std::lock_guard<std::mutex> lock(postLoadStepsMutex);
 	postLoadSteps.emplace_back(function);
 }
 
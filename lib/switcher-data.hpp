@@ -19,6 +19,7 @@
 #include "priority-helper.hpp"
 #include "plugin-state-helpers.hpp"
 
+#include <atomic>
 #include <condition_variable>
 #include <vector>
 #include <deque>
@@ -96,9 +97,13 @@ public:
 	std::unique_lock<std::mutex> *mainLoopLock = nullptr;
 	bool stop = false;
 	std::condition_variable cv;
+	// Set if conditions should be checked without waiting for the full
+	// interval, e.g. because new input was received
+	std::atomic_bool checkRequested = {false};
 
 	std::vector<std::function<void(obs_data_t *)>> saveSteps;
 	std::vector<std::function<void(obs_data_t *)>> loadSteps;
+	std::mutex postLoadStepsMutex;
 	std::vector<std::function<void()>> postLoadSteps;
 	std::vector<std::function<void()>> resetIntervalSteps;
 
@@ -117,6 +122,9 @@ public:
 	/* --- Start of General tab section --- */
 
 	int interval = default_interval;
+	// Intervals taking longer than this are reported in the log
+	// A value of 0 uses the check interval as the budget
+	int tickBudget = 0;
 	OBSWeakSource nonMatchingScene;
 	NoMatchBehavior switchIfNotMatching = NoMatchBehavior::NO_SWITCH;
 	Duration noMatchDelay;
@@ -210,6 +218,7 @@ public:
 	void loadVideoSwitches(obs_data_t *obj);
 
 	void Prune();
+	void updateIgnoreWindowsExpressions();
 
 	bool checkSceneSequence(OBSWeakSource &scene, OBSWeakSource &transition,
 				int &linger, bool &setPrevSceneAfterLinger);
@@ -238,10 +247,12 @@ public:
 
 	std::deque<WindowSwitch> windowSwitches;
 	std::vector<std::string> ignoreWindowsSwitches;
+	std::vector<QRegularExpression> ignoreWindowsExpressions;
 	IdleData idleData;
 	std::vector<std::string> ignoreIdleWindows;
 	bool showFrame = false;
 	std::deque<ScreenRegionSwitch> screenRegionSwitches;
+	ScreenRegionIndex screenRegionIndex;
 	bool uninterruptibleSceneSequenceActive = false;
 	std::deque<SceneSequenceSwitch> sceneSequenceSwitches;
 	std::deque<RandomSwitch> randomSwitches;
@@ -0,0 +1,190 @@
+#include "audio-level-tap.hpp"
+#include "log-helper.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace advss {
+
+// Volmeters are updated for every audio tick of 1024 samples, so this keeps
+// the levels of roughly the last 87 seconds at a sample rate of 48kHz
+constexpr size_t frameCapacity = 4096;
+static_assert(frameCapacity * 1024 / 48000 >=
+		      size_t(AudioLevelTap::maxHistory.count()),
+	      "capacity must cover the history duration");
+static_assert((frameCapacity & (frameCapacity - 1)) == 0,
+	      "capacity must be a power of two");
+
+static std::mutex tapsMutex;
+static std::unordered_map<obs_weak_source_t *, std::weak_ptr<AudioLevelTap>>
+	taps;
+
+static uint64_t packLevels(float peak, float magnitude)
+{
+	uint32_t peakBits, magnitudeBits;
+	std::memcpy(&peakBits, &peak, sizeof(peakBits));
+	std::memcpy(&magnitudeBits, &magnitude, sizeof(magnitudeBits));
+	return (uint64_t(peakBits) << 32) | magnitudeBits;
+}
+
+static void unpackLevels(uint64_t levels, float &peak, float &magnitude)
+{
+	const uint32_t peakBits = uint32_t(levels >> 32);
+	const uint32_t magnitudeBits = uint32_t(levels);
+	std::memcpy(&peak, &peakBits, sizeof(peak));
+	std::memcpy(&magnitude, &magnitudeBits, sizeof(magnitude));
+}
+
+static int64_t toTimestamp(AudioLevelTap::Clock::time_point time)
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		       time.time_since_epoch())
+		.count();
+}
+
+AudioLevelTap::AudioLevelTap(obs_weak_source_t *source)
+	: _source(source),
+	  _frames(frameCapacity),
+	  _mask(frameCapacity - 1)
+{
+	_volmeter = obs_volmeter_create(OBS_FADER_LOG);
+	obs_volmeter_add_callback(_volmeter, ReceiveLevels, this);
+	OBSSourceAutoRelease audioSource = obs_weak_source_get_source(source);
+	if (!obs_volmeter_attach_source(_volmeter, audioSource)) {
+		const char *name = obs_source_get_name(audioSource);
+		blog(LOG_WARNING, "failed to attach volmeter to source %s",
+		     name);
+	}
+}
+
+AudioLevelTap::~AudioLevelTap()
+{
+	obs_volmeter_remove_callback(_volmeter, ReceiveLevels, this);
+	obs_volmeter_destroy(_volmeter);
+
+	std::lock_guard<std::mutex> lock(tapsMutex);
+	auto it = taps.find(_source);
+	// A new tap might have already replaced this one
+	if (it != taps.end() && it->second.expired()) {
+		taps.erase(it);
+	}
+}
+
+std::shared_ptr<AudioLevelTap> AudioLevelTap::Get(obs_weak_source_t *source)
+{
+	if (!source) {
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(tapsMutex);
+	auto &entry = taps[source];
+	auto tap = entry.lock();
+	if (!tap) {
+		tap = std::shared_ptr<AudioLevelTap>(new AudioLevelTap(source));
+		entry = tap;
+	}
+	return tap;
+}
+
+void AudioLevelTap::ReceiveLevels(void *data,
+				  const float magnitude[MAX_AUDIO_CHANNELS],
+				  const float peak[MAX_AUDIO_CHANNELS],
+				  const float *)
+{
+	float maxPeak = minLevel;
+	float maxMagnitude = minLevel;
+	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
+		maxPeak = std::max(maxPeak, peak[i]);
+		maxMagnitude = std::max(maxMagnitude, magnitude[i]);
+	}
+	static_cast<AudioLevelTap *>(data)->AddFrame(maxPeak, maxMagnitude);
+}
+
+void AudioLevelTap::AddFrame(float peak, float magnitude)
+{
+	const auto position = _head.load(std::memory_order_relaxed);
+	auto &frame = _frames[position & _mask];
+
+	// Readers observing the new values of this frame must also observe the
+	// head, which was stored before, to detect that it was overwritten
+	std::atomic_thread_fence(std::memory_order_release);
+	frame.time.store(toTimestamp(Clock::now()), std::memory_order_relaxed);
+	frame.levels.store(packLevels(peak, magnitude),
+			   std::memory_order_relaxed);
+	_head.store(position + 1, std::memory_order_release);
+}
+
+AudioLevelTap::Statistics
+AudioLevelTap::GetStatistics(Clock::time_point since, double percentile) const
+{
+	// Reuse the buffer to avoid allocations on every check
+	thread_local std::vector<std::pair<uint64_t, uint64_t>> levels;
+	levels.clear();
+
+	const auto sinceTimestamp = toTimestamp(since);
+	const auto head = _head.load(std::memory_order_acquire);
+	const uint64_t capacity = _frames.size();
+	const auto oldest = head > capacity ? head - capacity : 0;
+	for (auto position = head; position > oldest; position--) {
+		const auto &frame = _frames[(position - 1) & _mask];
+		if (frame.time.load(std::memory_order_relaxed) <
+		    sinceTimestamp) {
+			break;
+		}
+		levels.emplace_back(
+			position - 1,
+			frame.levels.load(std::memory_order_relaxed));
+	}
+
+	// Discard frames which might have been overwritten while reading them
+	std::atomic_thread_fence(std::memory_order_acquire);
+	const auto currentHead = _head.load(std::memory_order_relaxed);
+	while (!levels.empty() &&
+	       currentHead - levels.back().first >= capacity) {
+		levels.pop_back();
+	}
+
+	Statistics stats;
+	stats.frameCount = levels.size();
+	if (levels.empty()) {
+		return stats;
+	}
+
+	thread_local std::vector<float> peaks;
+	peaks.clear();
+	double powerSum = 0.0;
+	for (const auto &[_, packed] : levels) {
+		float peak, magnitude;
+		unpackLevels(packed, peak, magnitude);
+		peaks.push_back(peak);
+		stats.maxPeak = std::max(stats.maxPeak, peak);
+		// Average the power instead of the decibel values
+		powerSum += std::pow(10.0, magnitude / 10.0);
+	}
+	stats.averageMagnitude =
+		float(10.0 * std::log10(powerSum / double(levels.size())));
+
+	const auto rank = std::clamp(percentile, 0.0, 100.0) / 100.0 *
+			  double(peaks.size() - 1);
+	auto nth = peaks.begin() + size_t(std::ceil(rank));
+	std::nth_element(peaks.begin(), nth, peaks.end());
+	stats.peakPercentile = *nth;
+	return stats;
+}
+
+AudioLevelTap::Clock::time_point AudioLevelTap::GetLastUpdate() const
+{
+	const auto head = _head.load(std::memory_order_acquire);
+	if (head == 0) {
+		return {};
+	}
+	const auto &frame = _frames[(head - 1) & _mask];
+	const auto timestamp = frame.time.load(std::memory_order_relaxed);
+	return Clock::time_point(std::chrono::duration_cast<Clock::duration>(
+		std::chrono::nanoseconds(timestamp)));
+}
+
+} // namespace advss
@@ -0,0 +1,71 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <obs.hpp>
+#include <vector>
+
+namespace advss {
+
+// Collects the audio levels of a source.
+// All users interested in the levels of the same source share a single tap
+// and thus a single volmeter.
+// The levels of recent audio frames are kept in a ring, which is written by
+// the audio thread and can be read from any thread without locking.
+class AudioLevelTap {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr float minLevel =
+		-std::numeric_limits<float>::infinity();
+	// The levels are kept for at least this long
+	static constexpr std::chrono::seconds maxHistory{60};
+
+	// All levels are in dBFS
+	struct Statistics {
+		size_t frameCount = 0;
+		float maxPeak = minLevel;
+		float peakPercentile = minLevel;
+		// Average of the magnitude (RMS) levels
+		float averageMagnitude = minLevel;
+	};
+
+	~AudioLevelTap();
+
+	// Returns the tap of the given source, which is created if necessary
+	EXPORT static std::shared_ptr<AudioLevelTap> Get(obs_weak_source_t *);
+
+	// Computes the statistics of all frames received since the given
+	// time, which are still available.
+	// The percentile is expected to be in the range of 0 to 100.
+	EXPORT Statistics GetStatistics(Clock::time_point since,
+					double percentile = 100.0) const;
+	// Returns a default constructed time point if no frame was received
+	EXPORT Clock::time_point GetLastUpdate() const;
+
+private:
+	struct Frame {
+		std::atomic<int64_t> time{0};
+		// Peak and magnitude stored as a pair of floats
+		std::atomic<uint64_t> levels{0};
+	};
+
+	explicit AudioLevelTap(obs_weak_source_t *);
+	static void ReceiveLevels(void *data,
+				  const float magnitude[MAX_AUDIO_CHANNELS],
+				  const float peak[MAX_AUDIO_CHANNELS],
+				  const float inputPeak[MAX_AUDIO_CHANNELS]);
+	void AddFrame(float peak, float magnitude);
+
+	OBSWeakSource _source;
+	obs_volmeter_t *_volmeter = nullptr;
+
+	std::vector<Frame> _frames;
+	const uint64_t _mask;
+	std::atomic<uint64_t> _head{0};
+};
+
+} // namespace advss
@@ -0,0 +1,78 @@
+#include "deadline-scheduler.hpp"
+
+namespace advss {
+
+// Outdated entries are removed once they make up most of the heap, which
+// might happen if owners keep moving their deadline
+constexpr size_t minCompactSize = 64;
+
+DeadlineScheduler &GetDeadlineScheduler()
+{
+	static DeadlineScheduler scheduler;
+	return scheduler;
+}
+
+void DeadlineScheduler::Schedule(const void *owner, Clock::time_point deadline)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	auto it = _deadlines.find(owner);
+	if (it != _deadlines.end() && it->second == deadline) {
+		return;
+	}
+	_deadlines[owner] = deadline;
+	_heap.push({deadline, owner});
+	if (_heap.size() >= minCompactSize &&
+	    _heap.size() > 2 * _deadlines.size()) {
+		Compact();
+	}
+}
+
+void DeadlineScheduler::Cancel(const void *owner)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_deadlines.erase(owner);
+}
+
+std::optional<DeadlineScheduler::Clock::time_point>
+DeadlineScheduler::NextDeadline(Clock::time_point now)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	while (!_heap.empty()) {
+		const auto &top = _heap.top();
+		if (!IsCurrent(top)) {
+			_heap.pop();
+			continue;
+		}
+		if (top.deadline <= now) {
+			_deadlines.erase(top.owner);
+			_heap.pop();
+			continue;
+		}
+		return top.deadline;
+	}
+	return {};
+}
+
+size_t DeadlineScheduler::Size() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _deadlines.size();
+}
+
+bool DeadlineScheduler::IsCurrent(const Entry &entry) const
+{
+	auto it = _deadlines.find(entry.owner);
+	return it != _deadlines.end() && it->second == entry.deadline;
+}
+
+void DeadlineScheduler::Compact()
+{
+	std::vector<Entry> entries;
+	entries.reserve(_deadlines.size());
+	for (const auto &[owner, deadline] : _deadlines) {
+		entries.push_back({deadline, owner});
+	}
+	_heap = decltype(_heap)(std::greater<Entry>(), std::move(entries));
+}
+
+} // namespace advss
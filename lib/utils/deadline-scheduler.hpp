@@ -0,0 +1,56 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <chrono>
+#include <mutex>
+#include <optional>
+#include <queue>
+#include <unordered_map>
+#include <vector>
+
+namespace advss {
+
+// Keeps track of the points in time at which time based conditions expect
+// their state to change.
+// The main loop wakes up at the earliest of these deadlines, so such changes
+// are noticed right away instead of only with the next interval.
+//
+// Can be used from any thread.
+class DeadlineScheduler {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	// Each owner has at most one deadline, which replaces any previously
+	// scheduled one
+	EXPORT void Schedule(const void *owner, Clock::time_point deadline);
+	EXPORT void Cancel(const void *owner);
+	// Returns the earliest deadline after the given point in time.
+	// Deadlines which were already reached are discarded.
+	EXPORT std::optional<Clock::time_point>
+	NextDeadline(Clock::time_point now = Clock::now());
+	EXPORT size_t Size() const;
+
+private:
+	struct Entry {
+		Clock::time_point deadline;
+		const void *owner;
+		bool operator>(const Entry &other) const
+		{
+			return deadline > other.deadline;
+		}
+	};
+
+	bool IsCurrent(const Entry &) const;
+	void Compact();
+
+	mutable std::mutex _mutex;
+	// Might contain entries which were replaced or cancelled since, which
+	// are skipped once they reach the top
+	std::priority_queue<Entry, std::vector<Entry>, std::greater<Entry>>
+		_heap;
+	std::unordered_map<const void *, Clock::time_point> _deadlines;
+};
+
+EXPORT DeadlineScheduler &GetDeadlineScheduler();
+
+} // namespace advss
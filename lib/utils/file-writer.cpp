@@ -0,0 +1,199 @@
+#include "file-writer.hpp"
+#include "log-helper.hpp"
+#ifndef UNIT_TEST
+#include "plugin-state-helpers.hpp"
+#endif
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace advss {
+
+// Larger files are always rewritten instead of keeping a copy of their
+// content around to detect if it changed
+constexpr size_t maxRememberedContentSize = 64 * 1024;
+
+#ifndef UNIT_TEST
+static bool setup();
+static bool setupDone = setup();
+
+static bool setup()
+{
+	AddPluginCleanupStep([]() { GetFileWriter().Stop(); });
+	return true;
+}
+#endif
+
+FileWriter &GetFileWriter()
+{
+	static FileWriter writer;
+	return writer;
+}
+
+void FileWriter::Write(const std::string &path, const std::string &content,
+		       bool atomic)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	auto &request = _pending[path];
+	request.content = content;
+	// Previous appends are overwritten by the new content anyway
+	request.appended.clear();
+	request.atomic = atomic;
+	Dispatch(lock);
+}
+
+void FileWriter::Append(const std::string &path, const std::string &text)
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_pending[path].appended += text;
+	Dispatch(lock);
+}
+
+void FileWriter::Flush()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	_idleCv.wait(lock, [this]() { return _pending.empty() && !_busy; });
+}
+
+void FileWriter::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_one();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+}
+
+void FileWriter::Dispatch(std::unique_lock<std::mutex> &lock)
+{
+	if (!_stop) {
+		if (!_thread.joinable()) {
+			_thread = std::thread(&FileWriter::Run, this);
+		}
+		_cv.notify_one();
+		return;
+	}
+
+	// The background thread is no longer available, so the request has to
+	// be processed right away
+	_idleCv.wait(lock, [this]() { return !_busy; });
+	auto requests = std::move(_pending);
+	_pending.clear();
+	for (auto &[path, request] : requests) {
+		Process(path, request);
+	}
+}
+
+void FileWriter::Run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (true) {
+		_cv.wait(lock, [this]() { return _stop || !_pending.empty(); });
+		if (_pending.empty()) {
+			break;
+		}
+
+		// Requests arriving in the meantime are coalesced with each
+		// other until the current ones are written
+		auto requests = std::move(_pending);
+		_pending.clear();
+		_busy = true;
+		lock.unlock();
+		for (auto &[path, request] : requests) {
+			Process(path, request);
+		}
+		lock.lock();
+		_busy = false;
+		_idleCv.notify_all();
+	}
+}
+
+void FileWriter::Process(const std::string &path, Request &request)
+{
+	const auto fileName = QString::fromStdString(path);
+	if (!request.content) {
+		QFile file(fileName);
+		const auto size = static_cast<qint64>(request.appended.size());
+		const bool success =
+			file.open(QIODevice::WriteOnly | QIODevice::Append) &&
+			file.write(request.appended.data(), size) == size;
+		ReportResult(path, success, file.errorString());
+		_written.erase(path);
+		return;
+	}
+
+	const auto content = *request.content + request.appended;
+	if (IsUnchanged(path, content)) {
+		return;
+	}
+
+	const auto size = static_cast<qint64>(content.size());
+	bool success = false;
+	QString error;
+	if (request.atomic) {
+		QSaveFile file(fileName);
+		success = file.open(QIODevice::WriteOnly) &&
+			  file.write(content.data(), size) == size &&
+			  file.commit();
+		error = file.errorString();
+	} else {
+		QFile file(fileName);
+		success = file.open(QIODevice::WriteOnly) &&
+			  file.write(content.data(), size) == size;
+		error = file.errorString();
+		// Make sure the modification time is final before checking it
+		file.close();
+	}
+
+	ReportResult(path, success, error);
+	if (success) {
+		UpdateWrittenState(path, content);
+	} else {
+		_written.erase(path);
+	}
+}
+
+void FileWriter::ReportResult(const std::string &path, bool success,
+			      const QString &error)
+{
+	if (success) {
+		_failing.erase(path);
+		return;
+	}
+	if (_failing.insert(path).second) {
+		blog(LOG_WARNING, "failed to write to file \"%s\": %s",
+		     path.c_str(), error.toUtf8().constData());
+	}
+}
+
+bool FileWriter::IsUnchanged(const std::string &path,
+			     const std::string &content) const
+{
+	auto it = _written.find(path);
+	if (it == _written.end() || it->second.content != content) {
+		return false;
+	}
+	const QFileInfo info(QString::fromStdString(path));
+	return info.exists() && info.size() == it->second.size &&
+	       info.lastModified() == it->second.lastModified;
+}
+
+void FileWriter::UpdateWrittenState(const std::string &path,
+				    const std::string &content)
+{
+	if (content.size() > maxRememberedContentSize) {
+		_written.erase(path);
+		return;
+	}
+	const QFileInfo info(QString::fromStdString(path));
+	auto &state = _written[path];
+	state.content = content;
+	state.lastModified = info.lastModified();
+	state.size = info.size();
+}
+
+} // namespace advss
@@ -0,0 +1,84 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+
+#include <QDateTime>
+
+namespace advss {
+
+// Performs file writes on a background thread, so slow storage like network
+// drives does not block the caller.
+//
+// Requests for the same file are coalesced:
+// Only the latest content is written and appends are combined into a single
+// write.
+// Files are only rewritten if their content actually changed.
+//
+// Can be used from any thread.
+class FileWriter {
+public:
+	// Replaces the content of the file.
+	// If atomic is set, the content is first written to a temporary file,
+	// which then replaces the original, so readers never observe a
+	// partially written file.
+	EXPORT void Write(const std::string &path, const std::string &content,
+			  bool atomic = false);
+	EXPORT void Append(const std::string &path, const std::string &text);
+	// Blocks until all requests issued so far have been processed
+	EXPORT void Flush();
+	// Processes the remaining requests and stops the background thread
+	EXPORT void Stop();
+
+private:
+	struct Request {
+		std::optional<std::string> content;
+		std::string appended;
+		bool atomic = false;
+	};
+
+	// What was last written to a file by this writer.
+	// If the file was modified by anyone else since, it must be rewritten.
+	struct WrittenState {
+		std::string content;
+		QDateTime lastModified;
+		qint64 size = 0;
+	};
+
+	void Dispatch(std::unique_lock<std::mutex> &);
+	void Run();
+	void Process(const std::string &path, Request &);
+	void ReportResult(const std::string &path, bool success,
+			  const QString &error);
+	bool IsUnchanged(const std::string &path,
+			 const std::string &content) const;
+	void UpdateWrittenState(const std::string &path,
+				const std::string &content);
+
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::condition_variable _idleCv;
+	std::unordered_map<std::string, Request> _pending;
+	// Set while the background thread processes requests, which were
+	// already removed from the pending ones
+	bool _busy = false;
+	bool _stop = false;
+	std::thread _thread;
+
+	// Only accessed while processing requests
+	std::unordered_map<std::string, WrittenState> _written;
+	// Failures are only logged once until the next successful write to
+	// avoid flooding the log with the status file being written each
+	// interval
+	std::unordered_set<std::string> _failing;
+};
+
+EXPORT FileWriter &GetFileWriter();
+
+} // namespace advss
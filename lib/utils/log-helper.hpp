@@ -1,4 +1,6 @@
 #pragma once
+#include "export-symbol-helper.hpp"
+
 #ifndef UNIT_TEST
 #include <util/base.h>
 #endif
@@ -1,40 +1,159 @@
 #include "math-helpers.hpp"
 #include "obs-module-helper.hpp"
 
+#include <algorithm>
 #include <climits>
 #include <exprtk.hpp>
+#include <memory>
 #include <random>
+#include <unordered_map>
+#include <vector>
 
 namespace advss {
 
-std::variant<double, std::string> EvalMathExpression(const std::string &expr)
+// Upper bound for the number of compiled expressions kept per thread
+constexpr size_t maxCachedExpressions = 256;
+
+namespace {
+
+struct CompiledExpression {
+	bool valid = false;
+	exprtk::expression<double> expression;
+	// Bound variables, which are referenced by the expression
+	exprtk::symbol_table<double> variables;
+	std::vector<std::string> variableNames;
+	// Must not be resized once bound to the symbol table
+	std::vector<double> variableValues;
+};
+
+} // namespace
+
+static double getRandomValue()
 {
-	static bool setupDone = false;
-	static exprtk::symbol_table<double> symbolTable;
-	static std::random_device rd;
-	static std::mt19937 gen(rd());
-	static std::uniform_real_distribution<double> dis(0.0, 1.0);
-	static auto randomFunc = []() {
-		return dis(gen);
-	};
+	thread_local std::mt19937 gen(std::random_device{}());
+	thread_local std::uniform_real_distribution<double> dis(0.0, 1.0);
+	return dis(gen);
+}
 
+static exprtk::symbol_table<double> &getFunctionSymbolTable()
+{
+	// exprtk symbol tables are not thread-safe, so each thread uses its own
+	thread_local exprtk::symbol_table<double> symbolTable;
+	thread_local bool setupDone = false;
 	if (!setupDone) {
-		symbolTable.add_function("random", randomFunc);
+		symbolTable.add_function("random", getRandomValue);
 		setupDone = true;
 	}
+	return symbolTable;
+}
+
+// Replaces all "${name}" references with symbols, which can be bound to
+// exprtk variables, and returns the referenced variable names
+static std::vector<std::string> replaceVariableReferences(std::string &expr)
+{
+	std::vector<std::string> names;
+	std::string result;
+	size_t pos = 0;
+	while (true) {
+		const auto start = expr.find("${", pos);
+		const auto end = start == std::string::npos
+					 ? std::string::npos
+					 : expr.find('}', start + 2);
+		if (end == std::string::npos) {
+			result += expr.substr(pos);
+			break;
+		}
+
+		const auto name = expr.substr(start + 2, end - start - 2);
+		auto it = std::find(names.begin(), names.end(), name);
+		const auto idx = std::distance(names.begin(), it);
+		if (it == names.end()) {
+			names.emplace_back(name);
+		}
+		result += expr.substr(pos, start - pos);
+		result += " advssVariable" + std::to_string(idx) + " ";
+		pos = end + 1;
+	}
+	expr = std::move(result);
+	return names;
+}
 
-	exprtk::expression<double> expression;
-	expression.register_symbol_table(symbolTable);
-	exprtk::parser<double> parser;
+static std::unique_ptr<CompiledExpression>
+compileExpression(const std::string &expr, bool bindVariables)
+{
+	auto compiled = std::make_unique<CompiledExpression>();
+	std::string text = expr;
+	if (bindVariables) {
+		compiled->variableNames = replaceVariableReferences(text);
+		compiled->variableValues.resize(compiled->variableNames.size());
+		for (size_t i = 0; i < compiled->variableNames.size(); i++) {
+			compiled->variables.add_variable(
+				"advssVariable" + std::to_string(i),
+				compiled->variableValues[i]);
+		}
+	}
+
+	compiled->expression.register_symbol_table(compiled->variables);
+	compiled->expression.register_symbol_table(getFunctionSymbolTable());
+	thread_local exprtk::parser<double> parser;
+	compiled->valid = parser.compile(text, compiled->expression);
+	return compiled;
+}
+
+static CompiledExpression &getCompiledExpression(const std::string &expr,
+						 bool bindVariables)
+{
+	// Each thread keeps its own cache, so no locking is required
+	thread_local std::unordered_map<std::string,
+					std::unique_ptr<CompiledExpression>>
+		caches[2];
+
+	auto &cache = caches[bindVariables];
+	auto it = cache.find(expr);
+	if (it != cache.end()) {
+		return *it->second;
+	}
 
-	if (parser.compile(expr, expression)) {
-		return expression.value();
+	if (cache.size() >= maxCachedExpressions) {
+		cache.clear();
 	}
+	auto compiled = compileExpression(expr, bindVariables);
+	return *cache.emplace(expr, std::move(compiled)).first->second;
+}
+
+static std::string getErrorText(const std::string &expr)
+{
 	return std::string(obs_module_text(
 		       "AdvSceneSwitcher.math.expressionFail")) +
 	       " \"" + expr + "\"";
 }
 
+std::variant<double, std::string> EvalMathExpression(const std::string &expr)
+{
+	auto &compiled = getCompiledExpression(expr, false);
+	if (!compiled.valid) {
+		return getErrorText(expr);
+	}
+	return compiled.expression.value();
+}
+
+std::variant<double, std::string>
+EvalMathExpression(const std::string &expr, const MathVariableLookup &lookup)
+{
+	auto &compiled = getCompiledExpression(expr, true);
+	if (!compiled.valid) {
+		return getErrorText(expr);
+	}
+	for (size_t i = 0; i < compiled.variableNames.size(); i++) {
+		const auto value = lookup(compiled.variableNames[i]);
+		if (!value) {
+			return getErrorText(expr);
+		}
+		compiled.variableValues[i] = *value;
+	}
+	return compiled.expression.value();
+}
+
 bool IsValidNumber(const std::string &str)
 {
 	return GetDouble(str).has_value();
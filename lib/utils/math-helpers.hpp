@@ -1,14 +1,25 @@
 #pragma once
 #include "export-symbol-helper.hpp"
 
+#include <functional>
 #include <string>
 #include <variant>
 #include <optional>
 
 namespace advss {
 
+// Returns the numeric value of the variable with the given name, if possible
+using MathVariableLookup =
+	std::function<std::optional<double>(const std::string &name)>;
+
 std::variant<double, std::string>
 EvalMathExpression(const std::string &expression);
+// Variable references of the form "${name}" in the expression are bound to the
+// values returned by the lookup function instead of being substituted as text.
+// Thus the compiled expression can be reused when the variable values change.
+// Fails if the lookup function does not return a value for a reference.
+std::variant<double, std::string>
+EvalMathExpression(const std::string &expression, const MathVariableLookup &);
 bool IsValidNumber(const std::string &str);
 EXPORT std::optional<double> GetDouble(const std::string &str);
 EXPORT std::optional<int> GetInt(const std::string &str);
@@ -0,0 +1,180 @@
+#include "message-buffer-settings.hpp"
+#include "layout-helpers.hpp"
+#include "macro.hpp"
+#include "macro-condition.hpp"
+#include "macro-helpers.hpp"
+#include "obs-module-helper.hpp"
+#include "sync-helpers.hpp"
+#include "websocket-api.hpp"
+
+#include <map>
+#include <obs.hpp>
+#include <QHBoxLayout>
+
+namespace advss {
+
+static constexpr char statsRequestName[] = "GetMessageBufferStatistics";
+
+static const std::map<MessageBufferPolicy, std::string> policies = {
+	{MessageBufferPolicy::DROP_OLDEST,
+	 "AdvSceneSwitcher.messageBuffer.policy.dropOldest"},
+	{MessageBufferPolicy::DROP_NEWEST,
+	 "AdvSceneSwitcher.messageBuffer.policy.dropNewest"},
+	{MessageBufferPolicy::COALESCE,
+	 "AdvSceneSwitcher.messageBuffer.policy.coalesce"},
+};
+
+static void getMessageBufferStats(obs_data_t *, obs_data_t *response);
+
+static bool setup();
+static bool setupDone = setup();
+
+bool setup()
+{
+	RegisterWebsocketRequest(statsRequestName, getMessageBufferStats);
+	return true;
+}
+
+static void getMessageBufferStats(obs_data_t *, obs_data_t *response)
+{
+	auto lock = LockContext();
+	OBSDataArrayAutoRelease buffers = obs_data_array_create();
+	for (const auto &macro : GetMacros()) {
+		const auto &conditions = macro->Conditions();
+		for (size_t i = 0; i < conditions.size(); i++) {
+			auto buffer = conditions[i]->GetMessageBuffer();
+			if (!buffer) {
+				continue;
+			}
+			const auto stats = buffer->GetStats();
+			OBSDataAutoRelease entry = obs_data_create();
+			obs_data_set_string(entry, "macro",
+					    macro->Name().c_str());
+			obs_data_set_int(entry, "conditionIndex", i);
+			obs_data_set_string(entry, "condition",
+					    conditions[i]->GetId().c_str());
+			obs_data_set_int(entry, "pending", stats.pending);
+			obs_data_set_int(entry, "highWaterMark",
+					 stats.highWaterMark);
+			obs_data_set_int(entry, "dropped", stats.dropped);
+			obs_data_array_push_back(buffers, entry);
+		}
+	}
+	obs_data_set_array(response, "buffers", buffers);
+}
+
+void MessageBufferSettings::Save(obs_data_t *obj, const char *name) const
+{
+	OBSDataAutoRelease data = obs_data_create();
+	obs_data_set_int(data, "capacity", _capacity);
+	obs_data_set_int(data, "policy", static_cast<int>(_policy));
+	obs_data_set_obj(obj, name, data);
+}
+
+void MessageBufferSettings::Load(obs_data_t *obj, const char *name)
+{
+	OBSDataAutoRelease data = obs_data_get_obj(obj, name);
+	_capacity = obs_data_get_int(data, "capacity");
+	_policy = static_cast<MessageBufferPolicy>(
+		obs_data_get_int(data, "policy"));
+}
+
+void MessageBufferSettings::Apply(MessageBufferBase *buffer) const
+{
+	if (!buffer) {
+		return;
+	}
+	buffer->SetLimit(_capacity, _policy);
+}
+
+MessageBufferSettingsWidget::MessageBufferSettingsWidget(QWidget *parent)
+	: QWidget(parent),
+	  _capacity(new QSpinBox(this)),
+	  _policy(new QComboBox(this)),
+	  _stats(new QLabel(this))
+{
+	_capacity->setMinimum(0);
+	// Buffers can not hold more messages than their ring anyway
+	_capacity->setMaximum(static_cast<int>(defaultMessageRingCapacity));
+	_capacity->setSpecialValueText(
+		obs_module_text("AdvSceneSwitcher.messageBuffer.unlimited"));
+	for (const auto &[policy, name] : policies) {
+		_policy->addItem(obs_module_text(name.c_str()),
+				 static_cast<int>(policy));
+	}
+	_stats->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.messageBuffer.stats.tooltip"));
+	_stats->hide();
+
+	QWidget::connect(_capacity, SIGNAL(valueChanged(int)), this,
+			 SLOT(CapacityChanged(int)));
+	QWidget::connect(_policy, SIGNAL(currentIndexChanged(int)), this,
+			 SLOT(PolicyChanged(int)));
+	QWidget::connect(&_timer, SIGNAL(timeout()), this, SLOT(UpdateStats()));
+
+	auto layout = new QHBoxLayout();
+	layout->setContentsMargins(0, 0, 0, 0);
+	PlaceWidgets(obs_module_text("AdvSceneSwitcher.messageBuffer.layout"),
+		     layout,
+		     {{"{{capacity}}", _capacity}, {"{{policy}}", _policy}});
+	layout->addWidget(_stats);
+	setLayout(layout);
+}
+
+void MessageBufferSettingsWidget::SetSettings(
+	const MessageBufferSettings &settings)
+{
+	_settings = settings;
+	const QSignalBlocker b1(_capacity);
+	const QSignalBlocker b2(_policy);
+	_capacity->setValue(settings._capacity);
+	_policy->setCurrentIndex(
+		_policy->findData(static_cast<int>(settings._policy)));
+	_policy->setEnabled(settings._capacity > 0);
+}
+
+void MessageBufferSettingsWidget::SetStatsSource(const StatsSource &source)
+{
+	_statsSource = source;
+	_stats->setVisible(!!source);
+	if (!source) {
+		_timer.stop();
+		return;
+	}
+	UpdateStats();
+	_timer.start(1000);
+}
+
+void MessageBufferSettingsWidget::CapacityChanged(int value)
+{
+	_settings._capacity = value;
+	_policy->setEnabled(value > 0);
+	emit SettingsChanged(_settings);
+}
+
+void MessageBufferSettingsWidget::PolicyChanged(int index)
+{
+	_settings._policy = static_cast<MessageBufferPolicy>(
+		_policy->itemData(index).toInt());
+	emit SettingsChanged(_settings);
+}
+
+void MessageBufferSettingsWidget::UpdateStats()
+{
+	if (!_statsSource) {
+		return;
+	}
+	auto buffer = _statsSource();
+	if (!buffer) {
+		_stats->clear();
+		return;
+	}
+	const auto stats = buffer->GetStats();
+	_stats->setText(
+		QString(obs_module_text("AdvSceneSwitcher.messageBuffer.stats"))
+			.arg(stats.pending)
+			.arg(stats.highWaterMark)
+			.arg(stats.dropped));
+}
+
+} // namespace advss
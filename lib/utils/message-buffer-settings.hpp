@@ -0,0 +1,58 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+#include "message-buffer.hpp"
+
+#include <functional>
+#include <obs-data.h>
+#include <QComboBox>
+#include <QLabel>
+#include <QSpinBox>
+#include <QTimer>
+#include <QWidget>
+
+namespace advss {
+
+class MessageBufferSettingsWidget;
+
+class MessageBufferSettings {
+public:
+	EXPORT void Save(obs_data_t *obj,
+			 const char *name = "messageBuffer") const;
+	EXPORT void Load(obs_data_t *obj, const char *name = "messageBuffer");
+	EXPORT void Apply(MessageBufferBase *) const;
+
+private:
+	// A capacity of 0 means the buffer is unbounded
+	int _capacity = 0;
+	MessageBufferPolicy _policy = MessageBufferPolicy::DROP_OLDEST;
+	friend MessageBufferSettingsWidget;
+};
+
+class ADVSS_EXPORT MessageBufferSettingsWidget : public QWidget {
+	Q_OBJECT
+public:
+	using StatsSource = std::function<std::shared_ptr<MessageBufferBase>()>;
+
+	MessageBufferSettingsWidget(QWidget *parent = nullptr);
+	void SetSettings(const MessageBufferSettings &);
+	// The given function will be called periodically to display the
+	// statistics of the currently used buffer
+	void SetStatsSource(const StatsSource &);
+
+private slots:
+	void CapacityChanged(int);
+	void PolicyChanged(int);
+	void UpdateStats();
+signals:
+	void SettingsChanged(const MessageBufferSettings &);
+
+private:
+	QSpinBox *_capacity;
+	QComboBox *_policy;
+	QLabel *_stats;
+	QTimer _timer;
+	StatsSource _statsSource;
+	MessageBufferSettings _settings;
+};
+
+} // namespace advss
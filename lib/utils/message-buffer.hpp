@@ -1,49 +1,251 @@
 #pragma once
-#include <deque>
-#include <mutex>
-#include <optional>
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
 
 namespace advss {
 
-template<class T> class MessageBuffer {
+// Fixed size ring of messages shared by a MessageDispatcher and all of its
+// clients.
+// Each message is stored only once and all clients read it using their own
+// cursor, so messages are neither copied per client nor is a lock shared by
+// all clients required to read them.
+//
+// Publish() must not be called concurrently.
+template<class T> class MessageRing {
 public:
-	bool Empty();
+	explicit MessageRing(size_t capacity);
+	void Publish(std::shared_ptr<const T> message);
+	uint64_t Head() const { return _head.load(std::memory_order_acquire); }
+	uint64_t Capacity() const { return _slots.size(); }
+	std::shared_ptr<const T> Load(uint64_t position) const;
+
+private:
+	static size_t RoundUpToPowerOfTwo(size_t);
+
+	std::vector<std::shared_ptr<const T>> _slots;
+	const uint64_t _mask;
+	std::atomic<uint64_t> _head{0};
+};
+
+// Number of messages kept by the ring of a MessageDispatcher by default, which
+// is also the most a MessageBuffer can hold
+constexpr size_t defaultMessageRingCapacity = 1024;
+
+// Determines which messages to discard once more messages than the capacity
+// of a MessageBuffer are waiting to be consumed
+enum class MessageBufferPolicy {
+	DROP_OLDEST,
+	DROP_NEWEST,
+	// Only keep the most recent message
+	COALESCE,
+};
+
+struct MessageBufferStats {
+	uint64_t pending = 0;
+	uint64_t highWaterMark = 0;
+	uint64_t dropped = 0;
+};
+
+// Message type independent interface of MessageBuffer
+class MessageBufferBase {
+public:
+	virtual ~MessageBufferBase() = default;
+	// A capacity of 0 only limits the buffer by the size of the ring
+	virtual void SetLimit(uint64_t capacity, MessageBufferPolicy) = 0;
+	virtual MessageBufferStats GetStats() const = 0;
+};
+
+template<class T> class MessageBuffer : public MessageBufferBase {
+public:
+	explicit MessageBuffer(const std::shared_ptr<MessageRing<T>> &ring);
+	bool Empty() const;
 	void Clear();
-	void AppendMessage(const T &);
-	std::optional<T> ConsumeMessage();
+	std::shared_ptr<const T> ConsumeMessage();
+
+	void SetLimit(uint64_t capacity, MessageBufferPolicy) override;
+	MessageBufferStats GetStats() const override;
 
 private:
-	std::deque<T> _buffer;
-	std::mutex _mutex;
+	uint64_t ApplyLimit(uint64_t cursor, uint64_t head);
+	void UpdateHighWaterMark(uint64_t pending);
+
+	std::shared_ptr<MessageRing<T>> _ring;
+	std::atomic<uint64_t> _cursor;
+
+	std::atomic<uint64_t> _capacity{0};
+	std::atomic<MessageBufferPolicy> _policy{
+		MessageBufferPolicy::DROP_OLDEST};
+	// Range of messages to skip for MessageBufferPolicy::DROP_NEWEST
+	std::atomic<uint64_t> _skipFrom{0};
+	std::atomic<uint64_t> _skipTo{0};
+
+	std::atomic<uint64_t> _highWaterMark{0};
+	std::atomic<uint64_t> _dropped{0};
 };
 
-template<class T> inline bool MessageBuffer<T>::Empty()
+template<class T>
+inline size_t MessageRing<T>::RoundUpToPowerOfTwo(size_t value)
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	return _buffer.empty();
+	size_t result = 1;
+	while (result < value) {
+		result <<= 1;
+	}
+	return result;
+}
+
+template<class T>
+inline MessageRing<T>::MessageRing(size_t capacity)
+	: _slots(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+	  _mask(_slots.size() - 1)
+{
+}
+
+template<class T>
+inline void MessageRing<T>::Publish(std::shared_ptr<const T> message)
+{
+	const auto position = _head.load(std::memory_order_relaxed);
+	std::atomic_store_explicit(&_slots[position & _mask],
+				   std::move(message),
+				   std::memory_order_release);
+	_head.store(position + 1, std::memory_order_release);
+}
+
+template<class T>
+inline std::shared_ptr<const T> MessageRing<T>::Load(uint64_t position) const
+{
+	return std::atomic_load_explicit(&_slots[position & _mask],
+					 std::memory_order_acquire);
+}
+
+template<class T>
+inline MessageBuffer<T>::MessageBuffer(
+	const std::shared_ptr<MessageRing<T>> &ring)
+	: _ring(ring),
+	  _cursor(ring->Head())
+{
+}
+
+template<class T> inline bool MessageBuffer<T>::Empty() const
+{
+	return _cursor.load(std::memory_order_acquire) == _ring->Head();
 }
 
 template<class T> inline void MessageBuffer<T>::Clear()
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	_buffer.clear();
+	_cursor.store(_ring->Head(), std::memory_order_release);
 }
 
-template<class T> inline void MessageBuffer<T>::AppendMessage(const T &message)
+template<class T>
+inline std::shared_ptr<const T> MessageBuffer<T>::ConsumeMessage()
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	_buffer.emplace_back(message);
+	auto cursor = _cursor.load(std::memory_order_acquire);
+	while (true) {
+		const auto head = _ring->Head();
+		if (cursor == head) {
+			return {};
+		}
+		UpdateHighWaterMark(
+			std::min(head - cursor, _ring->Capacity() - 1));
+
+		auto position = ApplyLimit(cursor, head);
+
+		// Skip messages which were already overwritten, as this client
+		// did not keep up with the dispatcher.
+		// The slot following the head might be overwritten at any time.
+		const auto capacity = _ring->Capacity();
+		if (head - position >= capacity) {
+			position = head - capacity + 1;
+		}
+
+		const auto expected = cursor;
+		if (position == head) {
+			if (_cursor.compare_exchange_weak(
+				    cursor, position, std::memory_order_acq_rel)) {
+				_dropped.fetch_add(position - expected,
+						   std::memory_order_relaxed);
+				return {};
+			}
+			continue;
+		}
+
+		auto message = _ring->Load(position);
+		if (_ring->Head() - position >= capacity) {
+			// Overwritten while reading it
+			continue;
+		}
+		if (_cursor.compare_exchange_weak(cursor, position + 1,
+						  std::memory_order_acq_rel)) {
+			_dropped.fetch_add(position - expected,
+					   std::memory_order_relaxed);
+			return message;
+		}
+		// Consumed concurrently, so retry with the updated cursor
+	}
 }
 
-template<class T> inline std::optional<T> MessageBuffer<T>::ConsumeMessage()
+template<class T>
+inline uint64_t MessageBuffer<T>::ApplyLimit(uint64_t cursor, uint64_t head)
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	if (_buffer.empty()) {
-		return {};
+	const auto capacity = _capacity.load(std::memory_order_relaxed);
+	const auto pending = head - cursor;
+	const bool limitExceeded = capacity > 0 && pending > capacity;
+
+	switch (_policy.load(std::memory_order_relaxed)) {
+	case MessageBufferPolicy::DROP_OLDEST:
+		return limitExceeded ? head - capacity : cursor;
+	case MessageBufferPolicy::DROP_NEWEST: {
+		const auto skipFrom = _skipFrom.load(std::memory_order_relaxed);
+		const auto skipTo = _skipTo.load(std::memory_order_relaxed);
+		if (cursor < skipTo) {
+			return cursor >= skipFrom ? skipTo : cursor;
+		}
+		if (limitExceeded) {
+			// Keep the oldest messages and drop the ones which
+			// were received after the capacity was reached
+			_skipFrom.store(cursor + capacity,
+					std::memory_order_relaxed);
+			_skipTo.store(head, std::memory_order_relaxed);
+		}
+		return cursor;
+	}
+	case MessageBufferPolicy::COALESCE:
+		return limitExceeded ? head - 1 : cursor;
+	default:
+		break;
+	}
+	return cursor;
+}
+
+template<class T>
+inline void MessageBuffer<T>::UpdateHighWaterMark(uint64_t pending)
+{
+	auto current = _highWaterMark.load(std::memory_order_relaxed);
+	while (pending > current &&
+	       !_highWaterMark.compare_exchange_weak(
+		       current, pending, std::memory_order_relaxed)) {
 	}
-	T message = _buffer.at(0);
-	_buffer.pop_front();
-	return message;
+}
+
+template<class T>
+inline void MessageBuffer<T>::SetLimit(uint64_t capacity,
+				       MessageBufferPolicy policy)
+{
+	_capacity.store(capacity, std::memory_order_relaxed);
+	_policy.store(policy, std::memory_order_relaxed);
+}
+
+template<class T> inline MessageBufferStats MessageBuffer<T>::GetStats() const
+{
+	MessageBufferStats stats;
+	const auto pending =
+		_ring->Head() - _cursor.load(std::memory_order_acquire);
+	stats.pending = std::min(pending, _ring->Capacity() - 1);
+	stats.highWaterMark = _highWaterMark.load(std::memory_order_relaxed);
+	stats.dropped = _dropped.load(std::memory_order_relaxed);
+	return stats;
 }
 
 } // namespace advss
@@ -1,50 +1,68 @@
 #pragma once
 #include "message-buffer.hpp"
 
-#include <algorithm>
 #include <memory>
-#include <vector>
+#include <mutex>
 
 namespace advss {
 
 template<class T> class MessageDispatcher {
 public:
+	explicit MessageDispatcher(size_t capacity = defaultMessageRingCapacity);
 	[[nodiscard]] std::shared_ptr<MessageBuffer<T>> RegisterClient();
 	void DispatchMessage(const T &message);
+	void DispatchMessage(T &&message);
+	void DispatchMessage(std::shared_ptr<const T> message);
 
 private:
-	std::vector<std::weak_ptr<MessageBuffer<T>>> _clients;
+	bool HasClients() const;
+
+	std::shared_ptr<MessageRing<T>> _ring;
 	std::mutex _mutex;
 };
 
+template<class T>
+inline MessageDispatcher<T>::MessageDispatcher(size_t capacity)
+	: _ring(std::make_shared<MessageRing<T>>(capacity))
+{
+}
+
 template<class T>
 inline std::shared_ptr<MessageBuffer<T>> MessageDispatcher<T>::RegisterClient()
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	// Clear expired client buffers
-	auto isExpired = [](const std::weak_ptr<MessageBuffer<T>> &ptr) {
-		return ptr.expired();
-	};
-	_clients.erase(std::remove_if(_clients.begin(), _clients.end(),
-				      isExpired),
-		       _clients.end());
-	// Prepare new buffer for client
-	auto buffer = std::make_shared<MessageBuffer<T>>();
-	_clients.emplace_back(buffer);
-	return buffer;
+	return std::make_shared<MessageBuffer<T>>(_ring);
+}
+
+template<class T> inline bool MessageDispatcher<T>::HasClients() const
+{
+	// Each client buffer holds a reference to the ring
+	return _ring.use_count() > 1;
 }
 
 template<class T>
 inline void MessageDispatcher<T>::DispatchMessage(const T &message)
 {
-	std::lock_guard<std::mutex> lock(_mutex);
-	for (auto &client_ : _clients) {
-		auto client = client_.lock();
-		if (!client) {
-			continue;
-		}
-		client->AppendMessage(message);
+	if (!HasClients()) {
+		return;
 	}
+	DispatchMessage(std::make_shared<const T>(message));
+}
+
+template<class T> inline void MessageDispatcher<T>::DispatchMessage(T &&message)
+{
+	if (!HasClients()) {
+		return;
+	}
+	DispatchMessage(std::make_shared<const T>(std::move(message)));
+}
+
+template<class T>
+inline void
+MessageDispatcher<T>::DispatchMessage(std::shared_ptr<const T> message)
+{
+	// Messages might be dispatched from multiple threads
+	std::lock_guard<std::mutex> lock(_mutex);
+	_ring->Publish(std::move(message));
 }
 
 } // namespace advss
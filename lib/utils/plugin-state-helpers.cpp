@@ -121,6 +121,19 @@ int GetIntervalValue()
 	return GetSwitcher()->interval;
 }
 
+void RequestImmediateCheck()
+{
+	auto switcher = GetSwitcher();
+	if (!switcher) {
+		return;
+	}
+	// Only the first request until the next check has to wake up the
+	// main loop
+	if (!switcher->checkRequested.exchange(true)) {
+		switcher->cv.notify_one();
+	}
+}
+
 void SetPluginNoMatchBehavior(NoMatchBehavior behavior)
 {
 	GetSwitcher()->switchIfNotMatching = behavior;
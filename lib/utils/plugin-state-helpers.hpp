@@ -25,6 +25,10 @@ EXPORT void StopPlugin();
 EXPORT void StartPlugin();
 EXPORT bool PluginIsRunning();
 EXPORT int GetIntervalValue();
+// Wakes up the main loop to check the macro conditions without waiting for
+// the current interval to pass.
+// Can be called from any thread.
+EXPORT void RequestImmediateCheck();
 
 enum class NoMatchBehavior { NO_SWITCH = 0, SWITCH = 1, RANDOM_SWITCH = 2 };
 EXPORT void SetPluginNoMatchBehavior(NoMatchBehavior);
@@ -3,10 +3,24 @@
 #include "path-helpers.hpp"
 #include "ui-helpers.hpp"
 
+#include <QHash>
 #include <QLayout>
 
 namespace advss {
 
+// Upper bound for the number of compiled expressions kept per thread
+constexpr int maxCachedExpressions = 256;
+
+namespace {
+
+struct CompiledRegex {
+	QRegularExpression regex;
+	// Text every match has to start with, if it could be determined
+	QString literalPrefix;
+};
+
+} // namespace
+
 RegexConfig::RegexConfig(bool enabled) : _enable(enabled) {}
 
 void RegexConfig::Save(obs_data_t *obj, const char *name) const
@@ -62,13 +76,94 @@ RegexConfig::GetRegularExpression(const std::string &expr) const
 	return GetRegularExpression(QString::fromStdString(expr));
 }
 
+static bool isMetaCharacter(QChar c)
+{
+	static const QString metaCharacters = "\\^$.|?*+()[]{}";
+	return metaCharacters.contains(c);
+}
+
+static bool isQuantifier(QChar c)
+{
+	return c == '?' || c == '*' || c == '+' || c == '{';
+}
+
+static QString
+getLiteralPrefix(const QString &expression,
+		 QRegularExpression::PatternOptions options, bool partialMatch)
+{
+	// Don't bother with options changing how literal text is matched
+	if (options & (QRegularExpression::CaseInsensitiveOption |
+		       QRegularExpression::ExtendedPatternSyntaxOption |
+		       QRegularExpression::MultilineOption)) {
+		return {};
+	}
+	// Alternatives might start with different text
+	if (expression.contains('|')) {
+		return {};
+	}
+
+	int idx = 0;
+	if (partialMatch) {
+		// Partial matches can start anywhere unless anchored
+		if (!expression.startsWith('^')) {
+			return {};
+		}
+		idx = 1;
+	}
+
+	QString prefix;
+	for (; idx < expression.size(); idx++) {
+		const auto c = expression.at(idx);
+		if (!isMetaCharacter(c)) {
+			prefix += c;
+			continue;
+		}
+		// The previous character is optional or repeated
+		if (isQuantifier(c)) {
+			prefix.chop(1);
+		}
+		break;
+	}
+	return prefix;
+}
+
+static const CompiledRegex &getCompiledRegex(const RegexConfig &config,
+					     const QString &expression,
+					     bool partialMatch)
+{
+	// Each thread keeps its own cache, so no locking is required
+	thread_local QHash<QPair<QString, int>, CompiledRegex> cache;
+
+	const auto options = config.GetPatternOptions();
+	const QPair<QString, int> key(
+		expression, static_cast<int>(options) * 2 + partialMatch);
+	auto it = cache.constFind(key);
+	if (it != cache.constEnd()) {
+		return it.value();
+	}
+
+	if (cache.size() >= maxCachedExpressions) {
+		cache.clear();
+	}
+	CompiledRegex compiled;
+	compiled.regex = config.GetRegularExpression(expression);
+	compiled.regex.optimize();
+	compiled.literalPrefix =
+		getLiteralPrefix(expression, options, partialMatch);
+	return cache.insert(key, compiled).value();
+}
+
 bool RegexConfig::Matches(const QString &text, const QString &expression) const
 {
-	auto regex = GetRegularExpression(expression);
-	if (!regex.isValid()) {
+	const auto &compiled =
+		getCompiledRegex(*this, expression, _partialMatch);
+	if (!compiled.regex.isValid()) {
+		return false;
+	}
+	if (!text.startsWith(compiled.literalPrefix)) {
 		return false;
 	}
-	auto match = regex.match(text);
+	auto match = compiled.regex.match(text);
 	return match.hasMatch();
 }
 
@@ -4,11 +4,13 @@
 #include "scene-switch-helpers.hpp"
 #include "selection-helpers.hpp"
 #include "source-helpers.hpp"
+#include "source-list-model.hpp"
 #include "ui-helpers.hpp"
 #include "utility.hpp"
 #include "variable.hpp"
 
 #include <obs-frontend-api.h>
+#include <QTimer>
 
 namespace advss {
 
@@ -234,20 +236,6 @@ static QStringList getOrderList(bool current, bool previous, bool preview)
 	return list;
 }
 
-static QStringList getScenesList()
-{
-	QStringList list;
-	char **scenes = obs_frontend_get_scene_names();
-	char **temp = scenes;
-	while (*temp) {
-		const char *name = *temp;
-		list << name;
-		temp++;
-	}
-	bfree(scenes);
-	return list;
-}
-
 static QStringList getSceneGroupsList()
 {
 	QStringList list;
@@ -287,7 +275,7 @@ void SceneSelectionWidget::PopulateSelection()
 	}
 	_groupsEndIdx = count();
 
-	const QStringList scenes = getScenesList();
+	const QStringList scenes = GetSceneNames();
 	AddSelectionGroup(this, scenes);
 	_scenesEndIdx = count();
 
@@ -333,6 +321,32 @@ SceneSelectionWidget::SceneSelectionWidget(QWidget *parent, bool variables,
 	QWidget::connect(VariableSignalManager::Instance(),
 			 SIGNAL(Rename(const QString &, const QString &)), this,
 			 SLOT(ItemRename(const QString &, const QString &)));
+
+	// Scenes
+	auto scenes = SourceListFilterModel::Scenes();
+	QWidget::connect(scenes, &QAbstractItemModel::rowsInserted, this,
+			 &SceneSelectionWidget::SceneListChanged);
+	QWidget::connect(scenes, &QAbstractItemModel::rowsRemoved, this,
+			 &SceneSelectionWidget::SceneListChanged);
+	QWidget::connect(scenes, &QAbstractItemModel::dataChanged, this,
+			 &SceneSelectionWidget::SceneListChanged);
+	QWidget::connect(scenes, &QAbstractItemModel::modelReset, this,
+			 &SceneSelectionWidget::SceneListChanged);
+}
+
+void SceneSelectionWidget::SceneListChanged()
+{
+	// Scenes are usually added or removed in bulk, e.g. when switching
+	// scene collections, so only update the selection once
+	if (_sceneListUpdateScheduled) {
+		return;
+	}
+	_sceneListUpdateScheduled = true;
+	QTimer::singleShot(0, this, [this]() {
+		_sceneListUpdateScheduled = false;
+		const QSignalBlocker b(this);
+		Reset();
+	});
 }
 
 void SceneSelectionWidget::SetScene(const SceneSelection &s)
@@ -53,6 +53,7 @@ private slots:
 	EXPORT void ItemAdd(const QString &name);
 	EXPORT void ItemRemove(const QString &name);
 	EXPORT void ItemRename(const QString &oldName, const QString &newName);
+	void SceneListChanged();
 
 private:
 	void Reset();
@@ -70,6 +71,7 @@ private:
 	bool _sceneGroups;
 
 	SceneSelection _currentSelection;
+	bool _sceneListUpdateScheduled = false;
 
 	// Order of entries
 	// 1. "select entry" entry
@@ -44,6 +44,10 @@ Section::Section(const int animationDuration, QWidget *parent)
 
 void Section::Collapse(bool collapse)
 {
+	if (!collapse) {
+		CreateLazyContent();
+	}
+
 	_toggleButton->setChecked(collapse);
 	_toggleButton->setArrowType(collapse ? Qt::ArrowType::RightArrow
 					     : Qt::ArrowType::DownArrow);
@@ -62,6 +66,7 @@ void Section::SetContent(QWidget *w)
 
 void Section::SetContent(QWidget *w, bool collapsed)
 {
+	_createContent = nullptr;
 	CleanUpPreviousContent();
 	delete _contentArea;
 
@@ -101,6 +106,28 @@ void Section::SetContent(QWidget *w, bool collapsed)
 	_collapsed = collapsed;
 }
 
+void Section::SetLazyContent(const std::function<QWidget *()> &createContent,
+			     bool collapsed)
+{
+	// Use an empty placeholder until the actual content is required
+	auto placeholder = new QWidget();
+	auto layout = new QVBoxLayout();
+	layout->setContentsMargins(0, 0, 0, 0);
+	placeholder->setLayout(layout);
+	SetContent(placeholder, collapsed);
+	_createContent = createContent;
+}
+
+void Section::CreateLazyContent()
+{
+	if (!_createContent) {
+		return;
+	}
+	auto createContent = std::move(_createContent);
+	_createContent = nullptr;
+	SetContent(createContent(), _toggleButton->isChecked());
+}
+
 void Section::AddHeaderWidget(QWidget *w)
 {
 	_headerWidgetLayout->addWidget(w);
@@ -6,6 +6,7 @@
 #include <QScrollArea>
 #include <QToolButton>
 #include <QWidget>
+#include <functional>
 
 namespace advss {
 
@@ -18,6 +19,12 @@ public:
 
 	void SetContent(QWidget *w);
 	void SetContent(QWidget *w, bool collapsed);
+	// The content widget will only be created once the section is expanded
+	// or CreateLazyContent() is called
+	void SetLazyContent(const std::function<QWidget *()> &createContent,
+			    bool collapsed);
+	void CreateLazyContent();
+	bool HasLazyContent() const { return !!_createContent; }
 	void AddHeaderWidget(QWidget *);
 	void SetCollapsed(bool);
 
@@ -43,6 +50,7 @@ private:
 	QParallelAnimationGroup *_contentAnimation = nullptr;
 	QScrollArea *_contentArea = nullptr;
 	QWidget *_content = nullptr;
+	std::function<QWidget *()> _createContent;
 	int _animationDuration;
 	std::atomic_bool _transitioning = {false};
 	std::atomic_bool _collapsed = {false};
@@ -2,6 +2,7 @@
 #include "obs-module-helper.hpp"
 #include "platform-funcs.hpp"
 #include "source-helpers.hpp"
+#include "source-list-model.hpp"
 #include "scene-group.hpp"
 
 #include <obs-frontend-api.h>
@@ -11,20 +12,7 @@ namespace advss {
 
 QStringList GetAudioSourceNames()
 {
-	auto sourceEnum = [](void *param, obs_source_t *source) -> bool /* -- */
-	{
-		QStringList *list = reinterpret_cast<QStringList *>(param);
-		uint32_t flags = obs_source_get_output_flags(source);
-
-		if ((flags & OBS_SOURCE_AUDIO) != 0) {
-			*list << obs_source_get_name(source);
-		}
-		return true;
-	};
-
-	QStringList list;
-	obs_enum_sources(sourceEnum, &list);
-	return list;
+	return SourceListFilterModel::AudioSources()->Names();
 }
 
 static void hasFilterEnum(obs_source_t *, obs_source_t *filter, void *ptr)
@@ -59,64 +47,22 @@ QStringList GetSourcesWithFilterNames()
 
 QStringList GetMediaSourceNames()
 {
-	auto sourceEnum = [](void *param, obs_source_t *source) -> bool /* -- */
-	{
-		QStringList *list = reinterpret_cast<QStringList *>(param);
-		if (IsMediaSource(source)) {
-			*list << obs_source_get_name(source);
-		}
-		return true;
-	};
-
-	QStringList list;
-	obs_enum_sources(sourceEnum, &list);
-	return list;
+	return SourceListFilterModel::MediaSources()->Names();
 }
 
 QStringList GetVideoSourceNames()
 {
-	auto sourceEnum = [](void *param, obs_source_t *source) -> bool /* -- */
-	{
-		QStringList *list = reinterpret_cast<QStringList *>(param);
-		uint32_t flags = obs_source_get_output_flags(source);
-		std::string test = obs_source_get_name(source);
-		if ((flags & (OBS_SOURCE_VIDEO | OBS_SOURCE_ASYNC)) != 0) {
-			*list << obs_source_get_name(source);
-		}
-		return true;
-	};
-
-	QStringList list;
-	obs_enum_sources(sourceEnum, &list);
-	return list;
+	return SourceListFilterModel::VideoSources()->Names();
 }
 
 QStringList GetSceneNames()
 {
-	QStringList list;
-	char **scenes = obs_frontend_get_scene_names();
-	char **temp = scenes;
-	while (*temp) {
-		const char *name = *temp;
-		list << name;
-		temp++;
-	}
-	bfree(scenes);
-	return list;
+	return SourceListFilterModel::Scenes()->Names();
 }
 
 QStringList GetSourceNames()
 {
-	auto sourceEnum = [](void *param, obs_source_t *source) -> bool /* -- */
-	{
-		QStringList *list = reinterpret_cast<QStringList *>(param);
-		*list << obs_source_get_name(source);
-		return true;
-	};
-
-	QStringList list;
-	obs_enum_sources(sourceEnum, &list);
-	return list;
+	return SourceListFilterModel::Sources()->Names();
 }
 
 void PopulateTransitionSelection(QComboBox *sel, bool addCurrent, bool addAny,
@@ -10,6 +10,8 @@ namespace advss {
 
 struct SceneGroup;
 
+// The source and scene name lists are backed by the shared source list models
+// and thus must only be queried from the main thread
 EXPORT QStringList GetAudioSourceNames();
 EXPORT QStringList GetSourcesWithFilterNames();
 EXPORT QStringList GetMediaSourceNames();
@@ -0,0 +1,349 @@
+#include "source-list-model.hpp"
+#include "plugin-state-helpers.hpp"
+
+#include <algorithm>
+#include <QPointer>
+
+namespace advss {
+
+static QPointer<SourceListModel> inputsModel;
+static QPointer<SourceListModel> scenesModel;
+
+static bool setup()
+{
+	AddPluginCleanupStep([]() {
+		delete inputsModel;
+		delete scenesModel;
+	});
+	return true;
+}
+static bool setupDone = setup();
+
+SourceListModel *SourceListModel::Get(Type type)
+{
+	auto &model = type == Type::INPUTS ? inputsModel : scenesModel;
+	if (!model) {
+		model = new SourceListModel(type);
+	}
+	return model;
+}
+
+SourceListModel::SourceListModel(Type type) : _type(type)
+{
+	// Connect to the signals first so no source created while building the
+	// initial list is missed
+	auto sh = obs_get_signal_handler();
+	signal_handler_connect(sh, "source_create", SourceCreated, this);
+	signal_handler_connect(sh, "source_destroy", SourceDestroyed, this);
+	signal_handler_connect(sh, "source_remove", SourceDestroyed, this);
+	signal_handler_connect(sh, "source_rename", SourceRenamed, this);
+	obs_frontend_add_event_callback(FrontendEvent, this);
+	Rebuild();
+}
+
+SourceListModel::~SourceListModel()
+{
+	auto sh = obs_get_signal_handler();
+	signal_handler_disconnect(sh, "source_create", SourceCreated, this);
+	signal_handler_disconnect(sh, "source_destroy", SourceDestroyed, this);
+	signal_handler_disconnect(sh, "source_remove", SourceDestroyed, this);
+	signal_handler_disconnect(sh, "source_rename", SourceRenamed, this);
+	obs_frontend_remove_event_callback(FrontendEvent, this);
+}
+
+int SourceListModel::rowCount(const QModelIndex &parent) const
+{
+	if (parent.isValid()) {
+		return 0;
+	}
+	return (int)_entries.size();
+}
+
+QVariant SourceListModel::data(const QModelIndex &index, int role) const
+{
+	if (!index.isValid() || index.row() >= (int)_entries.size()) {
+		return {};
+	}
+
+	const auto &entry = _entries[index.row()];
+	switch (role) {
+	case Qt::DisplayRole:
+	case Qt::EditRole:
+		return entry.name;
+	case IdRole:
+		return entry.id;
+	case FlagsRole:
+		return entry.flags;
+	default:
+		break;
+	}
+	return {};
+}
+
+bool SourceListModel::Accepts(obs_source_t *source) const
+{
+	if (!source) {
+		return false;
+	}
+	if (_type == Type::SCENES) {
+		return obs_source_is_scene(source);
+	}
+	// Matches what obs_enum_sources() lists in Rebuild()
+	return obs_source_get_type(source) == OBS_SOURCE_TYPE_INPUT ||
+	       obs_source_is_group(source);
+}
+
+static OBSWeakSource getWeakSource(obs_source_t *source)
+{
+	OBSWeakSourceAutoRelease weakSource = obs_source_get_weak_source(source);
+	return OBSWeakSource(weakSource.Get());
+}
+
+// The OBS signals can be emitted from any thread, so the model is only
+// modified once the change was forwarded to the main thread
+
+void SourceListModel::SourceCreated(void *param, calldata_t *data)
+{
+	auto model = static_cast<SourceListModel *>(param);
+	auto source = (obs_source_t *)calldata_ptr(data, "source");
+	if (!model->Accepts(source)) {
+		return;
+	}
+	Entry entry{obs_source_get_name(source),
+		    obs_source_get_unversioned_id(source),
+		    obs_source_get_output_flags(source), getWeakSource(source)};
+	QMetaObject::invokeMethod(
+		model, [model, entry]() { model->Add(entry); },
+		Qt::QueuedConnection);
+}
+
+void SourceListModel::SourceDestroyed(void *param, calldata_t *data)
+{
+	auto model = static_cast<SourceListModel *>(param);
+	auto source = (obs_source_t *)calldata_ptr(data, "source");
+	if (!model->Accepts(source)) {
+		return;
+	}
+	const auto weakSource = getWeakSource(source);
+	QMetaObject::invokeMethod(
+		model, [model, weakSource]() { model->Remove(weakSource); },
+		Qt::QueuedConnection);
+}
+
+void SourceListModel::SourceRenamed(void *param, calldata_t *data)
+{
+	auto model = static_cast<SourceListModel *>(param);
+	auto source = (obs_source_t *)calldata_ptr(data, "source");
+	if (!model->Accepts(source)) {
+		return;
+	}
+	const auto weakSource = getWeakSource(source);
+	const QString newName = calldata_string(data, "new_name");
+	QMetaObject::invokeMethod(
+		model,
+		[model, weakSource, newName]() {
+			model->Rename(weakSource, newName);
+		},
+		Qt::QueuedConnection);
+}
+
+void SourceListModel::FrontendEvent(enum obs_frontend_event event, void *param)
+{
+	auto model = static_cast<SourceListModel *>(param);
+	if (model->_type != Type::SCENES) {
+		return;
+	}
+
+	// Only needed to pick up changes to the order of scenes
+	if (event == OBS_FRONTEND_EVENT_SCENE_LIST_CHANGED ||
+	    event == OBS_FRONTEND_EVENT_SCENE_COLLECTION_CHANGED) {
+		model->Rebuild();
+	}
+}
+
+void SourceListModel::Rebuild()
+{
+	beginResetModel();
+	_entries.clear();
+	const auto addEntry = [](void *param, obs_source_t *source) {
+		auto entries = static_cast<std::vector<Entry> *>(param);
+		entries->push_back({obs_source_get_name(source),
+				    obs_source_get_unversioned_id(source),
+				    obs_source_get_output_flags(source),
+				    getWeakSource(source)});
+		return true;
+	};
+
+	if (_type == Type::SCENES) {
+		obs_frontend_source_list scenes = {};
+		obs_frontend_get_scenes(&scenes);
+		for (size_t i = 0; i < scenes.sources.num; i++) {
+			addEntry(&_entries, scenes.sources.array[i]);
+		}
+		obs_frontend_source_list_free(&scenes);
+	} else {
+		obs_enum_sources(addEntry, &_entries);
+		std::sort(_entries.begin(), _entries.end(),
+			  [](const Entry &a, const Entry &b) {
+				  return a.name < b.name;
+			  });
+	}
+	endResetModel();
+}
+
+void SourceListModel::Add(const Entry &entry)
+{
+	if (Find(entry.source) != -1) {
+		return;
+	}
+	const int row = InsertPosition(entry.name);
+	beginInsertRows(QModelIndex(), row, row);
+	_entries.insert(_entries.begin() + row, entry);
+	endInsertRows();
+}
+
+void SourceListModel::Remove(const OBSWeakSource &source)
+{
+	const int row = Find(source);
+	if (row == -1) {
+		return;
+	}
+	beginRemoveRows(QModelIndex(), row, row);
+	_entries.erase(_entries.begin() + row);
+	endRemoveRows();
+}
+
+void SourceListModel::Rename(const OBSWeakSource &source,
+			     const QString &newName)
+{
+	const int row = Find(source);
+	if (row == -1) {
+		return;
+	}
+
+	if (_type == Type::SCENES) {
+		_entries[row].name = newName;
+		const auto idx = index(row);
+		emit dataChanged(idx, idx, {Qt::DisplayRole, Qt::EditRole});
+		return;
+	}
+
+	// Keep the list sorted
+	auto entry = _entries[row];
+	entry.name = newName;
+	Remove(source);
+	Add(entry);
+}
+
+int SourceListModel::Find(const OBSWeakSource &source) const
+{
+	auto it = std::find_if(_entries.begin(), _entries.end(),
+			       [&source](const Entry &e) {
+				       return e.source == source;
+			       });
+	if (it == _entries.end()) {
+		return -1;
+	}
+	return (int)(it - _entries.begin());
+}
+
+int SourceListModel::InsertPosition(const QString &name) const
+{
+	if (_type == Type::SCENES) {
+		return (int)_entries.size();
+	}
+	auto it = std::lower_bound(_entries.begin(), _entries.end(), name,
+				   [](const Entry &e, const QString &name) {
+					   return e.name < name;
+				   });
+	return (int)(it - _entries.begin());
+}
+
+SourceListFilterModel::SourceListFilterModel(SourceListModel *model,
+					     const Filter &filter,
+					     QObject *parent)
+	: QSortFilterProxyModel(parent ? parent : model),
+	  _filter(filter)
+{
+	setSourceModel(model);
+	setDynamicSortFilter(true);
+}
+
+QStringList SourceListFilterModel::Names() const
+{
+	QStringList names;
+	const int count = rowCount();
+	names.reserve(count);
+	for (int i = 0; i < count; i++) {
+		names << data(index(i, 0)).toString();
+	}
+	return names;
+}
+
+bool SourceListFilterModel::filterAcceptsRow(
+	int sourceRow, const QModelIndex &sourceParent) const
+{
+	if (!_filter) {
+		return true;
+	}
+	const auto idx = sourceModel()->index(sourceRow, 0, sourceParent);
+	return _filter(idx.data(SourceListModel::IdRole).toString(),
+		       idx.data(SourceListModel::FlagsRole).toUInt());
+}
+
+static SourceListFilterModel *
+getSharedFilterModel(QPointer<SourceListFilterModel> &model,
+		     SourceListModel::Type type,
+		     const SourceListFilterModel::Filter &filter = {})
+{
+	if (!model) {
+		model = new SourceListFilterModel(SourceListModel::Get(type),
+						  filter);
+	}
+	return model;
+}
+
+SourceListFilterModel *SourceListFilterModel::Sources()
+{
+	static QPointer<SourceListFilterModel> model;
+	return getSharedFilterModel(model, SourceListModel::Type::INPUTS);
+}
+
+SourceListFilterModel *SourceListFilterModel::AudioSources()
+{
+	static QPointer<SourceListFilterModel> model;
+	return getSharedFilterModel(
+		model, SourceListModel::Type::INPUTS,
+		[](const QString &, uint32_t flags) {
+			return (flags & OBS_SOURCE_AUDIO) != 0;
+		});
+}
+
+SourceListFilterModel *SourceListFilterModel::VideoSources()
+{
+	static QPointer<SourceListFilterModel> model;
+	return getSharedFilterModel(
+		model, SourceListModel::Type::INPUTS,
+		[](const QString &, uint32_t flags) {
+			return (flags & (OBS_SOURCE_VIDEO | OBS_SOURCE_ASYNC)) !=
+			       0;
+		});
+}
+
+SourceListFilterModel *SourceListFilterModel::MediaSources()
+{
+	static QPointer<SourceListFilterModel> model;
+	return getSharedFilterModel(
+		model, SourceListModel::Type::INPUTS,
+		[](const QString &, uint32_t flags) {
+			return (flags & OBS_SOURCE_CONTROLLABLE_MEDIA) != 0;
+		});
+}
+
+SourceListFilterModel *SourceListFilterModel::Scenes()
+{
+	static QPointer<SourceListFilterModel> model;
+	return getSharedFilterModel(model, SourceListModel::Type::SCENES);
+}
+
+} // namespace advss
@@ -0,0 +1,96 @@
+#pragma once
+#include "export-symbol-helper.hpp"
+
+#include <functional>
+#include <obs-frontend-api.h>
+#include <obs.hpp>
+#include <QAbstractListModel>
+#include <QSortFilterProxyModel>
+#include <QStringList>
+#include <vector>
+
+namespace advss {
+
+// List of all OBS sources of a given type shared by all selection widgets.
+// Instead of enumerating all sources whenever a selection widget is created,
+// the list is built once and then updated incrementally based on the OBS
+// source create, destroy, and rename signals.
+//
+// Must only be accessed from the main thread.
+class SourceListModel : public QAbstractListModel {
+	Q_OBJECT
+
+public:
+	enum class Type {
+		INPUTS, // Sorted by name
+		SCENES, // Same order as in the OBS scene list
+	};
+
+	enum Role {
+		IdRole = Qt::UserRole,
+		FlagsRole,
+	};
+
+	EXPORT static SourceListModel *Get(Type);
+	~SourceListModel();
+
+	int rowCount(const QModelIndex &parent = QModelIndex()) const override;
+	QVariant data(const QModelIndex &index,
+		      int role = Qt::DisplayRole) const override;
+
+private:
+	struct Entry {
+		QString name;
+		QString id;
+		uint32_t flags = 0;
+		// Identifies the source, as a new source with the same name
+		// might be created before the old one is destroyed
+		OBSWeakSource source;
+	};
+
+	SourceListModel(Type);
+
+	static void SourceCreated(void *, calldata_t *);
+	static void SourceDestroyed(void *, calldata_t *);
+	static void SourceRenamed(void *, calldata_t *);
+	static void FrontendEvent(enum obs_frontend_event event, void *);
+
+	bool Accepts(obs_source_t *) const;
+	void Rebuild();
+	void Add(const Entry &);
+	void Remove(const OBSWeakSource &);
+	void Rename(const OBSWeakSource &, const QString &newName);
+	int Find(const OBSWeakSource &) const;
+	int InsertPosition(const QString &name) const;
+
+	const Type _type;
+	std::vector<Entry> _entries;
+};
+
+// Filtered view on a SourceListModel, e.g. only listing audio sources.
+class SourceListFilterModel : public QSortFilterProxyModel {
+	Q_OBJECT
+
+public:
+	using Filter = std::function<bool(const QString &id, uint32_t flags)>;
+
+	SourceListFilterModel(SourceListModel *, const Filter & = {},
+			      QObject *parent = nullptr);
+	EXPORT QStringList Names() const;
+
+	// Shared instances
+	EXPORT static SourceListFilterModel *Sources();
+	EXPORT static SourceListFilterModel *AudioSources();
+	EXPORT static SourceListFilterModel *VideoSources();
+	EXPORT static SourceListFilterModel *MediaSources();
+	EXPORT static SourceListFilterModel *Scenes();
+
+protected:
+	bool filterAcceptsRow(int sourceRow,
+			      const QModelIndex &sourceParent) const override;
+
+private:
+	Filter _filter;
+};
+
+} // namespace advss
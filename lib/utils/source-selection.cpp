@@ -2,9 +2,12 @@
 #include "obs-module-helper.hpp"
 #include "selection-helpers.hpp"
 #include "source-helpers.hpp"
+#include "source-list-model.hpp"
 #include "ui-helpers.hpp"
 #include "variable.hpp"
 
+#include <QTimer>
+
 namespace advss {
 
 constexpr std::string_view typeSaveName = "type";
@@ -235,6 +238,45 @@ void SourceSelectionWidget::SetSourceNameList(const QStringList &list)
 	Reset();
 }
 
+void SourceSelectionWidget::SetSourceModel(SourceListFilterModel *model)
+{
+	if (_sourceModel) {
+		disconnect(_sourceModel, nullptr, this, nullptr);
+	}
+	_sourceModel = model;
+	if (!model) {
+		return;
+	}
+
+	connect(model, &QAbstractItemModel::rowsInserted, this,
+		&SourceSelectionWidget::SourceListChanged);
+	connect(model, &QAbstractItemModel::rowsRemoved, this,
+		&SourceSelectionWidget::SourceListChanged);
+	connect(model, &QAbstractItemModel::dataChanged, this,
+		&SourceSelectionWidget::SourceListChanged);
+	connect(model, &QAbstractItemModel::modelReset, this,
+		&SourceSelectionWidget::SourceListChanged);
+	SetSourceNameList(model->Names());
+}
+
+void SourceSelectionWidget::SourceListChanged()
+{
+	// Sources are usually added or removed in bulk, e.g. when switching
+	// scene collections, so only update the selection once
+	if (_sourceListUpdateScheduled) {
+		return;
+	}
+	_sourceListUpdateScheduled = true;
+	QTimer::singleShot(0, this, [this]() {
+		_sourceListUpdateScheduled = false;
+		if (!_sourceModel) {
+			return;
+		}
+		const QSignalBlocker b(this);
+		SetSourceNameList(_sourceModel->Names());
+	});
+}
+
 void SourceSelectionWidget::SelectionChanged(int)
 {
 	_currentSelection = CurrentSelection();
@@ -4,6 +4,7 @@
 
 namespace advss {
 
+class SourceListFilterModel;
 class Variable;
 
 class SourceSelection {
@@ -43,6 +44,8 @@ public:
 			      bool addVariables = true);
 	void SetSource(const SourceSelection &);
 	void SetSourceNameList(const QStringList &);
+	// Keeps the list of sources in sync with the given shared model
+	void SetSourceModel(SourceListFilterModel *);
 signals:
 	void SourceChanged(const SourceSelection &);
 
@@ -51,6 +54,7 @@ private slots:
 	void ItemAdd(const QString &name);
 	void ItemRemove(const QString &name);
 	void ItemRename(const QString &oldName, const QString &newName);
+	void SourceListChanged();
 
 private:
 	void Reset();
@@ -60,6 +64,8 @@ private:
 
 	bool _addVariables;
 	QStringList _sourceNames;
+	SourceListFilterModel *_sourceModel = nullptr;
+	bool _sourceListUpdateScheduled = false;
 	SourceSelection _currentSelection;
 
 	// Order of entries
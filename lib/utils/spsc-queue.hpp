@@ -0,0 +1,78 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace advss {
+
+// Bounded lock-free queue for exactly one producer and one consumer thread.
+// Neither side ever blocks or allocates, so it can be used to hand over data
+// from real-time callbacks, like the ones of MIDI drivers, to other threads.
+template<class T> class SPSCQueue {
+public:
+	explicit SPSCQueue(size_t capacity);
+
+	// Must only be called from the producer thread.
+	// Returns false if the queue is full.
+	bool Push(const T &);
+	// Must only be called from the consumer thread
+	bool Pop(T &);
+	bool Empty() const;
+	size_t Capacity() const { return _slots.size(); }
+
+private:
+	static size_t RoundUpToPowerOfTwo(size_t);
+
+	std::vector<T> _slots;
+	const size_t _mask;
+	// Kept on separate cache lines, as each is written by another thread
+	alignas(64) std::atomic<size_t> _head{0};
+	alignas(64) std::atomic<size_t> _tail{0};
+};
+
+template<class T> inline size_t SPSCQueue<T>::RoundUpToPowerOfTwo(size_t value)
+{
+	size_t result = 1;
+	while (result < value) {
+		result <<= 1;
+	}
+	return result;
+}
+
+template<class T>
+inline SPSCQueue<T>::SPSCQueue(size_t capacity)
+	: _slots(RoundUpToPowerOfTwo(std::max<size_t>(capacity, 2))),
+	  _mask(_slots.size() - 1)
+{
+}
+
+template<class T> inline bool SPSCQueue<T>::Push(const T &value)
+{
+	const auto head = _head.load(std::memory_order_relaxed);
+	if (head - _tail.load(std::memory_order_acquire) == _slots.size()) {
+		return false;
+	}
+	_slots[head & _mask] = value;
+	_head.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template<class T> inline bool SPSCQueue<T>::Pop(T &value)
+{
+	const auto tail = _tail.load(std::memory_order_relaxed);
+	if (tail == _head.load(std::memory_order_acquire)) {
+		return false;
+	}
+	value = _slots[tail & _mask];
+	_tail.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template<class T> inline bool SPSCQueue<T>::Empty() const
+{
+	return _head.load(std::memory_order_acquire) ==
+	       _tail.load(std::memory_order_acquire);
+}
+
+} // namespace advss
@@ -0,0 +1,199 @@
+#include "tick-watchdog.hpp"
+#include "log-helper.hpp"
+#include "websocket-api.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <obs.hpp>
+
+namespace advss {
+
+constexpr std::chrono::microseconds minRecordedMacroDuration(100);
+constexpr std::chrono::seconds overrunReportInterval(10);
+constexpr std::chrono::seconds statsPublishInterval(10);
+constexpr size_t maxReportedMacros = 5;
+static constexpr char statsEventName[] = "AdvancedSceneSwitcherTickStatistics";
+
+static const char *phaseNames[] = {
+	"prune", "preconditions", "check", "run", "writeStatus",
+};
+static_assert(sizeof(phaseNames) / sizeof(phaseNames[0]) ==
+		      static_cast<size_t>(TickWatchdog::Phase::COUNT),
+	      "phase names out of sync");
+
+static double toMs(TickWatchdog::Clock::duration duration)
+{
+	return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+TickWatchdog &GetTickWatchdog()
+{
+	static TickWatchdog watchdog;
+	return watchdog;
+}
+
+void TickWatchdog::StartTick()
+{
+	_phaseDurations.fill({});
+	_macroDurations.clear();
+	_tickActive = true;
+	_phaseActive = false;
+}
+
+void TickWatchdog::StartPhase(Phase phase)
+{
+	EndPhase();
+	_phase = phase;
+	_phaseStart = Clock::now();
+	_phaseActive = true;
+}
+
+void TickWatchdog::EndPhase()
+{
+	if (!_phaseActive) {
+		return;
+	}
+	_phaseDurations[static_cast<size_t>(_phase)] +=
+		Clock::now() - _phaseStart;
+	_phaseActive = false;
+}
+
+void TickWatchdog::EndTick(int budgetMs)
+{
+	if (!_tickActive) {
+		return;
+	}
+	EndPhase();
+	_tickActive = false;
+
+	Clock::duration total{};
+	for (const auto &duration : _phaseDurations) {
+		total += duration;
+	}
+
+	const bool overrun = budgetMs > 0 &&
+			     total > std::chrono::milliseconds(budgetMs);
+	_stats.Add(_phaseDurations, total, overrun);
+	if (overrun) {
+		ReportOverrun(total, budgetMs);
+	}
+	if (Clock::now() - _lastStatsPublish >= statsPublishInterval) {
+		PublishStats(budgetMs);
+	}
+}
+
+bool TickWatchdog::ShouldRecordMacro(Clock::duration duration) const
+{
+	return _tickActive && duration >= minRecordedMacroDuration;
+}
+
+void TickWatchdog::RecordMacro(const std::string &name, Phase phase,
+			       Clock::duration duration)
+{
+	if (!ShouldRecordMacro(duration)) {
+		return;
+	}
+	_macroDurations.push_back({name, phase, duration});
+}
+
+void TickWatchdog::ReportOverrun(Clock::duration total, int budgetMs)
+{
+	// Avoid flooding the log if every interval overruns
+	_overrunsSinceReport++;
+	const auto now = Clock::now();
+	if (now - _lastOverrunReport < overrunReportInterval) {
+		return;
+	}
+	_lastOverrunReport = now;
+
+	const size_t macroCount =
+		std::min(maxReportedMacros, _macroDurations.size());
+	std::partial_sort(_macroDurations.begin(),
+			  _macroDurations.begin() + macroCount,
+			  _macroDurations.end(),
+			  [](const MacroDuration &a, const MacroDuration &b) {
+				  return a.duration > b.duration;
+			  });
+	std::string macros;
+	for (size_t i = 0; i < macroCount; i++) {
+		const auto &entry = _macroDurations[i];
+		if (!macros.empty()) {
+			macros += ", ";
+		}
+		char duration[32];
+		snprintf(duration, sizeof(duration), "%.2f ms",
+			 toMs(entry.duration));
+		macros += "\"" + entry.name + "\" (" +
+			  phaseNames[static_cast<size_t>(entry.phase)] + " " +
+			  duration + ")";
+	}
+	if (macros.empty()) {
+		macros = "none";
+	}
+
+	blog(LOG_WARNING,
+	     "interval took %.2f ms which exceeds the budget of %d ms "
+	     "(%zu overruns since last report) - "
+	     "prune: %.2f ms, preconditions: %.2f ms, check: %.2f ms, "
+	     "run: %.2f ms, write status: %.2f ms - slowest macros: %s",
+	     toMs(total), budgetMs, _overrunsSinceReport,
+	     toMs(_phaseDurations[static_cast<size_t>(Phase::PRUNE)]),
+	     toMs(_phaseDurations[static_cast<size_t>(Phase::PRECONDITIONS)]),
+	     toMs(_phaseDurations[static_cast<size_t>(Phase::CHECK)]),
+	     toMs(_phaseDurations[static_cast<size_t>(Phase::RUN)]),
+	     toMs(_phaseDurations[static_cast<size_t>(Phase::WRITE_STATUS)]),
+	     macros.c_str());
+	_overrunsSinceReport = 0;
+}
+
+void TickWatchdog::PublishStats(int budgetMs)
+{
+	_lastStatsPublish = Clock::now();
+	if (_stats.ticks == 0) {
+		return;
+	}
+
+	OBSDataAutoRelease data = obs_data_create();
+	obs_data_set_int(data, "ticks", _stats.ticks);
+	obs_data_set_int(data, "overruns", _stats.overruns);
+	obs_data_set_int(data, "budgetMs", budgetMs);
+	obs_data_set_double(data, "averageMs",
+			    toMs(_stats.total) / (double)_stats.ticks);
+	obs_data_set_double(data, "maxMs", toMs(_stats.max));
+
+	OBSDataAutoRelease phases = obs_data_create();
+	for (size_t i = 0; i < static_cast<size_t>(Phase::COUNT); i++) {
+		OBSDataAutoRelease phase = obs_data_create();
+		obs_data_set_double(phase, "averageMs",
+				    toMs(_stats.phaseTotal[i]) /
+					    (double)_stats.ticks);
+		obs_data_set_double(phase, "maxMs", toMs(_stats.phaseMax[i]));
+		obs_data_set_obj(phases, phaseNames[i], phase);
+	}
+	obs_data_set_obj(data, "phases", phases);
+
+	SendWebsocketVendorEvent(statsEventName, data);
+	_stats.Reset();
+}
+
+void TickWatchdog::Stats::Reset()
+{
+	*this = {};
+}
+
+void TickWatchdog::Stats::Add(const PhaseDurations &phases,
+			      Clock::duration tickDuration, bool overrun)
+{
+	ticks++;
+	if (overrun) {
+		overruns++;
+	}
+	total += tickDuration;
+	max = std::max(max, tickDuration);
+	for (size_t i = 0; i < phases.size(); i++) {
+		phaseTotal[i] += phases[i];
+		phaseMax[i] = std::max(phaseMax[i], phases[i]);
+	}
+}
+
+} // namespace advss
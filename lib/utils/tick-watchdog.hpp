@@ -0,0 +1,79 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace advss {
+
+// Measures how long each interval of the main loop takes, split into its
+// phases, and reports intervals which exceed the configured time budget.
+//
+// Must only be used from the main loop thread.
+class TickWatchdog {
+public:
+	using Clock = std::chrono::high_resolution_clock;
+
+	enum class Phase {
+		PRUNE,
+		PRECONDITIONS,
+		CHECK,
+		RUN,
+		WRITE_STATUS,
+		COUNT,
+	};
+
+	void StartTick();
+	// Ends the currently active phase, if any, and starts the given one
+	void StartPhase(Phase);
+	// Ends the currently active phase without starting a new one, so time
+	// spent waiting is not accounted to the interval
+	void EndPhase();
+	void EndTick(int budgetMs);
+
+	void RecordMacro(const std::string &name, Phase, Clock::duration);
+	bool ShouldRecordMacro(Clock::duration) const;
+
+private:
+	using PhaseDurations =
+		std::array<Clock::duration, static_cast<size_t>(Phase::COUNT)>;
+
+	struct MacroDuration {
+		std::string name;
+		Phase phase;
+		Clock::duration duration;
+	};
+
+	struct Stats {
+		void Reset();
+		void Add(const PhaseDurations &, Clock::duration total,
+			 bool overrun);
+
+		size_t ticks = 0;
+		size_t overruns = 0;
+		Clock::duration total{};
+		Clock::duration max{};
+		PhaseDurations phaseTotal{};
+		PhaseDurations phaseMax{};
+	};
+
+	void ReportOverrun(Clock::duration total, int budgetMs);
+	void PublishStats(int budgetMs);
+
+	bool _tickActive = false;
+	bool _phaseActive = false;
+	Phase _phase = Phase::PRUNE;
+	Clock::time_point _phaseStart;
+	PhaseDurations _phaseDurations{};
+	std::vector<MacroDuration> _macroDurations;
+
+	Clock::time_point _lastOverrunReport{};
+	size_t _overrunsSinceReport = 0;
+
+	Stats _stats;
+	Clock::time_point _lastStatsPublish = Clock::now();
+};
+
+TickWatchdog &GetTickWatchdog();
+
+} // namespace advss
@@ -9,11 +9,12 @@ void StringVariable::Resolve() const
 		_resolvedValue = _value;
 		return;
 	}
-	if (_lastResolve == GetLastVariableChangeTime()) {
+	const auto version = GetVariableChangeVersion();
+	if (_lastResolveVersion == version) {
 		return;
 	}
 	_resolvedValue = SubstitueVariables(_value);
-	_lastResolve = GetLastVariableChangeTime();
+	_lastResolveVersion = version;
 }
 
 StringVariable::operator std::string() const
@@ -30,13 +31,13 @@ StringVariable::operator QVariant() const
 void StringVariable::operator=(std::string value)
 {
 	_value = value;
-	_lastResolve = {};
+	_lastResolveVersion = 0;
 }
 
 void StringVariable::operator=(const char *value)
 {
 	_value = value;
-	_lastResolve = {};
+	_lastResolveVersion = 0;
 }
 
 void StringVariable::Load(obs_data_t *obj, const char *name)
@@ -79,6 +80,9 @@ std::string SubstitueVariables(std::string str)
 	for (const auto &v : GetVariables()) {
 		const auto &variable = std::dynamic_pointer_cast<Variable>(v);
 		const std::string pattern = "${" + variable->Name() + "}";
+		if (str.find(pattern) == std::string::npos) {
+			continue;
+		}
 		if (ReplaceAll(str, pattern, variable->Value(false))) {
 			variable->UpdateLastUsed();
 		}
@@ -34,7 +34,7 @@ private:
 
 	std::string _value = "";
 	mutable std::string _resolvedValue = "";
-	mutable std::chrono::high_resolution_clock::time_point _lastResolve{};
+	mutable uint64_t _lastResolveVersion = 0;
 };
 
 std::string SubstitueVariables(std::string str);
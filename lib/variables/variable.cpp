@@ -4,24 +4,31 @@
 #include "ui-helpers.hpp"
 #include "utility.hpp"
 
+#include <cmath>
 #include <QGridLayout>
 
 namespace advss {
 
 static std::deque<std::shared_ptr<Item>> variables;
 
-// Keep track of the last time a variable was changed to save some work when
-// when resolving strings containing variables, etc.
-static std::chrono::high_resolution_clock::time_point lastVariableChange{};
+// Keep track of changes to variables to save some work when resolving strings
+// containing variables, etc.
+// Starts at 1 so 0 can be used to mark values which were never resolved.
+static std::atomic<uint64_t> variableChangeVersion{1};
+
+static void variablesChanged()
+{
+	variableChangeVersion.fetch_add(1, std::memory_order_release);
+}
 
 Variable::Variable() : Item()
 {
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	variablesChanged();
 }
 
 Variable::~Variable()
 {
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	variablesChanged();
 }
 
 void Variable::Load(obs_data_t *obj)
@@ -37,7 +44,7 @@ void Variable::Load(obs_data_t *obj)
 		SetValue(_defaultValue);
 	}
 
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	variablesChanged();
 }
 
 void Variable::Save(obs_data_t *obj) const
@@ -46,7 +53,8 @@ void Variable::Save(obs_data_t *obj) const
 	obs_data_set_int(obj, "saveAction", static_cast<int>(_saveAction));
 
 	if (_saveAction == SaveAction::SAVE) {
-		obs_data_set_string(obj, "value", _value.c_str());
+		std::lock_guard<std::mutex> lock(_mutex);
+		obs_data_set_string(obj, "value", _value.String().c_str());
 	}
 
 	obs_data_set_string(obj, "defaultValue", _defaultValue.c_str());
@@ -54,48 +62,107 @@ void Variable::Save(obs_data_t *obj) const
 
 std::string Variable::Value(bool updateLastUsed) const
 {
-	std::lock_guard<std::mutex> lock(_mutex);
 	if (updateLastUsed) {
 		UpdateLastUsed();
 	}
 
-	return _value;
+	auto value = std::atomic_load_explicit(&_publishedValue,
+					       std::memory_order_acquire);
+	if (value) {
+		return *value;
+	}
+
+	// Numeric values are only formatted once the string is requested
+	std::lock_guard<std::mutex> lock(_mutex);
+	value = std::atomic_load_explicit(&_publishedValue,
+					  std::memory_order_relaxed);
+	if (!value) {
+		value = std::make_shared<const std::string>(_value.String());
+		std::atomic_store_explicit(&_publishedValue, value,
+					   std::memory_order_release);
+	}
+	return *value;
 }
 
 std::optional<double> Variable::DoubleValue() const
 {
-	return GetDouble(Value());
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Double();
 }
 
 std::optional<int> Variable::IntValue() const
 {
-	return GetInt(Value());
+	std::lock_guard<std::mutex> lock(_mutex);
+	UpdateLastUsed();
+	return _value.Int();
+}
+
+std::string Variable::GetPreviousValue() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _previousValue.String();
 }
 
 void Variable::SetValue(const std::string &value)
 {
 	std::lock_guard<std::mutex> lock(_mutex);
 	_previousValue = _value;
-	_value = value;
+	_value.Set(value);
+	ValueChanged();
+}
+
+void Variable::SetValue(double value)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	SetNumericValue(value);
+}
+
+bool Variable::IncrementValue(double amount)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	const auto current = _value.Double();
+	if (!current) {
+		return false;
+	}
+	SetNumericValue(*current + amount);
+	return true;
+}
+
+void Variable::SetNumericValue(double value)
+{
+	_previousValue = _value;
+	_value.Set(value);
+	ValueChanged();
+}
 
+void Variable::ValueChanged()
+{
+	PublishValue();
 	UpdateLastUsed();
 	UpdateLastChanged();
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	variablesChanged();
 }
 
-void Variable::SetValue(double value)
+void Variable::PublishValue()
 {
-	SetValue(ToString(value));
+	std::shared_ptr<const std::string> value;
+	if (_value.HasString()) {
+		value = std::make_shared<const std::string>(_value.String());
+	}
+	std::atomic_store_explicit(&_publishedValue, std::move(value),
+				   std::memory_order_release);
 }
 
 std::optional<uint64_t> Variable::GetSecondsSinceLastUse() const
 {
-	if (_lastUsed.time_since_epoch().count() == 0) {
+	const auto lastUsed = _lastUsed.load(std::memory_order_relaxed);
+	if (lastUsed.time_since_epoch().count() == 0) {
 		return {};
 	}
 
 	const auto now = std::chrono::high_resolution_clock::now();
-	return std::chrono::duration_cast<std::chrono::seconds>(now - _lastUsed)
+	return std::chrono::duration_cast<std::chrono::seconds>(now - lastUsed)
 		.count();
 }
 
@@ -113,7 +180,8 @@ std::optional<uint64_t> Variable::GetSecondsSinceLastChange() const
 
 void Variable::UpdateLastUsed() const
 {
-	_lastUsed = std::chrono::high_resolution_clock::now();
+	_lastUsed.store(std::chrono::high_resolution_clock::now(),
+			std::memory_order_relaxed);
 }
 
 void Variable::UpdateLastChanged()
@@ -124,6 +192,81 @@ void Variable::UpdateLastChanged()
 	}
 }
 
+// ToString() formats integers of a lower magnitude than this exactly
+constexpr double maxExactlyFormattedValue = 1e6;
+
+static bool isExactlyFormatted(double value)
+{
+	return std::abs(value) < maxExactlyFormattedValue &&
+	       std::trunc(value) == value;
+}
+
+const std::string &Variable::CachedValue::String() const
+{
+	if (!_stringValid) {
+		_string = ToString(*_double);
+		_stringValid = true;
+	}
+	return _string;
+}
+
+std::optional<double> Variable::CachedValue::Double() const
+{
+	if (!_doubleValid) {
+		_double = GetDouble(_string);
+		_doubleValid = true;
+	}
+	return _double;
+}
+
+std::optional<int> Variable::CachedValue::Int() const
+{
+	if (!_intValid) {
+		_int = GetInt(String());
+		_intValid = true;
+	}
+	return _int;
+}
+
+void Variable::CachedValue::Set(const std::string &value)
+{
+	_string = value;
+	_stringValid = true;
+	_doubleValid = false;
+	_intValid = false;
+}
+
+void Variable::CachedValue::Set(double value)
+{
+	// Other values might be rounded when formatted, so use the string
+	// representation to make sure the value matches the one which would be
+	// read back from it
+	if (!isExactlyFormatted(value)) {
+		Set(ToString(value));
+		return;
+	}
+
+	_string.clear();
+	_stringValid = false;
+	_double = value;
+	_doubleValid = true;
+	_int = static_cast<int>(value);
+	_intValid = true;
+}
+
+bool Variable::CachedValue::HasString() const
+{
+	return _stringValid;
+}
+
+bool Variable::CachedValue::operator!=(const CachedValue &other) const
+{
+	if (!_stringValid && !other._stringValid) {
+		return *_double != *other._double;
+	}
+	return String() != other.String();
+}
+
 static void populateSaveActionSelection(QComboBox *list)
 {
 	list->addItems(
@@ -146,7 +289,7 @@ VariableSettingsDialog::VariableSettingsDialog(QWidget *parent,
 	QWidget::connect(_save, SIGNAL(currentIndexChanged(int)), this,
 			 SLOT(SaveActionChanged(int)));
 
-	_value->setPlainText(QString::fromStdString(settings._value));
+	_value->setPlainText(QString::fromStdString(settings.Value(false)));
 	_defaultValue->setPlainText(
 		QString::fromStdString(settings._defaultValue));
 	populateSaveActionSelection(_save);
@@ -206,7 +349,7 @@ bool VariableSettingsDialog::AskForSettings(QWidget *parent, Variable &settings)
 		dialog._defaultValue->toPlainText().toStdString();
 	settings._saveAction =
 		static_cast<Variable::SaveAction>(dialog._save->currentIndex());
-	lastVariableChange = std::chrono::high_resolution_clock::now();
+	variablesChanged();
 
 	return true;
 }
@@ -459,9 +602,9 @@ void ImportVariables(obs_data_t *data)
 	QeueUITask(signalImportedVariables, importedVars);
 }
 
-std::chrono::high_resolution_clock::time_point GetLastVariableChangeTime()
+uint64_t GetVariableChangeVersion()
 {
-	return lastVariableChange;
+	return variableChangeVersion.load(std::memory_order_acquire);
 }
 
 } // namespace advss
@@ -3,6 +3,9 @@
 #include "item-selection-helpers.hpp"
 #include "resizing-text-edit.hpp"
 
+#include <atomic>
+#include <chrono>
+#include <memory>
 #include <mutex>
 #include <obs-data.h>
 #include <optional>
@@ -34,10 +37,13 @@ public:
 	EXPORT std::string Value(bool updateLastUsed = true) const;
 	EXPORT std::optional<double> DoubleValue() const;
 	EXPORT std::optional<int> IntValue() const;
-	std::string GetPreviousValue() const { return _previousValue; };
+	std::string GetPreviousValue() const;
 	std::string GetDefaultValue() const { return _defaultValue; }
 	EXPORT void SetValue(const std::string &value);
 	void SetValue(double value);
+	// Adds the given amount to the current value as a single operation.
+	// Returns false if the current value is not numeric.
+	EXPORT bool IncrementValue(double amount);
 	SaveAction GetSaveAction() const { return _saveAction; }
 	int GetValueChangeCount() const { return _valueChangeCount; }
 	std::optional<uint64_t> GetSecondsSinceLastUse() const;
@@ -46,14 +52,47 @@ public:
 	void UpdateLastChanged();
 
 private:
+	// Holds the value as a string and caches its numeric representation.
+	// Numeric values which can be formatted exactly are stored as numbers
+	// and only formatted once the string is requested, so repeatedly
+	// modifying numeric values does not require any string conversions.
+	class CachedValue {
+	public:
+		const std::string &String() const;
+		bool HasString() const;
+		std::optional<double> Double() const;
+		std::optional<int> Int() const;
+		void Set(const std::string &);
+		void Set(double);
+		bool operator!=(const CachedValue &) const;
+
+	private:
+		mutable std::string _string = "";
+		mutable bool _stringValid = true;
+		mutable std::optional<double> _double;
+		mutable bool _doubleValid = false;
+		mutable std::optional<int> _int;
+		mutable bool _intValid = false;
+	};
+
+	void SetNumericValue(double value);
+	void ValueChanged();
+	void PublishValue();
+
 	SaveAction _saveAction = SaveAction::DONT_SAVE;
-	std::string _value = "";
-	std::string _previousValue = "";
+	CachedValue _value;
+	CachedValue _previousValue;
 	std::string _defaultValue = "";
 	int _valueChangeCount = 0;
-	mutable std::chrono::high_resolution_clock::time_point _lastUsed;
+	mutable std::atomic<std::chrono::high_resolution_clock::time_point>
+		_lastUsed{std::chrono::high_resolution_clock::time_point{}};
 	mutable std::chrono::high_resolution_clock::time_point _lastChanged;
+	// Serializes modifications of the value
 	mutable std::mutex _mutex;
+	// Copy of the string value, which is replaced as a whole whenever the
+	// value changes, so it can be read without locking the mutex.
+	// Empty if the value was not yet formatted as a string.
+	mutable std::shared_ptr<const std::string> _publishedValue;
 
 	friend VariableSelection;
 	friend VariableSettingsDialog;
@@ -119,6 +158,7 @@ void SaveVariables(obs_data_t *obj);
 void LoadVariables(obs_data_t *obj);
 void ImportVariables(obs_data_t *obj);
 
-std::chrono::high_resolution_clock::time_point GetLastVariableChangeTime();
+// Incremented whenever any variable is modified, added, or removed
+uint64_t GetVariableChangeVersion();
 
 } // namespace advss
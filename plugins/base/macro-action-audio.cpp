@@ -3,6 +3,7 @@
 #include "layout-helpers.hpp"
 #include "macro-helpers.hpp"
 #include "selection-helpers.hpp"
+#include "source-list-model.hpp"
 
 #include <chrono>
 
@@ -468,9 +469,7 @@ MacroActionAudioEdit::MacroActionAudioEdit(
 	_rate->setSuffix("%");
 
 	populateActionSelection(_actions);
-	auto sources = GetAudioSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::AudioSources());
 	populateFadeTypeSelection(_fadeTypes);
 	PopulateMonitorTypeSelection(_monitorTypes);
 
@@ -1,10 +1,7 @@
 #include "macro-action-file.hpp"
+#include "file-writer.hpp"
 #include "layout-helpers.hpp"
 
-#include <QFileDialog>
-#include <QFile>
-#include <QTextStream>
-
 namespace advss {
 
 const std::string MacroActionFile::id = "file";
@@ -23,23 +20,19 @@ static const std::map<MacroActionFile::Action, std::string> actionTypes = {
 
 bool MacroActionFile::PerformAction()
 {
-	QString path = QString::fromStdString(_file);
-	QFile file(path);
-	bool open = false;
+	// The file is written in the background to not block the macro on
+	// slow storage
+	auto &writer = GetFileWriter();
 	switch (_action) {
 	case Action::WRITE:
-		open = file.open(QIODevice::WriteOnly);
+		writer.Write(_file, _text, _atomicWrite);
 		break;
 	case Action::APPEND:
-		open = file.open(QIODevice::WriteOnly | QIODevice::Append);
+		writer.Append(_file, _text);
 		break;
 	default:
 		break;
 	}
-	if (open) {
-		QTextStream out(&file);
-		out << QString::fromStdString(_text);
-	}
 	return true;
 }
 
@@ -61,6 +54,7 @@ bool MacroActionFile::Save(obs_data_t *obj) const
 	_file.Save(obj, "file");
 	_text.Save(obj, "text");
 	obs_data_set_int(obj, "action", static_cast<int>(_action));
+	obs_data_set_bool(obj, "atomicWrite", _atomicWrite);
 	return true;
 }
 
@@ -70,6 +64,7 @@ bool MacroActionFile::Load(obs_data_t *obj)
 	_file.Load(obj, "file");
 	_text.Load(obj, "text");
 	_action = static_cast<Action>(obs_data_get_int(obj, "action"));
+	_atomicWrite = obs_data_get_bool(obj, "atomicWrite");
 	return true;
 }
 
@@ -106,7 +101,9 @@ MacroActionFileEdit::MacroActionFileEdit(
 	: QWidget(parent),
 	  _filePath(new FileSelection(FileSelection::Type::WRITE)),
 	  _text(new VariableTextEdit(this)),
-	  _actions(new QComboBox())
+	  _actions(new QComboBox()),
+	  _atomicWrite(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.action.file.atomicWrite")))
 {
 	populateActionSelection(_actions);
 
@@ -116,7 +113,8 @@ MacroActionFileEdit::MacroActionFileEdit(
 			 SLOT(PathChanged(const QString &)));
 	QWidget::connect(_text, SIGNAL(textChanged()), this,
 			 SLOT(TextChanged()));
-	;
+	QWidget::connect(_atomicWrite, SIGNAL(stateChanged(int)), this,
+			 SLOT(AtomicWriteChanged(int)));
 
 	QHBoxLayout *entryLayout = new QHBoxLayout;
 	std::unordered_map<std::string, QWidget *> widgetPlaceholders = {
@@ -130,6 +128,7 @@ MacroActionFileEdit::MacroActionFileEdit(
 	QVBoxLayout *mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(entryLayout);
 	mainLayout->addWidget(_text);
+	mainLayout->addWidget(_atomicWrite);
 	setLayout(mainLayout);
 
 	_entryData = entryData;
@@ -146,6 +145,9 @@ void MacroActionFileEdit::UpdateEntryData()
 	_actions->setCurrentIndex(static_cast<int>(_entryData->_action));
 	_filePath->SetPath(QString::fromStdString(_entryData->_file));
 	_text->setPlainText(_entryData->_text);
+	_atomicWrite->setChecked(_entryData->_atomicWrite);
+	_atomicWrite->setVisible(_entryData->_action ==
+				 MacroActionFile::Action::WRITE);
 
 	adjustSize();
 	updateGeometry();
@@ -184,6 +186,20 @@ void MacroActionFileEdit::ActionChanged(int value)
 
 	auto lock = LockContext();
 	_entryData->_action = static_cast<MacroActionFile::Action>(value);
+	_atomicWrite->setVisible(_entryData->_action ==
+				 MacroActionFile::Action::WRITE);
+	adjustSize();
+	updateGeometry();
+}
+
+void MacroActionFileEdit::AtomicWriteChanged(int value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_atomicWrite = value;
 }
 
 } // namespace advss
@@ -3,6 +3,8 @@
 #include "file-selection.hpp"
 #include "variable-text-edit.hpp"
 
+#include <QCheckBox>
+
 namespace advss {
 
 class MacroActionFile : public MacroAction {
@@ -26,6 +28,9 @@ public:
 		APPEND,
 	};
 	Action _action = Action::WRITE;
+	// Replace the file via a temporary file, so readers never observe
+	// partially written content
+	bool _atomicWrite = false;
 
 private:
 	static bool _registered;
@@ -52,6 +57,7 @@ private slots:
 	void PathChanged(const QString &text);
 	void TextChanged();
 	void ActionChanged(int value);
+	void AtomicWriteChanged(int value);
 signals:
 	void HeaderInfoChanged(const QString &);
 
@@ -59,6 +65,7 @@ private:
 	FileSelection *_filePath;
 	VariableTextEdit *_text;
 	QComboBox *_actions;
+	QCheckBox *_atomicWrite;
 
 	std::shared_ptr<MacroActionFile> _entryData;
 	bool _loading = true;
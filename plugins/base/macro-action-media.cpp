@@ -2,6 +2,7 @@
 #include "layout-helpers.hpp"
 #include "selection-helpers.hpp"
 #include "macro-helpers.hpp"
+#include "source-list-model.hpp"
 
 namespace advss {
 
@@ -235,9 +236,7 @@ MacroActionMediaEdit::MacroActionMediaEdit(
 {
 	populateActionSelection(_actions);
 	populateSelectionTypeSelection(_selectionTypes);
-	auto sources = GetMediaSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::MediaSources());
 
 	QWidget::connect(_actions, SIGNAL(currentIndexChanged(int)), this,
 			 SLOT(ActionChanged(int)));
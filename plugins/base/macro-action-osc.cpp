@@ -1,8 +1,8 @@
 #include "macro-action-osc.hpp"
+#include "osc-transport.hpp"
 
 #include <obs.hpp>
 #include <QGroupBox>
-#include <system_error>
 
 namespace advss {
 
@@ -12,102 +12,7 @@ bool MacroActionOSC::_registered = MacroActionFactory::Register(
 	MacroActionOSC::id, {MacroActionOSC::Create, MacroActionOSCEdit::Create,
 			     "AdvSceneSwitcher.action.osc"});
 
-MacroActionOSC::MacroActionOSC(Macro *m)
-	: MacroAction(m),
-	  _ctx(asio::io_context()),
-	  _tcpSocket(asio::ip::tcp::socket(_ctx)),
-	  _udpSocket(asio::ip::udp::socket(_ctx))
-{
-}
-
-void MacroActionOSC::SendOSCTCPMessage(const asio::mutable_buffer &buffer)
-{
-	try {
-		asio::write(_tcpSocket, asio::buffer(buffer));
-	} catch (const std::exception &e) {
-		blog(LOG_WARNING,
-		     "failed to send OSC message \"%s\" via TCP %s %d: %s",
-		     _message.ToString().c_str(), _ip.c_str(), _port.GetValue(),
-		     e.what());
-	}
-}
-
-void MacroActionOSC::SendOSCUDPMessage(const asio::mutable_buffer &buffer)
-{
-	try {
-		_udpSocket.send_to(buffer, _updEndpoint);
-	} catch (const std::exception &e) {
-		blog(LOG_WARNING,
-		     "failed to send OSC message \"%s\" via UDP %s %d: %s",
-		     _message.ToString().c_str(), _ip.c_str(), _port.GetValue(),
-		     e.what());
-	}
-}
-
-void MacroActionOSC::UDPReconnect()
-{
-	asio::error_code ec;
-	asio::ip::udp::resolver resolver(_ctx);
-	auto endpoints = resolver.resolve(asio::ip::udp::v4(), _ip.c_str(),
-					  std::to_string(_port.GetValue()), ec);
-	if (ec) {
-		endpoints = resolver.resolve(asio::ip::udp::v6(), _ip.c_str(),
-					     std::to_string(_port.GetValue()),
-					     ec);
-	}
-	if (ec) {
-		blog(LOG_WARNING, "failed to get IP for \"%s\": %s",
-		     _ip.c_str(), ec.message().c_str());
-		return;
-	}
-
-	try {
-		_updEndpoint = endpoints.begin()->endpoint();
-		_udpSocket = asio::ip::udp::socket(_ctx);
-		_udpSocket.open(endpoints.begin()->endpoint().protocol());
-	} catch (const std::exception &e) {
-		blog(LOG_WARNING, "failed to connect to UDP %s %d: %s",
-		     _ip.c_str(), _port.GetValue(), e.what());
-	}
-}
-
-void MacroActionOSC::TCPReconnect()
-{
-	asio::error_code ec;
-	asio::ip::tcp::resolver resolver(_ctx);
-	auto endpoints = resolver.resolve(asio::ip::tcp::v4(), _ip.c_str(),
-					  std::to_string(_port.GetValue()), ec);
-	if (ec) {
-		endpoints = resolver.resolve(asio::ip::tcp::v6(), _ip.c_str(),
-					     std::to_string(_port.GetValue()),
-					     ec);
-	}
-	if (ec) {
-		blog(LOG_WARNING, "failed to get IP for \"%s\": %s",
-		     _ip.c_str(), ec.message().c_str());
-		return;
-	}
-	try {
-		_tcpSocket = asio::ip::tcp::socket(_ctx);
-		_tcpSocket.connect(endpoints.begin()->endpoint());
-	} catch (const std::exception &e) {
-		blog(LOG_WARNING, "failed to connect to TCP %s %d: %s",
-		     _ip.c_str(), _port.GetValue(), e.what());
-	}
-}
-
-void MacroActionOSC::CheckReconnect()
-{
-	if (_protocol == Protocol::TCP &&
-	    (_reconnect || !_tcpSocket.is_open())) {
-		TCPReconnect();
-	}
-
-	if (_protocol == Protocol::UDP &&
-	    (_reconnect || !_udpSocket.is_open())) {
-		UDPReconnect();
-	}
-}
+MacroActionOSC::MacroActionOSC(Macro *m) : MacroAction(m) {}
 
 bool MacroActionOSC::PerformAction()
 {
@@ -117,31 +22,11 @@ bool MacroActionOSC::PerformAction()
 		return true;
 	}
 
-	CheckReconnect();
-
-	if (_protocol == Protocol::TCP &&
-	    (_reconnect || !_tcpSocket.is_open())) {
-		TCPReconnect();
-	}
-
-	if (_protocol == Protocol::UDP &&
-	    (_reconnect || !_udpSocket.is_open())) {
-		UDPReconnect();
-	}
-
-	auto rawMessage = asio::buffer(*buffer);
-
-	switch (_protocol) {
-	case MacroActionOSC::Protocol::TCP:
-		SendOSCTCPMessage(rawMessage);
-		break;
-	case MacroActionOSC::Protocol::UDP:
-		SendOSCUDPMessage(rawMessage);
-		break;
-	default:
-		break;
-	}
-
+	// Sending is handled asynchronously by the shared OSC network thread,
+	// which keeps the connection to each destination open
+	SendOSCMessage(_protocol == Protocol::TCP ? OSCProtocol::TCP
+						  : OSCProtocol::UDP,
+		       _ip, _port, std::move(*buffer));
 	return true;
 }
 
@@ -191,19 +76,16 @@ std::shared_ptr<MacroAction> MacroActionOSC::Copy() const
 void MacroActionOSC::SetProtocol(Protocol p)
 {
 	_protocol = p;
-	_reconnect = true;
 }
 
 void MacroActionOSC::SetIP(const std::string &ip)
 {
 	_ip = ip;
-	_reconnect = true;
 }
 
 void MacroActionOSC::SetPortNr(IntVariable port)
 {
 	_port = port;
-	_reconnect = true;
 }
 
 void MacroActionOSC::ResolveVariablesToFixedValues()
@@ -3,7 +3,6 @@
 #include "osc-helpers.hpp"
 
 #include <memory>
-#include <asio.hpp>
 
 namespace advss {
 
@@ -34,22 +33,9 @@ public:
 	OSCMessage _message;
 
 private:
-	void SendOSCTCPMessage(const asio::mutable_buffer &);
-	void SendOSCUDPMessage(const asio::mutable_buffer &);
-
-	void CheckReconnect();
-	void TCPReconnect();
-	void UDPReconnect();
-
 	Protocol _protocol = Protocol::UDP;
 	StringVariable _ip = "localhost";
 	IntVariable _port = 12345;
-	bool _reconnect = true;
-
-	asio::io_context _ctx;
-	asio::ip::tcp::socket _tcpSocket;
-	asio::ip::udp::socket _udpSocket;
-	asio::ip::udp::endpoint _updEndpoint;
 
 	static bool _registered;
 	static const std::string id;
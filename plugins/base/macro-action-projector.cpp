@@ -3,6 +3,7 @@
 #include "monitor-helpers.hpp"
 #include "selection-helpers.hpp"
 #include "source-helpers.hpp"
+#include "source-list-model.hpp"
 
 #include <obs-frontend-api.h>
 
@@ -194,9 +195,7 @@ MacroActionProjectorEdit::MacroActionProjectorEdit(
 {
 	populateWindowTypes(_windowTypes);
 	populateSelectionTypes(_types);
-	auto sources = GetSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::Sources());
 	_monitors->addItems(GetMonitorNames());
 	_monitors->setPlaceholderText(
 		obs_module_text("AdvSceneSwitcher.selectDisplay"));
@@ -1,6 +1,7 @@
 #include "macro-action-screenshot.hpp"
 #include "layout-helpers.hpp"
 #include "selection-helpers.hpp"
+#include "source-list-model.hpp"
 
 #include <obs-frontend-api.h>
 #include <QBuffer>
@@ -206,9 +207,7 @@ MacroActionScreenshotEdit::MacroActionScreenshotEdit(
 {
 	setToolTip(obs_module_text(
 		"AdvSceneSwitcher.action.screenshot.blackscreenNote"));
-	auto sources = GetVideoSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::VideoSources());
 
 	populateSaveTypeSelection(_saveType);
 	populateTargetTypeSelection(_targetType);
@@ -2,6 +2,7 @@
 #include "layout-helpers.hpp"
 #include "json-helpers.hpp"
 #include "selection-helpers.hpp"
+#include "source-list-model.hpp"
 #include "source-settings-helpers.hpp"
 
 #include <obs-frontend-api.h>
@@ -312,9 +313,7 @@ MacroActionSourceEdit::MacroActionSourceEdit(
 		  obs_module_text("AdvSceneSwitcher.action.source.refresh")))
 {
 	populateActionSelection(_actions);
-	auto sources = GetSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::Sources());
 	populateDeinterlaceModeSelection(_deinterlaceMode);
 	populateDeinterlaceFieldOrderSelection(_deinterlaceOrder);
 	populateSettingsInputMethods(_settingsInputMethods);
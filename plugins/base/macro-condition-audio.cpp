@@ -2,7 +2,11 @@
 #include "audio-helpers.hpp"
 #include "layout-helpers.hpp"
 #include "macro-helpers.hpp"
+#include "plugin-state-helpers.hpp"
 #include "selection-helpers.hpp"
+#include "source-list-model.hpp"
+
+#include <algorithm>
 
 namespace advss {
 
@@ -25,6 +29,10 @@ const static std::map<MacroConditionAudio::Type, std::string> checkTypes = {
 	 "AdvSceneSwitcher.condition.audio.type.monitor"},
 	{MacroConditionAudio::Type::BALANCE,
 	 "AdvSceneSwitcher.condition.audio.type.balance"},
+	{MacroConditionAudio::Type::LOUDNESS,
+	 "AdvSceneSwitcher.condition.audio.type.loudness"},
+	{MacroConditionAudio::Type::VOICE_ACTIVITY,
+	 "AdvSceneSwitcher.condition.audio.type.voiceActivity"},
 };
 
 const static std::map<MacroConditionAudio::OutputCondition, std::string>
@@ -35,6 +43,26 @@ const static std::map<MacroConditionAudio::OutputCondition, std::string>
 		 "AdvSceneSwitcher.condition.audio.state.below"},
 };
 
+const static std::map<MacroConditionAudio::OutputStatistic, std::string>
+	outputStatistics = {
+		{MacroConditionAudio::OutputStatistic::PEAK_SINCE_LAST_CHECK,
+		 "AdvSceneSwitcher.condition.audio.statistic.peakSinceLastCheck"},
+		{MacroConditionAudio::OutputStatistic::MAX_PEAK,
+		 "AdvSceneSwitcher.condition.audio.statistic.maxPeak"},
+		{MacroConditionAudio::OutputStatistic::AVERAGE,
+		 "AdvSceneSwitcher.condition.audio.statistic.average"},
+		{MacroConditionAudio::OutputStatistic::PEAK_PERCENTILE,
+		 "AdvSceneSwitcher.condition.audio.statistic.peakPercentile"},
+};
+
+const static std::map<MacroConditionAudio::VoiceCondition, std::string>
+	voiceConditionTypes = {
+		{MacroConditionAudio::VoiceCondition::DETECTED,
+		 "AdvSceneSwitcher.condition.audio.state.detected"},
+		{MacroConditionAudio::VoiceCondition::NOT_DETECTED,
+		 "AdvSceneSwitcher.condition.audio.state.notDetected"},
+};
+
 const static std::map<MacroConditionAudio::VolumeCondition, std::string>
 	audioVolumeConditionTypes = {
 		{MacroConditionAudio::VolumeCondition::ABOVE,
@@ -49,16 +77,25 @@ const static std::map<MacroConditionAudio::VolumeCondition, std::string>
 		 "AdvSceneSwitcher.condition.audio.state.unmute"},
 };
 
-void MacroConditionAudio::SetType(const Type &type)
+static bool usesOutputCondition(MacroConditionAudio::Type type)
 {
-	_checkType = type;
-	SetupTempVars();
+	return type == MacroConditionAudio::Type::OUTPUT_VOLUME ||
+	       type == MacroConditionAudio::Type::BALANCE ||
+	       type == MacroConditionAudio::Type::SYNC_OFFSET ||
+	       type == MacroConditionAudio::Type::LOUDNESS;
 }
 
-MacroConditionAudio::~MacroConditionAudio()
+static bool usesAudioAnalysis(MacroConditionAudio::Type type)
 {
-	obs_volmeter_remove_callback(_volmeter, SetVolumeLevel, this);
-	obs_volmeter_destroy(_volmeter);
+	return type == MacroConditionAudio::Type::LOUDNESS ||
+	       type == MacroConditionAudio::Type::VOICE_ACTIVITY;
+}
+
+void MacroConditionAudio::SetType(const Type &type)
+{
+	_checkType = type;
+	UpdateLevelTap();
+	SetupTempVars();
 }
 
 float MacroConditionAudio::GetVolumePeak()
@@ -77,32 +114,75 @@ float MacroConditionAudio::GetVolumePeak()
 	// is assumed, that the source no longer produces any audio output and
 	// thus a peak volume value of negative infinity is used.
 
-	float peak;
+	if (!_levelTap) {
+		return -std::numeric_limits<float>::infinity();
+	}
+
+	// Only the most recent interval is considered, if the macro was paused
+	// or this condition was not checked in the previous interval, as the
+	// peaks since the last check might be long outdated
+	const auto now = AudioLevelTap::Clock::now();
+	const auto interval = milliseconds(GetIntervalValue());
+	const bool wasPaused = MacroWasPausedSince(GetMacro(), _lastCheck);
+	_lastCheck = high_resolution_clock::now();
+	if (wasPaused || now - _lastPeakCheck > 2 * interval) {
+		_lastPeakCheck = now - interval;
+	}
 
-	std::lock_guard<std::mutex> lock(_peakMutex);
-	auto msPassedSinceLastUpdate = duration_cast<milliseconds>(
-		high_resolution_clock::now() - _lastPeakUpdate);
-	if (_lastPeakUpdate.time_since_epoch().count() != 0 &&
-	    msPassedSinceLastUpdate > timeout) {
+	float peak;
+	const auto lastUpdate = _levelTap->GetLastUpdate();
+	if (lastUpdate.time_since_epoch().count() != 0 &&
+	    now - lastUpdate > timeout) {
 		peak = -std::numeric_limits<float>::infinity();
 	} else {
-		peak = _peakUpdated ? _peak : _previousPeak;
+		const auto stats = _levelTap->GetStatistics(_lastPeakCheck);
+		peak = stats.frameCount > 0 ? stats.maxPeak : _previousPeak;
 	}
 
 	_previousPeak = peak;
-	_peak = -std::numeric_limits<float>::infinity();
-	_peakUpdated = false;
+	_lastPeakCheck = now;
 
 	return peak;
 }
 
+float MacroConditionAudio::GetOutputVolume()
+{
+	if (_outputStatistic == OutputStatistic::PEAK_SINCE_LAST_CHECK) {
+		return GetVolumePeak();
+	}
+	if (!_levelTap) {
+		return -std::numeric_limits<float>::infinity();
+	}
+
+	// Older levels are not available, e.g. if the window is set using a
+	// variable
+	const auto window = std::min<std::chrono::milliseconds>(
+		std::chrono::milliseconds(
+			static_cast<int64_t>(_statisticWindow.Milliseconds())),
+		AudioLevelTap::maxHistory);
+	const auto stats = _levelTap->GetStatistics(
+		AudioLevelTap::Clock::now() - window, _percentile);
+
+	switch (_outputStatistic) {
+	case OutputStatistic::MAX_PEAK:
+		return stats.maxPeak;
+	case OutputStatistic::AVERAGE:
+		return stats.averageMagnitude;
+	case OutputStatistic::PEAK_PERCENTILE:
+		return stats.peakPercentile;
+	default:
+		break;
+	}
+	return -std::numeric_limits<float>::infinity();
+}
+
 bool MacroConditionAudio::CheckOutputCondition()
 {
 	bool ret = false;
 	OBSSourceAutoRelease source =
 		obs_weak_source_get_source(_audioSource.GetSource());
 
-	float peak = GetVolumePeak();
+	float peak = GetOutputVolume();
 	double curVolume = _useDb ? peak : DecibelToPercent(peak) * 100;
 
 	switch (_outputCondition) {
@@ -127,9 +207,9 @@ bool MacroConditionAudio::CheckOutputCondition()
 	SetVariableValue(std::to_string(curVolume));
 	SetTempVarValue("output_volume", std::to_string(curVolume));
 
-	// Reset for next check
+	// The variable might refer to a different source for the next check
 	if (_audioSource.GetType() == SourceSelection::Type::VARIABLE) {
-		ResetVolmeter();
+		UpdateLevelTap();
 	}
 
 	return ret && source;
@@ -245,6 +325,51 @@ bool MacroConditionAudio::CheckBalance()
 	return ret && source;
 }
 
+bool MacroConditionAudio::CheckLoudness()
+{
+	if (!_analyzer) {
+		return false;
+	}
+
+	const auto results = _analyzer->GetResults();
+	bool ret = false;
+	if (_outputCondition == OutputCondition::ABOVE) {
+		ret = results.momentaryLoudness > _loudness;
+	} else {
+		ret = results.momentaryLoudness < _loudness;
+	}
+	SetVariableValue(std::to_string(results.momentaryLoudness));
+	SetTempVarValue("loudness", std::to_string(results.momentaryLoudness));
+	SetTempVarValue("rms", std::to_string(results.rms));
+
+	// The variable might refer to a different source for the next check
+	if (_audioSource.GetType() == SourceSelection::Type::VARIABLE) {
+		UpdateLevelTap();
+	}
+	return ret;
+}
+
+bool MacroConditionAudio::CheckVoiceActivity()
+{
+	if (!_analyzer) {
+		return false;
+	}
+
+	const auto results = _analyzer->GetResults();
+	const bool ret = _voiceCondition == VoiceCondition::DETECTED
+				 ? results.voiceActive
+				 : !results.voiceActive;
+	SetTempVarValue("voice_active",
+			results.voiceActive ? "true" : "false");
+	SetTempVarValue("loudness", std::to_string(results.momentaryLoudness));
+
+	// The variable might refer to a different source for the next check
+	if (_audioSource.GetType() == SourceSelection::Type::VARIABLE) {
+		UpdateLevelTap();
+	}
+	return ret;
+}
+
 bool MacroConditionAudio::CheckCondition()
 {
 	bool ret = false;
@@ -264,6 +389,12 @@ bool MacroConditionAudio::CheckCondition()
 	case Type::BALANCE:
 		ret = CheckBalance();
 		break;
+	case Type::LOUDNESS:
+		ret = CheckLoudness();
+		break;
+	case Type::VOICE_ACTIVITY:
+		ret = CheckVoiceActivity();
+		break;
 	}
 
 	if (GetVariableValue().empty()) {
@@ -288,26 +419,17 @@ bool MacroConditionAudio::Save(obs_data_t *obj) const
 			 static_cast<int>(_volumeCondition));
 	obs_data_set_bool(obj, "useDb", _useDb);
 	_volumeDB.Save(obj, "volumeDB");
-	obs_data_set_int(obj, "version", 3);
+	obs_data_set_int(obj, "outputStatistic",
+			 static_cast<int>(_outputStatistic));
+	_statisticWindow.Save(obj, "statisticWindow");
+	_percentile.Save(obj, "percentile");
+	_loudness.Save(obj, "loudness");
+	obs_data_set_int(obj, "voiceCondition",
+			 static_cast<int>(_voiceCondition));
+	obs_data_set_int(obj, "version", 5);
 	return true;
 }
 
-obs_volmeter_t *AddVolmeterToSource(MacroConditionAudio *entry,
-				    obs_weak_source *source)
-{
-	obs_volmeter_t *volmeter = obs_volmeter_create(OBS_FADER_LOG);
-	obs_volmeter_add_callback(volmeter, MacroConditionAudio::SetVolumeLevel,
-				  entry);
-	OBSSourceAutoRelease audioSource = obs_weak_source_get_source(source);
-	if (!obs_volmeter_attach_source(volmeter, audioSource)) {
-		const char *name = obs_source_get_name(audioSource);
-		blog(LOG_WARNING, "failed to attach volmeter to source %s",
-		     name);
-	}
-
-	return volmeter;
-}
-
 bool MacroConditionAudio::Load(obs_data_t *obj)
 {
 	MacroCondition::Load(obj);
@@ -328,7 +450,7 @@ bool MacroConditionAudio::Load(obs_data_t *obj)
 		obs_data_get_int(obj, "outputCondition"));
 	_volumeCondition = static_cast<VolumeCondition>(
 		obs_data_get_int(obj, "volumeCondition"));
-	_volmeter = AddVolmeterToSource(this, _audioSource.GetSource());
+	UpdateLevelTap();
 
 	if (obs_data_get_int(obj, "version") < 2) {
 		// Set default values for dB handling
@@ -346,6 +468,17 @@ bool MacroConditionAudio::Load(obs_data_t *obj)
 		_useDb = obs_data_get_bool(obj, "useDb");
 		_volumeDB.Load(obj, "volumeDB");
 	}
+	if (obs_data_get_int(obj, "version") >= 4) {
+		_outputStatistic = static_cast<OutputStatistic>(
+			obs_data_get_int(obj, "outputStatistic"));
+		_statisticWindow.Load(obj, "statisticWindow");
+		_percentile.Load(obj, "percentile");
+	}
+	if (obs_data_get_int(obj, "version") >= 5) {
+		_loudness.Load(obj, "loudness");
+		_voiceCondition = static_cast<VoiceCondition>(
+			obs_data_get_int(obj, "voiceCondition"));
+	}
 	return true;
 }
 
@@ -354,32 +487,16 @@ std::string MacroConditionAudio::GetShortDesc() const
 	return _audioSource.ToString();
 }
 
-void MacroConditionAudio::SetVolumeLevel(void *data, const float *,
-					 const float peak[MAX_AUDIO_CHANNELS],
-					 const float *)
+void MacroConditionAudio::UpdateLevelTap()
 {
-	auto c = static_cast<MacroConditionAudio *>(data);
-	const auto macro = c->GetMacro();
-	if (MacroIsPaused(macro)) {
-		return;
-	}
-
-	std::lock_guard<std::mutex> lock(c->_peakMutex);
-	for (int i = 0; i < MAX_AUDIO_CHANNELS; i++) {
-		if (peak[i] > c->_peak) {
-			c->_peak = peak[i];
-		}
+	_levelTap = AudioLevelTap::Get(_audioSource.GetSource());
+	// Analyzing the raw audio is more expensive than reading the levels,
+	// so only do so if required
+	if (usesAudioAnalysis(_checkType)) {
+		_analyzer = AudioAnalyzer::Get(_audioSource.GetSource());
+	} else {
+		_analyzer.reset();
 	}
-	c->_peakUpdated = true;
-	c->_lastPeakUpdate = std::chrono::high_resolution_clock::now();
-}
-
-void MacroConditionAudio::ResetVolmeter()
-{
-	obs_volmeter_remove_callback(_volmeter, SetVolumeLevel, this);
-	obs_volmeter_destroy(_volmeter);
-
-	_volmeter = AddVolmeterToSource(this, _audioSource.GetSource());
 }
 
 void MacroConditionAudio::SetupTempVars()
@@ -421,6 +538,33 @@ void MacroConditionAudio::SetupTempVars()
 			   obs_module_text(
 				   "AdvSceneSwitcher.tempVar.audio.balance"));
 		break;
+	case Type::LOUDNESS:
+		AddTempvar(
+			"loudness",
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.loudness"),
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.loudness.description"));
+		AddTempvar(
+			"rms",
+			obs_module_text("AdvSceneSwitcher.tempVar.audio.rms"),
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.rms.description"));
+		break;
+	case Type::VOICE_ACTIVITY:
+		AddTempvar(
+			"voice_active",
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.voice_active"),
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.voice_active.description"));
+		AddTempvar(
+			"loudness",
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.loudness"),
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.audio.loudness.description"));
+		break;
 	default:
 		break;
 	}
@@ -450,6 +594,21 @@ static inline void populateOutputConditionSelection(QComboBox *list)
 	}
 }
 
+static inline void populateOutputStatisticSelection(QComboBox *list)
+{
+	for (const auto &[_, name] : outputStatistics) {
+		list->addItem(obs_module_text(name.c_str()));
+	}
+}
+
+static inline void populateVoiceConditionSelection(QComboBox *list)
+{
+	list->clear();
+	for (const auto &[_, name] : voiceConditionTypes) {
+		list->addItem(obs_module_text(name.c_str()));
+	}
+}
+
 static inline void populateVolumeConditionSelection(QComboBox *list)
 {
 	list->clear();
@@ -458,6 +617,18 @@ static inline void populateVolumeConditionSelection(QComboBox *list)
 	}
 }
 
+static inline void populateConditionSelection(QComboBox *list,
+					      MacroConditionAudio::Type type)
+{
+	if (usesOutputCondition(type)) {
+		populateOutputConditionSelection(list);
+	} else if (type == MacroConditionAudio::Type::CONFIGURED_VOLUME) {
+		populateVolumeConditionSelection(list);
+	} else if (type == MacroConditionAudio::Type::VOICE_ACTIVITY) {
+		populateVoiceConditionSelection(list);
+	}
+}
+
 MacroConditionAudioEdit::MacroConditionAudioEdit(
 	QWidget *parent, std::shared_ptr<MacroConditionAudio> entryData)
 	: QWidget(parent),
@@ -469,7 +640,14 @@ MacroConditionAudioEdit::MacroConditionAudioEdit(
 	  _percentDBToggle(new QPushButton),
 	  _syncOffset(new VariableSpinBox()),
 	  _monitorTypes(new QComboBox),
-	  _balance(new SliderSpinBox(0., 1., ""))
+	  _balance(new SliderSpinBox(0., 1., "")),
+	  _statisticLayout(new QHBoxLayout()),
+	  _outputStatistic(new QComboBox()),
+	  _statisticWindowLabel(new QLabel(obs_module_text(
+		  "AdvSceneSwitcher.condition.audio.statistic.window"))),
+	  _statisticWindow(new DurationSelection(this, false, 0.1)),
+	  _percentile(new VariableDoubleSpinBox()),
+	  _loudness(new VariableDoubleSpinBox())
 {
 	_volumePercent->setSuffix("%");
 	_volumePercent->setMaximum(100);
@@ -484,9 +662,14 @@ MacroConditionAudioEdit::MacroConditionAudioEdit(
 	_syncOffset->setMaximum(20000);
 	_syncOffset->setSuffix("ms");
 
-	auto sources = GetAudioSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_percentile->setMinimum(0);
+	_percentile->setMaximum(100);
+
+	_loudness->setMinimum(-100);
+	_loudness->setMaximum(0);
+	_loudness->setSuffix("LUFS");
+
+	_sources->SetSourceModel(SourceListFilterModel::AudioSources());
 
 	QWidget::connect(_checkTypes, SIGNAL(currentIndexChanged(int)), this,
 			 SLOT(CheckTypeChanged(int)));
@@ -516,9 +699,27 @@ MacroConditionAudioEdit::MacroConditionAudioEdit(
 		this, SLOT(VolumeDBChanged(const NumberVariable<double> &)));
 	QWidget::connect(_percentDBToggle, SIGNAL(clicked()), this,
 			 SLOT(PercentDBClicked()));
+	QWidget::connect(_outputStatistic, SIGNAL(currentIndexChanged(int)),
+			 this, SLOT(OutputStatisticChanged(int)));
+	_statisticWindow->SpinBox()->setMaximum(
+		double(AudioLevelTap::maxHistory.count()));
+	_statisticWindow->setToolTip(obs_module_text(
+		"AdvSceneSwitcher.condition.audio.statistic.window.tooltip"));
+	QWidget::connect(_statisticWindow,
+			 SIGNAL(DurationChanged(const Duration &)), this,
+			 SLOT(StatisticWindowChanged(const Duration &)));
+	QWidget::connect(
+		_percentile,
+		SIGNAL(NumberVariableChanged(const NumberVariable<double> &)),
+		this, SLOT(PercentileChanged(const NumberVariable<double> &)));
+	QWidget::connect(
+		_loudness,
+		SIGNAL(NumberVariableChanged(const NumberVariable<double> &)),
+		this, SLOT(LoudnessChanged(const NumberVariable<double> &)));
 
 	populateCheckTypes(_checkTypes);
 	PopulateMonitorTypeSelection(_monitorTypes);
+	populateOutputStatisticSelection(_outputStatistic);
 
 	QHBoxLayout *switchLayout = new QHBoxLayout;
 	std::unordered_map<std::string, QWidget *> widgetPlaceholders = {
@@ -531,12 +732,22 @@ MacroConditionAudioEdit::MacroConditionAudioEdit(
 		{"{{condition}}", _condition},
 		{"{{volumeDB}}", _volumeDB},
 		{"{{percentDBToggle}}", _percentDBToggle},
+		{"{{loudness}}", _loudness},
 	};
 	PlaceWidgets(obs_module_text("AdvSceneSwitcher.condition.audio.entry"),
 		     switchLayout, widgetPlaceholders);
+	PlaceWidgets(
+		obs_module_text(
+			"AdvSceneSwitcher.condition.audio.entry.statistic"),
+		_statisticLayout,
+		{{"{{statistic}}", _outputStatistic},
+		 {"{{percentile}}", _percentile},
+		 {"{{windowLabel}}", _statisticWindowLabel},
+		 {"{{window}}", _statisticWindow}});
 
 	QVBoxLayout *mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(switchLayout);
+	mainLayout->addLayout(_statisticLayout);
 	mainLayout->addWidget(_balance);
 	setLayout(mainLayout);
 
@@ -572,7 +783,7 @@ void MacroConditionAudioEdit::SourceChanged(const SourceSelection &source)
 	{
 		auto lock = LockContext();
 		_entryData->_audioSource = source;
-		_entryData->ResetVolmeter();
+		_entryData->UpdateLevelTap();
 	}
 	UpdateVolmeterSource();
 	SetWidgetVisibility();
@@ -682,6 +893,50 @@ void MacroConditionAudioEdit::SyncSliderAndValueSelection(bool sliderMoved)
 	}
 }
 
+void MacroConditionAudioEdit::OutputStatisticChanged(int value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_outputStatistic =
+		static_cast<MacroConditionAudio::OutputStatistic>(value);
+	SetWidgetVisibility();
+}
+
+void MacroConditionAudioEdit::StatisticWindowChanged(const Duration &value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_statisticWindow = value;
+}
+
+void MacroConditionAudioEdit::PercentileChanged(
+	const NumberVariable<double> &value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_percentile = value;
+}
+
+void MacroConditionAudioEdit::LoudnessChanged(
+	const NumberVariable<double> &value)
+{
+	if (_loading || !_entryData) {
+		return;
+	}
+
+	auto lock = LockContext();
+	_entryData->_loudness = value;
+}
+
 void MacroConditionAudioEdit::ConditionChanged(int cond)
 {
 	if (_loading || !_entryData) {
@@ -689,11 +944,13 @@ void MacroConditionAudioEdit::ConditionChanged(int cond)
 	}
 
 	auto lock = LockContext();
-	if (_entryData->GetType() == MacroConditionAudio::Type::OUTPUT_VOLUME ||
-	    _entryData->GetType() == MacroConditionAudio::Type::BALANCE ||
-	    _entryData->GetType() == MacroConditionAudio::Type::SYNC_OFFSET) {
+	if (usesOutputCondition(_entryData->GetType())) {
 		_entryData->_outputCondition =
 			static_cast<MacroConditionAudio::OutputCondition>(cond);
+	} else if (_entryData->GetType() ==
+		   MacroConditionAudio::Type::VOICE_ACTIVITY) {
+		_entryData->_voiceCondition =
+			static_cast<MacroConditionAudio::VoiceCondition>(cond);
 	} else {
 		_entryData->_volumeCondition =
 			static_cast<MacroConditionAudio::VolumeCondition>(cond);
@@ -712,14 +969,7 @@ void MacroConditionAudioEdit::CheckTypeChanged(int idx)
 		_checkTypes->itemData(idx).toInt()));
 
 	const QSignalBlocker b(_condition);
-	if (_entryData->GetType() == MacroConditionAudio::Type::OUTPUT_VOLUME ||
-	    _entryData->GetType() == MacroConditionAudio::Type::BALANCE ||
-	    _entryData->GetType() == MacroConditionAudio::Type::SYNC_OFFSET) {
-		populateOutputConditionSelection(_condition);
-	} else if (_entryData->GetType() ==
-		   MacroConditionAudio::Type::CONFIGURED_VOLUME) {
-		populateVolumeConditionSelection(_condition);
-	}
+	populateConditionSelection(_condition, _entryData->GetType());
 	SetWidgetVisibility();
 }
 
@@ -735,20 +985,26 @@ void MacroConditionAudioEdit::UpdateEntryData()
 	_syncOffset->SetValue(_entryData->_syncOffset);
 	_monitorTypes->setCurrentIndex(_entryData->_monitorType);
 	_balance->SetDoubleValue(_entryData->_balance);
+	_outputStatistic->setCurrentIndex(
+		static_cast<int>(_entryData->_outputStatistic));
+	_statisticWindow->SetDuration(_entryData->_statisticWindow);
+	_percentile->SetValue(_entryData->_percentile);
+	_loudness->SetValue(_entryData->_loudness);
 	_checkTypes->setCurrentIndex(
 		_checkTypes->findData(static_cast<int>(_entryData->GetType())));
 
-	if (_entryData->GetType() == MacroConditionAudio::Type::OUTPUT_VOLUME ||
-	    _entryData->GetType() == MacroConditionAudio::Type::BALANCE ||
-	    _entryData->GetType() == MacroConditionAudio::Type::SYNC_OFFSET) {
-		populateOutputConditionSelection(_condition);
+	populateConditionSelection(_condition, _entryData->GetType());
+	if (usesOutputCondition(_entryData->GetType())) {
 		_condition->setCurrentIndex(
 			static_cast<int>(_entryData->_outputCondition));
 	} else if (_entryData->GetType() ==
 		   MacroConditionAudio::Type::CONFIGURED_VOLUME) {
-		populateVolumeConditionSelection(_condition);
 		_condition->setCurrentIndex(
 			static_cast<int>(_entryData->_volumeCondition));
+	} else if (_entryData->GetType() ==
+		   MacroConditionAudio::Type::VOICE_ACTIVITY) {
+		_condition->setCurrentIndex(
+			static_cast<int>(_entryData->_voiceCondition));
 	}
 
 	UpdateVolmeterSource();
@@ -776,13 +1032,13 @@ void MacroConditionAudioEdit::SetWidgetVisibility()
 	}
 
 	_condition->setVisible(
-		_entryData->GetType() ==
-			MacroConditionAudio::Type::OUTPUT_VOLUME ||
+		usesOutputCondition(_entryData->GetType()) ||
 		_entryData->GetType() ==
 			MacroConditionAudio::Type::CONFIGURED_VOLUME ||
-		_entryData->GetType() == MacroConditionAudio::Type::BALANCE ||
 		_entryData->GetType() ==
-			MacroConditionAudio::Type::SYNC_OFFSET);
+			MacroConditionAudio::Type::VOICE_ACTIVITY);
+	_loudness->setVisible(_entryData->GetType() ==
+			      MacroConditionAudio::Type::LOUDNESS);
 	_syncOffset->setVisible(_entryData->GetType() ==
 				MacroConditionAudio::Type::SYNC_OFFSET);
 	_monitorTypes->setVisible(_entryData->GetType() ==
@@ -791,6 +1047,22 @@ void MacroConditionAudioEdit::SetWidgetVisibility()
 			     MacroConditionAudio::Type::BALANCE);
 	_volMeter->setVisible(_entryData->GetType() ==
 			      MacroConditionAudio::Type::OUTPUT_VOLUME);
+	SetLayoutVisible(_statisticLayout,
+			 _entryData->GetType() ==
+				 MacroConditionAudio::Type::OUTPUT_VOLUME);
+	const bool useWindow =
+		_entryData->GetType() ==
+			MacroConditionAudio::Type::OUTPUT_VOLUME &&
+		_entryData->_outputStatistic !=
+			MacroConditionAudio::OutputStatistic::
+				PEAK_SINCE_LAST_CHECK;
+	_statisticWindowLabel->setVisible(useWindow);
+	_statisticWindow->setVisible(useWindow);
+	_percentile->setVisible(
+		_entryData->GetType() ==
+			MacroConditionAudio::Type::OUTPUT_VOLUME &&
+		_entryData->_outputStatistic ==
+			MacroConditionAudio::OutputStatistic::PEAK_PERCENTILE);
 	_volumePercent->setVisible(HasVolumeControl() && !_entryData->_useDb);
 	_volumeDB->setVisible(HasVolumeControl() && _entryData->_useDb);
 	_percentDBToggle->setText(_entryData->_useDb ? "dB" : "%");
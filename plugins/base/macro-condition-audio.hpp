@@ -1,5 +1,8 @@
 #pragma once
 #include "macro-condition-edit.hpp"
+#include "audio-analyzer.hpp"
+#include "audio-level-tap.hpp"
+#include "duration-control.hpp"
 #include "volume-control.hpp"
 #include "slider-spinbox.hpp"
 #include "source-selection.hpp"
@@ -14,7 +17,6 @@ namespace advss {
 class MacroConditionAudio : public MacroCondition {
 public:
 	MacroConditionAudio(Macro *m) : MacroCondition(m, true) {}
-	~MacroConditionAudio();
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -24,11 +26,7 @@ public:
 	{
 		return std::make_shared<MacroConditionAudio>(m);
 	}
-	static void SetVolumeLevel(void *data,
-				   const float magnitude[MAX_AUDIO_CHANNELS],
-				   const float peak[MAX_AUDIO_CHANNELS],
-				   const float inputPeak[MAX_AUDIO_CHANNELS]);
-	void ResetVolmeter();
+	void UpdateLevelTap();
 
 	enum class Type {
 		OUTPUT_VOLUME,
@@ -36,6 +34,8 @@ public:
 		SYNC_OFFSET,
 		MONITOR,
 		BALANCE,
+		LOUDNESS,
+		VOICE_ACTIVITY,
 	};
 	void SetType(const Type &);
 	Type GetType() const { return _checkType; }
@@ -45,6 +45,19 @@ public:
 		BELOW,
 	};
 
+	// How the output volume is determined from the levels received
+	enum class OutputStatistic {
+		PEAK_SINCE_LAST_CHECK,
+		MAX_PEAK,
+		AVERAGE,
+		PEAK_PERCENTILE,
+	};
+
+	enum class VoiceCondition {
+		DETECTED,
+		NOT_DETECTED,
+	};
+
 	enum class VolumeCondition {
 		ABOVE,
 		EXACT,
@@ -61,8 +74,13 @@ public:
 	obs_monitoring_type _monitorType = OBS_MONITORING_TYPE_NONE;
 	DoubleVariable _balance = 0.5;
 	OutputCondition _outputCondition = OutputCondition::ABOVE;
+	OutputStatistic _outputStatistic =
+		OutputStatistic::PEAK_SINCE_LAST_CHECK;
+	Duration _statisticWindow = 1.0;
+	DoubleVariable _percentile = 90.0;
+	DoubleVariable _loudness = -23.0;
+	VoiceCondition _voiceCondition = VoiceCondition::DETECTED;
 	VolumeCondition _volumeCondition = VolumeCondition::ABOVE;
-	obs_volmeter_t *_volmeter = nullptr;
 
 private:
 	bool CheckOutputCondition();
@@ -70,15 +88,18 @@ private:
 	bool CheckSyncOffset();
 	bool CheckMonitor();
 	bool CheckBalance();
+	bool CheckLoudness();
+	bool CheckVoiceActivity();
 	void SetupTempVars();
 	float GetVolumePeak();
+	float GetOutputVolume();
 
 	Type _checkType = Type::OUTPUT_VOLUME;
-	std::mutex _peakMutex;
-	float _peak = -std::numeric_limits<float>::infinity();
+	std::shared_ptr<AudioLevelTap> _levelTap;
+	std::shared_ptr<AudioAnalyzer> _analyzer;
 	float _previousPeak = -std::numeric_limits<float>::infinity();
-	bool _peakUpdated = false;
-	std::chrono::high_resolution_clock::time_point _lastPeakUpdate = {};
+	AudioLevelTap::Clock::time_point _lastPeakCheck = {};
+	std::chrono::high_resolution_clock::time_point _lastCheck = {};
 	static bool _registered;
 	static const std::string id;
 };
@@ -111,6 +132,10 @@ private slots:
 	void VolumeDBChanged(const NumberVariable<double> &value);
 	void PercentDBClicked();
 	void SyncSliderAndValueSelection(bool sliderMoved);
+	void OutputStatisticChanged(int);
+	void StatisticWindowChanged(const Duration &);
+	void PercentileChanged(const NumberVariable<double> &);
+	void LoudnessChanged(const NumberVariable<double> &);
 
 signals:
 	void HeaderInfoChanged(const QString &);
@@ -128,6 +153,12 @@ private:
 	VariableSpinBox *_syncOffset;
 	QComboBox *_monitorTypes;
 	SliderSpinBox *_balance;
+	QHBoxLayout *_statisticLayout;
+	QComboBox *_outputStatistic;
+	QLabel *_statisticWindowLabel;
+	DurationSelection *_statisticWindow;
+	VariableDoubleSpinBox *_percentile;
+	VariableDoubleSpinBox *_loudness;
 	VolControl *_volMeter = nullptr;
 
 	std::shared_ptr<MacroConditionAudio> _entryData;
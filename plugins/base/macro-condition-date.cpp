@@ -1,4 +1,5 @@
 #include "macro-condition-date.hpp"
+#include "deadline-scheduler.hpp"
 #include "layout-helpers.hpp"
 #include "macro-helpers.hpp"
 
@@ -57,6 +58,11 @@ const static std::map<MacroConditionDate::Day, std::string> dayOfWeekNames = {
 	 "AdvSceneSwitcher.condition.date.sunday"},
 };
 
+MacroConditionDate::~MacroConditionDate()
+{
+	GetDeadlineScheduler().Cancel(this);
+}
+
 bool MacroConditionDate::CheckDayOfWeek(int64_t msSinceLastCheck)
 {
 	QDateTime cur = QDateTime::currentDateTime();
@@ -192,10 +198,26 @@ bool MacroConditionDate::CheckCondition()
 				  timePassed)
 			: std::chrono::milliseconds(0);
 
-	if (_dayOfWeekCheck) {
-		return CheckDayOfWeek(msSinceLastCheck.count());
+	const bool match = _dayOfWeekCheck
+				   ? CheckDayOfWeek(msSinceLastCheck.count())
+				   : CheckRegularDate(msSinceLastCheck.count());
+	ScheduleNextStateChange();
+	return match;
+}
+
+void MacroConditionDate::ScheduleNextStateChange()
+{
+	const auto now = QDateTime::currentDateTime();
+	const auto next = GetNextStateChange(now);
+	if (!next.isValid()) {
+		GetDeadlineScheduler().Cancel(this);
+		return;
 	}
-	return CheckRegularDate(msSinceLastCheck.count());
+
+	// The comparisons include the boundary itself, so wake up just after
+	const auto deadline = DeadlineScheduler::Clock::now() +
+			      std::chrono::milliseconds(now.msecsTo(next) + 1);
+	GetDeadlineScheduler().Schedule(this, deadline);
 }
 
 bool MacroConditionDate::Save(obs_data_t *obj) const
@@ -316,6 +338,48 @@ QDateTime MacroConditionDate::GetNextMatchDateTime() const
 	return _dateTime;
 }
 
+QDateTime MacroConditionDate::GetNextStateChange(const QDateTime &now) const
+{
+	const QDateTime nextMidnight(now.date().addDays(1), QTime(0, 0));
+	if (_dayOfWeekCheck) {
+		// The day of week can only change at midnight
+		if (_ignoreTime) {
+			return nextMidnight;
+		}
+		QDateTime next(now.date(), _dateTime.time());
+		if (next <= now) {
+			next = next.addDays(1);
+		}
+		return std::min(next, nextMidnight);
+	}
+
+	// Patterns might match at any second
+	if (_condition == Condition::PATTERN) {
+		return {};
+	}
+	if (_ignoreTime) {
+		return _ignoreDate ? QDateTime() : nextMidnight;
+	}
+
+	QDateTime next;
+	const auto considerBoundary = [&](QDateTime boundary) {
+		if (_ignoreDate) {
+			boundary.setDate(now.date());
+			if (boundary <= now) {
+				boundary = boundary.addDays(1);
+			}
+		}
+		if (boundary > now && (!next.isValid() || boundary < next)) {
+			next = boundary;
+		}
+	};
+	considerBoundary(_dateTime);
+	if (_condition == Condition::BETWEEN) {
+		considerBoundary(_dateTime2);
+	}
+	return next;
+}
+
 void MacroConditionDate::SetVariables(const QDateTime &date)
 {
 	SetVariableValue(date.toString().toStdString());
@@ -12,6 +12,7 @@ namespace advss {
 class MacroConditionDate : public MacroCondition {
 public:
 	MacroConditionDate(Macro *m) : MacroCondition(m, true) {}
+	~MacroConditionDate();
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -29,6 +30,7 @@ public:
 	QDateTime GetDateTime1() const;
 	QDateTime GetDateTime2() const;
 	QDateTime GetNextMatchDateTime() const;
+	QDateTime GetNextStateChange(const QDateTime &now) const;
 
 	enum class Day {
 		ANY = 0,
@@ -66,6 +68,7 @@ private:
 	bool CheckPattern(QDateTime now, int64_t secondsSinceLastCheck);
 	void SetVariables(const QDateTime &date);
 	void SetupTempVars();
+	void ScheduleNextStateChange();
 
 	QDateTime _dateTime = QDateTime::currentDateTime();
 	QDateTime _dateTime2 = QDateTime::currentDateTime();
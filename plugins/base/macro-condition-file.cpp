@@ -144,6 +144,56 @@ bool MacroConditionFile::CheckChangeDate()
 	return dateChanged;
 }
 
+bool MacroConditionFile::NewLineMatches(const QString &line) const
+{
+	const auto text = QString::fromStdString(_text);
+	if (_regex.Enabled()) {
+		return _regex.Matches(line, text);
+	}
+	return line.contains(text);
+}
+
+bool MacroConditionFile::CheckNewLineMatch()
+{
+	if (_fileType == FileType::REMOTE) {
+		return false;
+	}
+
+	const std::string path = _file;
+	if (path != _tailPath) {
+		_tailPath = path;
+		_watch = FileWatch::Get(QString::fromStdString(path));
+		_lastGeneration = 0;
+		_lastSize = -1;
+		_tail.SetPath(QString::fromStdString(path));
+	}
+
+	// The size is checked as well, as file system notifications are not
+	// available for all kinds of storage, like network drives
+	const auto generation = _watch ? _watch->GetGeneration() : 0;
+	const auto size = QFileInfo(QString::fromStdString(path)).size();
+	if (generation == _lastGeneration && size == _lastSize) {
+		return false;
+	}
+	_lastGeneration = generation;
+	_lastSize = size;
+
+	// Each matching line triggers its own run of the actions, so lines
+	// appended at once are all reported within the same check
+	bool matched = false;
+	for (const auto &line : _tail.ReadNewLines()) {
+		if (!NewLineMatches(line)) {
+			continue;
+		}
+		const auto value = line.toStdString();
+		SetVariableValue(value);
+		SetTempVarValue("line", value);
+		QueueMessageRun();
+		matched = true;
+	}
+	return matched;
+}
+
 void MacroConditionFile::SetupTempVars()
 {
 	MacroCondition::SetupTempVars();
@@ -151,6 +201,12 @@ void MacroConditionFile::SetupTempVars()
 		AddTempvar(
 			"date",
 			obs_module_text("AdvSceneSwitcher.tempVar.file.date"));
+	} else if (_condition == Condition::NEW_LINE_MATCH) {
+		AddTempvar(
+			"line",
+			obs_module_text("AdvSceneSwitcher.tempVar.file.line"),
+			obs_module_text(
+				"AdvSceneSwitcher.tempVar.file.line.description"));
 	} else {
 		AddTempvar("content",
 			   obs_module_text(
@@ -175,6 +231,9 @@ bool MacroConditionFile::CheckCondition()
 	case Condition::DATE_CHANGE:
 		ret = CheckChangeDate();
 		break;
+	case Condition::NEW_LINE_MATCH:
+		ret = CheckNewLineMatch();
+		break;
 	default:
 		break;
 	}
@@ -237,6 +296,8 @@ static void populateConditions(QComboBox *list)
 		"AdvSceneSwitcher.condition.file.type.contentChange"));
 	list->addItem(obs_module_text(
 		"AdvSceneSwitcher.condition.file.type.dateChange"));
+	list->addItem(obs_module_text(
+		"AdvSceneSwitcher.condition.file.type.newLineMatch"));
 }
 
 MacroConditionFileEdit::MacroConditionFileEdit(
@@ -430,10 +491,13 @@ void MacroConditionFileEdit::SetWidgetVisibility()
 		return;
 	}
 
-	_matchText->setVisible(_entryData->GetCondition() ==
-			       MacroConditionFile::Condition::MATCH);
-	_regex->setVisible(_entryData->GetCondition() ==
-			   MacroConditionFile::Condition::MATCH);
+	const bool matchesText =
+		_entryData->GetCondition() ==
+			MacroConditionFile::Condition::MATCH ||
+		_entryData->GetCondition() ==
+			MacroConditionFile::Condition::NEW_LINE_MATCH;
+	_matchText->setVisible(matchesText);
+	_regex->setVisible(matchesText);
 	_checkModificationDate->setVisible(
 		_entryData->_useTime &&
 		_entryData->GetCondition() ==
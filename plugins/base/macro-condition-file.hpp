@@ -1,6 +1,8 @@
 #pragma once
 #include "macro-condition-edit.hpp"
 #include "file-selection.hpp"
+#include "file-tail.hpp"
+#include "file-watch.hpp"
 #include "variable-text-edit.hpp"
 #include "regex-config.hpp"
 
@@ -35,6 +37,7 @@ public:
 		MATCH,
 		CONTENT_CHANGE,
 		DATE_CHANGE,
+		NEW_LINE_MATCH,
 	};
 	void SetCondition(Condition condition);
 	Condition GetCondition() const { return _condition; }
@@ -54,11 +57,21 @@ private:
 	bool CheckLocalFileContent();
 	bool CheckChangeContent();
 	bool CheckChangeDate();
+	bool CheckNewLineMatch();
+	bool NewLineMatches(const QString &line) const;
 	void SetupTempVars();
 
 	Condition _condition = Condition::MATCH;
 	QDateTime _lastMod;
 	size_t _lastHash = 0;
+
+	// Used to only read the lines appended to the file
+	std::string _tailPath;
+	std::shared_ptr<FileWatch> _watch;
+	uint64_t _lastGeneration = 0;
+	qint64 _lastSize = -1;
+	FileTail _tail;
+
 	static bool _registered;
 	static const std::string id;
 };
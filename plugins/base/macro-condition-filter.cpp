@@ -48,14 +48,18 @@ bool MacroConditionFilter::CheckConditionHelper(const OBSWeakSource &filter)
 		ret = !obs_source_enabled(filterSource);
 		break;
 	case Condition::SETTINGS_MATCH: {
-		ret = CompareSourceSettings(filter, _settings, _regex);
-		const auto settings = GetSourceSettings(filter);
+		auto cache = SourceSettingsCache::Get(filter);
+		_settingsCaches.emplace_back(cache);
+		ret = cache->Matches(_settings, _regex);
+		const auto settings = cache->GetSettings();
 		SetVariableValue(settings);
 		SetTempVarValue("settings", settings);
 		break;
 	}
 	case Condition::SETTINGS_CHANGED: {
-		const auto settings = GetSourceSettings(filter);
+		auto cache = SourceSettingsCache::Get(filter);
+		_settingsCaches.emplace_back(cache);
+		const auto settings = cache->GetSettings();
 		ret = !_currentSettings.empty() && settings != _currentSettings;
 		_currentSettings = settings;
 		SetVariableValue(settings);
@@ -97,6 +101,11 @@ bool MacroConditionFilter::CheckCondition()
 		return false;
 	}
 
+	// Keeps the settings caches of the last check alive until the ones
+	// still in use were acquired again
+	const auto previousSettingsCaches = std::move(_settingsCaches);
+	_settingsCaches.clear();
+
 	bool ret = true;
 	for (const auto &filter : filters) {
 		ret = ret && CheckConditionHelper(filter);
@@ -5,6 +5,7 @@
 #include "source-selection.hpp"
 #include "filter-selection.hpp"
 #include "source-setting.hpp"
+#include "source-settings-cache.hpp"
 
 #include <QComboBox>
 #include <QPushButton>
@@ -47,6 +48,7 @@ private:
 	bool CheckConditionHelper(const OBSWeakSource &);
 
 	Condition _condition = Condition::ENABLED;
+	std::vector<std::shared_ptr<SourceSettingsCache>> _settingsCaches;
 	std::string _currentSettings;
 	std::string _currentSettingsValue;
 
@@ -5,6 +5,7 @@
 #include "scene-switch-helpers.hpp"
 #include "selection-helpers.hpp"
 #include "source-helpers.hpp"
+#include "source-list-model.hpp"
 
 namespace advss {
 
@@ -625,9 +626,7 @@ MacroConditionMediaEdit::MacroConditionMediaEdit(
 	_states->setToolTip(obs_module_text(
 		"AdvSceneSwitcher.condition.media.inconsistencyInfo"));
 
-	auto sources = GetMediaSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::MediaSources());
 
 	QWidget::connect(_sourceTypes, SIGNAL(currentIndexChanged(int)), this,
 			 SLOT(SourceTypeChanged(int)));
@@ -0,0 +1,268 @@
+#include "macro-condition-osc.hpp"
+#include "layout-helpers.hpp"
+#include "macro-helpers.hpp"
+
+namespace advss {
+
+const std::string MacroConditionOSC::id = "osc";
+
+bool MacroConditionOSC::_registered = MacroConditionFactory::Register(
+	MacroConditionOSC::id,
+	{MacroConditionOSC::Create, MacroConditionOSCEdit::Create,
+	 "AdvSceneSwitcher.condition.osc"});
+
+MacroConditionOSC::MacroConditionOSC(Macro *m) : MacroCondition(m, true) {}
+
+bool MacroConditionOSC::CheckCondition()
+{
+	// The port might be controlled by a variable
+	UpdateMessageBuffer();
+	if (!_messageBuffer) {
+		return false;
+	}
+
+	const bool macroWasPausedSinceLastCheck =
+		MacroWasPausedSince(GetMacro(), _lastCheck);
+	_lastCheck = std::chrono::high_resolution_clock::now();
+	if (macroWasPausedSinceLastCheck) {
+		_messageBuffer->Clear();
+		return false;
+	}
+
+	bool matched = false;
+	while (!_messageBuffer->Empty()) {
+		auto message = _messageBuffer->ConsumeMessage();
+		if (!message) {
+			continue;
+		}
+		const bool addressMatches =
+			_regex.Enabled()
+				? _regex.Matches(message->address, _address)
+				: message->address == std::string(_address);
+		if (!addressMatches) {
+			continue;
+		}
+
+		SetTempVarValue("address", message->address);
+		SetTempVarValue("arguments", message->GetArgumentsString());
+		SetVariableValue(message->ToString());
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
+		if (_clearBufferOnMatch) {
+			_messageBuffer->Clear();
+		}
+		return true;
+	}
+	if (!matched) {
+		SetVariableValue("");
+	}
+	return matched;
+}
+
+bool MacroConditionOSC::Save(obs_data_t *obj) const
+{
+	MacroCondition::Save(obj);
+	_port.Save(obj, "port");
+	_address.Save(obj, "address");
+	_regex.Save(obj);
+	obs_data_set_bool(obj, "clearBufferOnMatch", _clearBufferOnMatch);
+	obs_data_set_bool(obj, "runForEachMessage", _runForEachMessage);
+	_bufferSettings.Save(obj);
+	return true;
+}
+
+bool MacroConditionOSC::Load(obs_data_t *obj)
+{
+	MacroCondition::Load(obj);
+	_port.Load(obj, "port");
+	_address.Load(obj, "address");
+	_regex.Load(obj);
+	_clearBufferOnMatch = obs_data_get_bool(obj, "clearBufferOnMatch");
+	_runForEachMessage = obs_data_get_bool(obj, "runForEachMessage");
+	_bufferSettings.Load(obj);
+	UpdateMessageBuffer();
+	return true;
+}
+
+std::string MacroConditionOSC::GetShortDesc() const
+{
+	return std::to_string(_port.GetValue());
+}
+
+void MacroConditionOSC::SetPort(const IntVariable &port)
+{
+	_port = port;
+	UpdateMessageBuffer();
+}
+
+void MacroConditionOSC::SetBufferSettings(const MessageBufferSettings &settings)
+{
+	_bufferSettings = settings;
+	_bufferSettings.Apply(_messageBuffer.get());
+}
+
+MessageBufferSettings MacroConditionOSC::GetBufferSettings() const
+{
+	return _bufferSettings;
+}
+
+std::shared_ptr<MessageBufferBase> MacroConditionOSC::GetMessageBuffer() const
+{
+	return _messageBuffer;
+}
+
+void MacroConditionOSC::UpdateMessageBuffer()
+{
+	const int port = _port.GetValue();
+	if (port == _registeredPort) {
+		return;
+	}
+	_registeredPort = port;
+
+	// Release the old buffer first, so the listener on the previous port
+	// can be closed if it is no longer used
+	_messageBuffer.reset();
+	if (port <= 0 || port > 65535) {
+		return;
+	}
+	_messageBuffer = RegisterForOSCMessages(port);
+	_bufferSettings.Apply(_messageBuffer.get());
+}
+
+void MacroConditionOSC::SetupTempVars()
+{
+	MacroCondition::SetupTempVars();
+	AddTempvar("address",
+		   obs_module_text("AdvSceneSwitcher.tempVar.osc.address"),
+		   obs_module_text(
+			   "AdvSceneSwitcher.tempVar.osc.address.description"));
+	AddTempvar(
+		"arguments",
+		obs_module_text("AdvSceneSwitcher.tempVar.osc.arguments"),
+		obs_module_text(
+			"AdvSceneSwitcher.tempVar.osc.arguments.description"));
+}
+
+MacroConditionOSCEdit::MacroConditionOSCEdit(
+	QWidget *parent, std::shared_ptr<MacroConditionOSC> entryData)
+	: QWidget(parent),
+	  _port(new VariableSpinBox(this)),
+	  _address(new VariableLineEdit(this)),
+	  _regex(new RegexConfigWidget(parent)),
+	  _clearBufferOnMatch(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch"))),
+	  _runForEachMessage(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.runForEachMessage"))),
+	  _bufferSettings(new MessageBufferSettingsWidget(this))
+{
+	_port->setMinimum(1);
+	_port->setMaximum(65535);
+
+	QWidget::connect(
+		_port,
+		SIGNAL(NumberVariableChanged(const NumberVariable<int> &)),
+		this, SLOT(PortChanged(const NumberVariable<int> &)));
+	QWidget::connect(_address, SIGNAL(editingFinished()), this,
+			 SLOT(AddressChanged()));
+	QWidget::connect(_regex,
+			 SIGNAL(RegexConfigChanged(const RegexConfig &)), this,
+			 SLOT(RegexChanged(const RegexConfig &)));
+	QWidget::connect(_clearBufferOnMatch, SIGNAL(stateChanged(int)), this,
+			 SLOT(ClearBufferOnMatchChanged(int)));
+	QWidget::connect(_runForEachMessage, SIGNAL(stateChanged(int)), this,
+			 SLOT(RunForEachMessageChanged(int)));
+	QWidget::connect(
+		_bufferSettings,
+		SIGNAL(SettingsChanged(const MessageBufferSettings &)), this,
+		SLOT(BufferSettingsChanged(const MessageBufferSettings &)));
+
+	auto entryLayout = new QHBoxLayout();
+	std::unordered_map<std::string, QWidget *> widgetPlaceholders = {
+		{"{{port}}", _port},
+		{"{{address}}", _address},
+		{"{{regex}}", _regex},
+	};
+	PlaceWidgets(obs_module_text("AdvSceneSwitcher.condition.osc.entry"),
+		     entryLayout, widgetPlaceholders);
+
+	auto mainLayout = new QVBoxLayout;
+	mainLayout->addLayout(entryLayout);
+	mainLayout->addWidget(_clearBufferOnMatch);
+	mainLayout->addWidget(_runForEachMessage);
+	mainLayout->addWidget(_bufferSettings);
+	setLayout(mainLayout);
+
+	_entryData = entryData;
+	UpdateEntryData();
+	_loading = false;
+}
+
+void MacroConditionOSCEdit::UpdateEntryData()
+{
+	if (!_entryData) {
+		return;
+	}
+
+	_port->SetValue(_entryData->GetPort());
+	_address->setText(_entryData->_address);
+	_regex->SetRegexConfig(_entryData->_regex);
+	_clearBufferOnMatch->setChecked(_entryData->_clearBufferOnMatch);
+	_clearBufferOnMatch->setDisabled(_entryData->_runForEachMessage);
+	_runForEachMessage->setChecked(_entryData->_runForEachMessage);
+	_bufferSettings->SetSettings(_entryData->GetBufferSettings());
+	_bufferSettings->SetStatsSource([this]() {
+		auto lock = LockContext();
+		return _entryData->GetMessageBuffer();
+	});
+
+	adjustSize();
+	updateGeometry();
+}
+
+void MacroConditionOSCEdit::PortChanged(const NumberVariable<int> &value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->SetPort(value);
+	emit HeaderInfoChanged(
+		QString::fromStdString(_entryData->GetShortDesc()));
+}
+
+void MacroConditionOSCEdit::AddressChanged()
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_address = _address->text().toStdString();
+}
+
+void MacroConditionOSCEdit::RegexChanged(const RegexConfig &conf)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_regex = conf;
+
+	adjustSize();
+	updateGeometry();
+}
+
+void MacroConditionOSCEdit::ClearBufferOnMatchChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_clearBufferOnMatch = value;
+}
+
+void MacroConditionOSCEdit::RunForEachMessageChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_runForEachMessage = value;
+	_clearBufferOnMatch->setDisabled(value);
+}
+
+void MacroConditionOSCEdit::BufferSettingsChanged(
+	const MessageBufferSettings &settings)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->SetBufferSettings(settings);
+}
+
+} // namespace advss
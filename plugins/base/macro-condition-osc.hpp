@@ -0,0 +1,89 @@
+#pragma once
+#include "macro-condition-edit.hpp"
+#include "message-buffer-settings.hpp"
+#include "osc-transport.hpp"
+#include "regex-config.hpp"
+#include "variable-line-edit.hpp"
+#include "variable-spinbox.hpp"
+
+#include <QCheckBox>
+
+namespace advss {
+
+class MacroConditionOSC : public MacroCondition {
+public:
+	MacroConditionOSC(Macro *m);
+	bool CheckCondition();
+	bool Save(obs_data_t *obj) const;
+	bool Load(obs_data_t *obj);
+	std::string GetShortDesc() const;
+	std::string GetId() const { return id; };
+	static std::shared_ptr<MacroCondition> Create(Macro *m)
+	{
+		return std::make_shared<MacroConditionOSC>(m);
+	}
+
+	void SetPort(const IntVariable &);
+	IntVariable GetPort() const { return _port; }
+	void SetBufferSettings(const MessageBufferSettings &);
+	MessageBufferSettings GetBufferSettings() const;
+	std::shared_ptr<MessageBufferBase> GetMessageBuffer() const override;
+
+	StringVariable _address = "/address";
+	RegexConfig _regex;
+	bool _clearBufferOnMatch = true;
+	bool _runForEachMessage = false;
+
+private:
+	void SetupTempVars();
+	void UpdateMessageBuffer();
+
+	IntVariable _port = 12345;
+	int _registeredPort = -1;
+	OSCMessageBuffer _messageBuffer;
+	MessageBufferSettings _bufferSettings;
+	std::chrono::high_resolution_clock::time_point _lastCheck{};
+
+	static bool _registered;
+	static const std::string id;
+};
+
+class MacroConditionOSCEdit : public QWidget {
+	Q_OBJECT
+
+public:
+	MacroConditionOSCEdit(
+		QWidget *parent,
+		std::shared_ptr<MacroConditionOSC> cond = nullptr);
+	void UpdateEntryData();
+	static QWidget *Create(QWidget *parent,
+			       std::shared_ptr<MacroCondition> cond)
+	{
+		return new MacroConditionOSCEdit(
+			parent,
+			std::dynamic_pointer_cast<MacroConditionOSC>(cond));
+	}
+
+private slots:
+	void PortChanged(const NumberVariable<int> &);
+	void AddressChanged();
+	void RegexChanged(const RegexConfig &);
+	void ClearBufferOnMatchChanged(int);
+	void RunForEachMessageChanged(int);
+	void BufferSettingsChanged(const MessageBufferSettings &);
+signals:
+	void HeaderInfoChanged(const QString &);
+
+private:
+	VariableSpinBox *_port;
+	VariableLineEdit *_address;
+	RegexConfigWidget *_regex;
+	QCheckBox *_clearBufferOnMatch;
+	QCheckBox *_runForEachMessage;
+	MessageBufferSettingsWidget *_bufferSettings;
+
+	std::shared_ptr<MacroConditionOSC> _entryData;
+	bool _loading = true;
+};
+
+} // namespace advss
@@ -63,7 +63,6 @@ didTransformOfAnySceneItemChange(const std::vector<OBSSceneItem> &items,
 {
 	bool ret = false;
 	std::string json;
-	RegexConfig regex;
 	auto numItems = items.size();
 	if (previousTransform.size() < numItems) {
 		ret = true;
@@ -72,7 +71,9 @@ didTransformOfAnySceneItemChange(const std::vector<OBSSceneItem> &items,
 	for (size_t idx = 0; idx < numItems; ++idx) {
 		auto const &item = items[idx];
 		json = GetSceneItemTransform(item);
-		if (!MatchJson(json, previousTransform[idx], regex)) {
+		// Both values were serialized the same way, so there is no need
+		// to parse and compare them structurally
+		if (json != previousTransform[idx]) {
 			ret = true;
 			previousTransform[idx] = json;
 		}
@@ -78,19 +78,29 @@ bool MacroConditionSource::CheckCondition()
 		ret = obs_source_showing(s);
 		break;
 	case Condition::ALL_SETTINGS_MATCH: {
-		ret = CompareSourceSettings(_source.GetSource(), _settings,
-					    _regex);
-		const auto settings = GetSourceSettings(_source.GetSource());
+		_settingsCache = SourceSettingsCache::Get(_source.GetSource());
+		ret = _settingsCache->Matches(_settings, _regex);
+		const auto settings = _settingsCache->GetSettings();
 		SetVariableValue(settings);
 		SetTempVarValue("settings", settings);
 		break;
 	}
 	case Condition::SETTINGS_CHANGED: {
-		const auto settings = GetSourceSettings(_source.GetSource());
-		ret = !_currentSettings.empty() && settings != _currentSettings;
-		_currentSettings = settings;
-		SetVariableValue(settings);
-		SetTempVarValue("settings", settings);
+		auto cache = SourceSettingsCache::Get(_source.GetSource());
+		if (cache != _settingsCache) {
+			_settingsCache = cache;
+			_settingsGeneration = 0;
+		}
+		const auto generation = _settingsCache->GetGeneration();
+		if (generation != _settingsGeneration) {
+			_settingsGeneration = generation;
+			const auto settings = _settingsCache->GetSettings();
+			ret = !_currentSettings.empty() &&
+			      settings != _currentSettings;
+			_currentSettings = settings;
+		}
+		SetVariableValue(_currentSettings);
+		SetTempVarValue("settings", _currentSettings);
 		break;
 	}
 	case Condition::INDIVIDUAL_SETTING_MATCH: {
@@ -4,6 +4,7 @@
 #include "regex-config.hpp"
 #include "source-selection.hpp"
 #include "source-setting.hpp"
+#include "source-settings-cache.hpp"
 
 #include <QComboBox>
 #include <QPushButton>
@@ -50,6 +51,8 @@ private:
 	void SetupTempVars();
 
 	Condition _condition = Condition::ACTIVE;
+	std::shared_ptr<SourceSettingsCache> _settingsCache;
+	uint64_t _settingsGeneration = 0;
 	std::string _currentSettings;
 	std::string _currentSettingsValue;
 
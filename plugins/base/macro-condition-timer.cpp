@@ -1,4 +1,5 @@
 #include "macro-condition-timer.hpp"
+#include "deadline-scheduler.hpp"
 #include "layout-helpers.hpp"
 
 #include <random>
@@ -22,25 +23,43 @@ const static std::map<MacroConditionTimer::TimerType, std::string> timerTypes =
 static std::random_device rd;
 static std::default_random_engine re(rd());
 
+MacroConditionTimer::~MacroConditionTimer()
+{
+	GetDeadlineScheduler().Cancel(this);
+}
+
 bool MacroConditionTimer::CheckCondition()
 {
 	if (_paused) {
+		GetDeadlineScheduler().Cancel(this);
 		SetVariables(_remaining);
 		return _remaining == 0.;
 	}
 	SetVariables(_duration.TimeRemaining());
 	if (_duration.DurationReached()) {
-		if (!_oneshot) {
+		if (_oneshot) {
+			GetDeadlineScheduler().Cancel(this);
+		} else {
 			_duration.Reset();
 			if (_type == TimerType::RANDOM) {
 				SetRandomTimeRemaining();
 			}
+			ScheduleExpiration();
 		}
 		return true;
 	}
+	ScheduleExpiration();
 	return false;
 }
 
+void MacroConditionTimer::ScheduleExpiration()
+{
+	using Clock = DeadlineScheduler::Clock;
+	const auto remaining = std::chrono::duration_cast<Clock::duration>(
+		std::chrono::duration<double>(_duration.TimeRemaining()));
+	GetDeadlineScheduler().Schedule(this, Clock::now() + remaining);
+}
+
 void MacroConditionTimer::SetRandomTimeRemaining()
 {
 	double min, max;
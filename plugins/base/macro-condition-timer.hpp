@@ -13,6 +13,7 @@ namespace advss {
 class MacroConditionTimer : public MacroCondition {
 public:
 	MacroConditionTimer(Macro *m) : MacroCondition(m, true) {}
+	~MacroConditionTimer();
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
 	bool Load(obs_data_t *obj);
@@ -36,6 +37,7 @@ public:
 
 private:
 	void SetRandomTimeRemaining();
+	void ScheduleExpiration();
 	void SetVariables(double seconds);
 	void SetupTempVars();
 
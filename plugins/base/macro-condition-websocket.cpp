@@ -24,7 +24,7 @@ const static std::map<MacroConditionWebsocket::Type, std::string>
 MacroConditionWebsocket::MacroConditionWebsocket(Macro *m)
 	: MacroCondition(m, true)
 {
-	_messageBuffer = RegisterForWebsocketMessages();
+	SetMessageBuffer(RegisterForWebsocketMessages());
 }
 
 bool MacroConditionWebsocket::CheckCondition()
@@ -41,37 +41,35 @@ bool MacroConditionWebsocket::CheckCondition()
 		return false;
 	}
 
+	bool matched = false;
 	while (!_messageBuffer->Empty()) {
 		auto message = _messageBuffer->ConsumeMessage();
 		if (!message) {
 			continue;
 		}
-		if (_regex.Enabled()) {
-			if (!_regex.Matches(*message, _message)) {
-				continue;
-			}
-
-			SetTempVarValue("message", *message);
-			SetVariableValue(*message);
-			if (_clearBufferOnMatch) {
-				_messageBuffer->Clear();
-			}
-			return true;
-		} else {
-			if (*message != std::string(_message)) {
-				continue;
-			}
-
-			SetTempVarValue("message", *message);
-			SetVariableValue(*message);
-			if (_clearBufferOnMatch) {
-				_messageBuffer->Clear();
-			}
-			return true;
+		const bool messageMatches =
+			_regex.Enabled() ? _regex.Matches(*message, _message)
+					 : *message == std::string(_message);
+		if (!messageMatches) {
+			continue;
+		}
+
+		SetTempVarValue("message", *message);
+		SetVariableValue(*message);
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
 		}
+		if (_clearBufferOnMatch) {
+			_messageBuffer->Clear();
+		}
+		return true;
+	}
+	if (!matched) {
+		SetVariableValue("");
 	}
-	SetVariableValue("");
-	return false;
+	return matched;
 }
 
 bool MacroConditionWebsocket::Save(obs_data_t *obj) const
@@ -83,6 +81,8 @@ bool MacroConditionWebsocket::Save(obs_data_t *obj) const
 	obs_data_set_string(obj, "connection",
 			    GetWeakConnectionName(_connection).c_str());
 	obs_data_set_bool(obj, "clearBufferOnMatch", _clearBufferOnMatch);
+	obs_data_set_bool(obj, "runForEachMessage", _runForEachMessage);
+	_bufferSettings.Save(obj);
 	obs_data_set_int(obj, "version", 1);
 	return true;
 }
@@ -105,6 +105,8 @@ bool MacroConditionWebsocket::Load(obs_data_t *obj)
 	if (!obs_data_has_user_value(obj, "version")) {
 		_clearBufferOnMatch = true;
 	}
+	_runForEachMessage = obs_data_get_bool(obj, "runForEachMessage");
+	_bufferSettings.Load(obj);
 
 	SetType(_type);
 	return true;
@@ -122,7 +124,7 @@ void MacroConditionWebsocket::SetType(Type type)
 {
 	_type = type;
 	if (_type == Type::REQUEST) {
-		_messageBuffer = RegisterForWebsocketMessages();
+		SetMessageBuffer(RegisterForWebsocketMessages());
 		return;
 	}
 
@@ -130,7 +132,7 @@ void MacroConditionWebsocket::SetType(Type type)
 	if (!connection) {
 		return;
 	}
-	_messageBuffer = connection->RegisterForEvents();
+	SetMessageBuffer(connection->RegisterForEvents());
 }
 
 void MacroConditionWebsocket::SetConnection(const std::string &connectionName)
@@ -145,7 +147,7 @@ void MacroConditionWebsocket::SetConnection(const std::string &connectionName)
 	if (!connection) {
 		return;
 	}
-	_messageBuffer = connection->RegisterForEvents();
+	SetMessageBuffer(connection->RegisterForEvents());
 }
 
 std::weak_ptr<WSConnection> MacroConditionWebsocket::GetConnection() const
@@ -153,6 +155,31 @@ std::weak_ptr<WSConnection> MacroConditionWebsocket::GetConnection() const
 	return _connection;
 }
 
+void MacroConditionWebsocket::SetBufferSettings(
+	const MessageBufferSettings &settings)
+{
+	_bufferSettings = settings;
+	_bufferSettings.Apply(_messageBuffer.get());
+}
+
+MessageBufferSettings MacroConditionWebsocket::GetBufferSettings() const
+{
+	return _bufferSettings;
+}
+
+std::shared_ptr<MessageBufferBase>
+MacroConditionWebsocket::GetMessageBuffer() const
+{
+	return _messageBuffer;
+}
+
+void MacroConditionWebsocket::SetMessageBuffer(
+	const WebsocketMessageBuffer &buffer)
+{
+	_messageBuffer = buffer;
+	_bufferSettings.Apply(_messageBuffer.get());
+}
+
 void MacroConditionWebsocket::SetupTempVars()
 {
 	MacroCondition::SetupTempVars();
@@ -179,6 +206,9 @@ MacroConditionWebsocketEdit::MacroConditionWebsocketEdit(
 	  _connection(new WSConnectionSelection(this)),
 	  _clearBufferOnMatch(new QCheckBox(
 		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch"))),
+	  _runForEachMessage(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.runForEachMessage"))),
+	  _bufferSettings(new MessageBufferSettingsWidget(this)),
 	  _editLayout(new QHBoxLayout())
 {
 	populateConditionSelection(_conditions);
@@ -195,6 +225,12 @@ MacroConditionWebsocketEdit::MacroConditionWebsocketEdit(
 			 SLOT(ConnectionSelectionChanged(const QString &)));
 	QWidget::connect(_clearBufferOnMatch, SIGNAL(stateChanged(int)), this,
 			 SLOT(ClearBufferOnMatchChanged(int)));
+	QWidget::connect(_runForEachMessage, SIGNAL(stateChanged(int)), this,
+			 SLOT(RunForEachMessageChanged(int)));
+	QWidget::connect(
+		_bufferSettings,
+		SIGNAL(SettingsChanged(const MessageBufferSettings &)), this,
+		SLOT(BufferSettingsChanged(const MessageBufferSettings &)));
 
 	QVBoxLayout *mainLayout = new QVBoxLayout;
 	mainLayout->addLayout(_editLayout);
@@ -205,6 +241,8 @@ MacroConditionWebsocketEdit::MacroConditionWebsocketEdit(
 	regexLayout->setContentsMargins(0, 0, 0, 0);
 	mainLayout->addLayout(regexLayout);
 	mainLayout->addWidget(_clearBufferOnMatch);
+	mainLayout->addWidget(_runForEachMessage);
+	mainLayout->addWidget(_bufferSettings);
 	setLayout(mainLayout);
 
 	_entryData = entryData;
@@ -255,6 +293,13 @@ void MacroConditionWebsocketEdit::UpdateEntryData()
 	_regex->SetRegexConfig(_entryData->_regex);
 	_connection->SetConnection(_entryData->GetConnection());
 	_clearBufferOnMatch->setChecked(_entryData->_clearBufferOnMatch);
+	_clearBufferOnMatch->setDisabled(_entryData->_runForEachMessage);
+	_runForEachMessage->setChecked(_entryData->_runForEachMessage);
+	_bufferSettings->SetSettings(_entryData->GetBufferSettings());
+	_bufferSettings->SetStatsSource([this]() {
+		auto lock = LockContext();
+		return _entryData->GetMessageBuffer();
+	});
 
 	if (_entryData->GetType() == MacroConditionWebsocket::Type::REQUEST) {
 		SetupRequestEdit();
@@ -302,6 +347,20 @@ void MacroConditionWebsocketEdit::ClearBufferOnMatchChanged(int value)
 	_entryData->_clearBufferOnMatch = value;
 }
 
+void MacroConditionWebsocketEdit::RunForEachMessageChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_runForEachMessage = value;
+	_clearBufferOnMatch->setDisabled(value);
+}
+
+void MacroConditionWebsocketEdit::BufferSettingsChanged(
+	const MessageBufferSettings &settings)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->SetBufferSettings(settings);
+}
+
 void MacroConditionWebsocketEdit::RegexChanged(const RegexConfig &conf)
 {
 	GUARD_LOADING_AND_LOCK();
@@ -1,6 +1,7 @@
 #pragma once
 #include "macro-condition-edit.hpp"
 #include "connection-manager.hpp"
+#include "message-buffer-settings.hpp"
 #include "variable-text-edit.hpp"
 #include "regex-config.hpp"
 #include "websocket-helpers.hpp"
@@ -31,17 +32,23 @@ public:
 	Type GetType() const { return _type; }
 	void SetConnection(const std::string &);
 	std::weak_ptr<WSConnection> GetConnection() const;
+	void SetBufferSettings(const MessageBufferSettings &);
+	MessageBufferSettings GetBufferSettings() const;
+	std::shared_ptr<MessageBufferBase> GetMessageBuffer() const override;
 	StringVariable _message = obs_module_text("AdvSceneSwitcher.enterText");
 	RegexConfig _regex;
 	bool _clearBufferOnMatch = true;
+	bool _runForEachMessage = false;
 
 private:
 	void SetupTempVars();
+	void SetMessageBuffer(const WebsocketMessageBuffer &);
 
 	Type _type = Type::REQUEST;
 	std::weak_ptr<WSConnection> _connection;
 
 	WebsocketMessageBuffer _messageBuffer;
+	MessageBufferSettings _bufferSettings;
 	std::chrono::high_resolution_clock::time_point _lastCheck{};
 
 	static bool _registered;
@@ -71,6 +78,8 @@ private slots:
 	void RegexChanged(const RegexConfig &);
 	void ConnectionSelectionChanged(const QString &);
 	void ClearBufferOnMatchChanged(int);
+	void RunForEachMessageChanged(int);
+	void BufferSettingsChanged(const MessageBufferSettings &);
 signals:
 	void HeaderInfoChanged(const QString &);
 
@@ -83,6 +92,8 @@ private:
 	RegexConfigWidget *_regex;
 	WSConnectionSelection *_connection;
 	QCheckBox *_clearBufferOnMatch;
+	QCheckBox *_runForEachMessage;
+	MessageBufferSettingsWidget *_bufferSettings;
 	QHBoxLayout *_editLayout;
 
 	std::shared_ptr<MacroConditionWebsocket> _entryData;
@@ -0,0 +1,202 @@
+#include "audio-analysis.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+	(defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ADVSS_ANALYZER_SSE2
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ADVSS_ANALYZER_NEON
+#endif
+
+namespace advss {
+
+constexpr double momentaryWindowSeconds = 0.4;
+
+constexpr double vadMinLevelDb = -55.0;
+constexpr double vadMarginDb = 9.0;
+constexpr double vadMaxZeroCrossingsPerSecond = 6000.0;
+constexpr double vadNoiseFloorRisePerSecond = 1.0;
+// Levels this low only occur if the audio is muted or digitally silent.
+// They are not used as the noise floor, as any background noise following
+// them would otherwise be considered to be speech until the noise floor
+// caught up.
+constexpr double vadDigitalSilenceDb = -90.0;
+// Bridges short pauses between words
+constexpr double vadHangoverSeconds = 0.3;
+
+double SumOfSquares(const float *samples, size_t count)
+{
+	size_t i = 0;
+	double sum = 0.0;
+#if defined(ADVSS_ANALYZER_SSE2)
+	__m128 acc = _mm_setzero_ps();
+	for (; i + 4 <= count; i += 4) {
+		const __m128 value = _mm_loadu_ps(samples + i);
+		acc = _mm_add_ps(acc, _mm_mul_ps(value, value));
+	}
+	alignas(16) float parts[4];
+	_mm_store_ps(parts, acc);
+	sum = double(parts[0]) + parts[1] + parts[2] + parts[3];
+#elif defined(ADVSS_ANALYZER_NEON)
+	float32x4_t acc = vdupq_n_f32(0.f);
+	for (; i + 4 <= count; i += 4) {
+		const float32x4_t value = vld1q_f32(samples + i);
+		acc = vmlaq_f32(acc, value, value);
+	}
+	float parts[4];
+	vst1q_f32(parts, acc);
+	sum = double(parts[0]) + parts[1] + parts[2] + parts[3];
+#endif
+	for (; i < count; i++) {
+		sum += double(samples[i]) * samples[i];
+	}
+	return sum;
+}
+
+size_t CountZeroCrossings(const float *samples, size_t count)
+{
+	// Written without branches, so it can be vectorized by the compiler
+	size_t crossings = 0;
+	for (size_t i = 1; i < count; i++) {
+		crossings += (samples[i - 1] < 0.f) != (samples[i] < 0.f);
+	}
+	return crossings;
+}
+
+double ToDecibel(double power)
+{
+	return power > 0.0 ? std::max(10.0 * std::log10(power), minEnergyDb)
+			   : minEnergyDb;
+}
+
+void Biquad::Process(float *samples, size_t count)
+{
+	for (size_t i = 0; i < count; i++) {
+		const double x = samples[i];
+		const double y = b0 * x + b1 * x1 + b2 * x2 - a1 * y1 - a2 * y2;
+		x2 = x1;
+		x1 = x;
+		y2 = y1;
+		y1 = y;
+		samples[i] = float(y);
+	}
+}
+
+// The filter coefficients are derived for the given sample rate
+KWeighting::KWeighting(double sampleRate)
+{
+	const double pi = 3.14159265358979323846;
+
+	double f0 = 1681.974450955533;
+	const double gain = 3.999843853973347;
+	double q = 0.7071752369554196;
+	double k = std::tan(pi * f0 / sampleRate);
+	const double vh = std::pow(10.0, gain / 20.0);
+	const double vb = std::pow(vh, 0.4996667741545416);
+	double a0 = 1.0 + k / q + k * k;
+	_shelf.b0 = (vh + vb * k / q + k * k) / a0;
+	_shelf.b1 = 2.0 * (k * k - vh) / a0;
+	_shelf.b2 = (vh - vb * k / q + k * k) / a0;
+	_shelf.a1 = 2.0 * (k * k - 1.0) / a0;
+	_shelf.a2 = (1.0 - k / q + k * k) / a0;
+
+	f0 = 38.13547087602444;
+	q = 0.5003270373238773;
+	k = std::tan(pi * f0 / sampleRate);
+	a0 = 1.0 + k / q + k * k;
+	_highPass.b0 = 1.0;
+	_highPass.b1 = -2.0;
+	_highPass.b2 = 1.0;
+	_highPass.a1 = 2.0 * (k * k - 1.0) / a0;
+	_highPass.a2 = (1.0 - k / q + k * k) / a0;
+}
+
+void KWeighting::Process(float *samples, size_t count)
+{
+	_shelf.Process(samples, count);
+	_highPass.Process(samples, count);
+}
+
+MomentaryWindow::MomentaryWindow(uint32_t sampleRate)
+	: _windowFrames(uint64_t(momentaryWindowSeconds * sampleRate))
+{
+}
+
+void MomentaryWindow::Add(double weighted, double unweighted,
+			  uint32_t frames)
+{
+	_blocks.push_back({weighted, unweighted, frames});
+
+	// The sums are computed from scratch, so rounding errors of removed
+	// blocks do not accumulate
+	_total = {};
+	_frames = 0;
+	for (const auto &block : _blocks) {
+		_frames += block.frames;
+		_total.weighted += block.weighted;
+		_total.unweighted += block.unweighted;
+	}
+	while (_blocks.size() > 1 &&
+	       _frames - _blocks.front().frames >= _windowFrames) {
+		_frames -= _blocks.front().frames;
+		_total.weighted -= _blocks.front().weighted;
+		_total.unweighted -= _blocks.front().unweighted;
+		_blocks.pop_front();
+	}
+}
+
+double MomentaryWindow::WeightedMeanSquare() const
+{
+	return _frames > 0 ? _total.weighted / double(_frames) : 0.0;
+}
+
+double MomentaryWindow::UnweightedMeanSquare() const
+{
+	return _frames > 0 ? _total.unweighted / double(_frames) : 0.0;
+}
+
+VoiceActivityDetector::VoiceActivityDetector(uint32_t sampleRate)
+	: _sampleRate(sampleRate)
+{
+}
+
+bool VoiceActivityDetector::Process(const float *samples, size_t count)
+{
+	if (count == 0) {
+		return false;
+	}
+
+	const double seconds = double(count) / _sampleRate;
+	const double level = ToDecibel(SumOfSquares(samples, count) / count);
+	const double crossingsPerSecond =
+		double(CountZeroCrossings(samples, count)) / seconds;
+
+	// The noise floor follows decreasing levels immediately, but only
+	// slowly rises, so it is not affected by speech
+	if (level > vadDigitalSilenceDb) {
+		if (!_noiseFloorValid || level < _noiseFloor) {
+			_noiseFloor = level;
+			_noiseFloorValid = true;
+		} else {
+			const double rise =
+				vadNoiseFloorRisePerSecond * seconds;
+			_noiseFloor = std::min(level, _noiseFloor + rise);
+		}
+	}
+
+	_framesSinceSpeech += count;
+	if (level > vadMinLevelDb && level > _noiseFloor + vadMarginDb &&
+	    crossingsPerSecond < vadMaxZeroCrossingsPerSecond) {
+		_speechDetected = true;
+		_framesSinceSpeech = 0;
+	}
+	return _speechDetected &&
+	       _framesSinceSpeech <=
+		       uint64_t(vadHangoverSeconds * _sampleRate);
+}
+
+} // namespace advss
@@ -0,0 +1,79 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+namespace advss {
+
+// Building blocks of the audio analysis, which do not depend on OBS
+
+constexpr double minEnergyDb = -100.0;
+
+double SumOfSquares(const float *samples, size_t count);
+size_t CountZeroCrossings(const float *samples, size_t count);
+// Converts a mean square to decibels, which are limited to minEnergyDb
+double ToDecibel(double power);
+
+struct Biquad {
+	double b0 = 1.0, b1 = 0.0, b2 = 0.0, a1 = 0.0, a2 = 0.0;
+	double x1 = 0.0, x2 = 0.0, y1 = 0.0, y2 = 0.0;
+	void Process(float *samples, size_t count);
+};
+
+// K-weighting of a single channel as defined by ITU-R BS.1770
+class KWeighting {
+public:
+	explicit KWeighting(double sampleRate);
+	// Filters the samples in place
+	void Process(float *samples, size_t count);
+
+	const Biquad &Shelf() const { return _shelf; }
+	const Biquad &HighPass() const { return _highPass; }
+
+private:
+	Biquad _shelf;
+	Biquad _highPass;
+};
+
+// Mean squares of the last 400ms, which is the window of the EBU R128
+// momentary loudness
+class MomentaryWindow {
+public:
+	explicit MomentaryWindow(uint32_t sampleRate);
+	// Adds the sums of squared samples of a block
+	void Add(double weighted, double unweighted, uint32_t frames);
+	bool Empty() const { return _frames == 0; }
+	double WeightedMeanSquare() const;
+	double UnweightedMeanSquare() const;
+
+private:
+	struct BlockEnergy {
+		double weighted = 0.0;
+		double unweighted = 0.0;
+		uint32_t frames = 0;
+	};
+
+	const uint64_t _windowFrames;
+	std::deque<BlockEnergy> _blocks;
+	BlockEnergy _total;
+	uint64_t _frames = 0;
+};
+
+// A block is considered to contain speech if its level is sufficiently above
+// the tracked noise floor and it is not dominated by high frequency noise
+class VoiceActivityDetector {
+public:
+	explicit VoiceActivityDetector(uint32_t sampleRate);
+	// Expects mono samples.
+	// Returns whether speech was detected recently.
+	bool Process(const float *samples, size_t count);
+
+private:
+	const uint32_t _sampleRate;
+	double _noiseFloor = 0.0;
+	bool _noiseFloorValid = false;
+	bool _speechDetected = false;
+	uint64_t _framesSinceSpeech = 0;
+};
+
+} // namespace advss
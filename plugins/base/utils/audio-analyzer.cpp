@@ -0,0 +1,265 @@
+#include "audio-analyzer.hpp"
+#include "log-helper.hpp"
+#include "plugin-state-helpers.hpp"
+
+#include <algorithm>
+#include <condition_variable>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace advss {
+
+using namespace std::chrono_literals;
+
+// Audio ticks are roughly 21ms long, so this is enough to cover delays of
+// the worker thread of more than 300ms
+constexpr size_t queueCapacity = 16;
+constexpr auto workerInterval = 10ms;
+// Results are discarded if the source did not produce audio for this long
+constexpr auto staleTimeout = 250ms;
+
+static std::mutex analyzersMutex;
+static std::unordered_map<obs_weak_source_t *, std::weak_ptr<AudioAnalyzer>>
+	analyzers;
+
+namespace {
+
+// Runs the analysis of all active analyzers, so the number of threads does
+// not grow with the number of sources
+class AnalysisWorker {
+public:
+	void Add(AudioAnalyzer *);
+	void Remove(AudioAnalyzer *);
+	void Stop();
+
+private:
+	void Run();
+
+	std::mutex _mutex;
+	std::condition_variable _cv;
+	std::vector<AudioAnalyzer *> _analyzers;
+	std::thread _thread;
+	bool _stop = false;
+};
+
+} // namespace
+
+static AnalysisWorker worker;
+
+static bool setup();
+static bool setupDone = setup();
+
+static bool setup()
+{
+	AddPluginCleanupStep([]() { worker.Stop(); });
+	return true;
+}
+
+void AnalysisWorker::Add(AudioAnalyzer *analyzer)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	_analyzers.push_back(analyzer);
+	if (!_thread.joinable()) {
+		_stop = false;
+		_thread = std::thread(&AnalysisWorker::Run, this);
+	}
+	_cv.notify_one();
+}
+
+void AnalysisWorker::Remove(AudioAnalyzer *analyzer)
+{
+	// Blocks until the analyzer is no longer being processed
+	std::lock_guard<std::mutex> lock(_mutex);
+	_analyzers.erase(std::remove(_analyzers.begin(), _analyzers.end(),
+				     analyzer),
+			 _analyzers.end());
+}
+
+void AnalysisWorker::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_cv.notify_one();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+}
+
+void AnalysisWorker::Run()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_stop) {
+		if (_analyzers.empty()) {
+			_cv.wait(lock, [this]() {
+				return _stop || !_analyzers.empty();
+			});
+			continue;
+		}
+		for (auto analyzer : _analyzers) {
+			analyzer->Analyze();
+		}
+		_cv.wait_for(lock, workerInterval, [this]() { return _stop; });
+	}
+}
+
+AudioAnalyzer::AudioAnalyzer(obs_weak_source_t *source)
+	: _source(source),
+	  _sampleRate(audio_output_get_sample_rate(obs_get_audio())),
+	  _channels(uint32_t(audio_output_get_channels(obs_get_audio()))),
+	  _queue(queueCapacity),
+	  _kWeighting{KWeighting(_sampleRate), KWeighting(_sampleRate)},
+	  _window(_sampleRate),
+	  _voiceActivity(_sampleRate)
+{
+	worker.Add(this);
+	OBSSourceAutoRelease audioSource = obs_weak_source_get_source(source);
+	obs_source_add_audio_capture_callback(audioSource, ReceiveAudio, this);
+}
+
+AudioAnalyzer::~AudioAnalyzer()
+{
+	// If the source was already destroyed, so was the callback
+	OBSSourceAutoRelease source = obs_weak_source_get_source(_source);
+	if (source) {
+		obs_source_remove_audio_capture_callback(source, ReceiveAudio,
+							 this);
+	}
+	worker.Remove(this);
+
+	const auto dropped = _droppedBlocks.load();
+	if (dropped > 0) {
+		blog(LOG_INFO,
+		     "audio analysis could not keep up and dropped %llu blocks",
+		     static_cast<unsigned long long>(dropped));
+	}
+
+	std::lock_guard<std::mutex> lock(analyzersMutex);
+	auto it = analyzers.find(_source);
+	// A new analyzer might have already replaced this one
+	if (it != analyzers.end() && it->second.expired()) {
+		analyzers.erase(it);
+	}
+}
+
+std::shared_ptr<AudioAnalyzer> AudioAnalyzer::Get(obs_weak_source_t *source)
+{
+	if (!source) {
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(analyzersMutex);
+	auto &entry = analyzers[source];
+	auto analyzer = entry.lock();
+	if (!analyzer) {
+		analyzer = std::shared_ptr<AudioAnalyzer>(
+			new AudioAnalyzer(source));
+		entry = analyzer;
+	}
+	return analyzer;
+}
+
+void AudioAnalyzer::ReceiveAudio(void *data, obs_source_t *,
+				 const struct audio_data *audio, bool muted)
+{
+	auto analyzer = static_cast<AudioAnalyzer *>(data);
+	auto &block = analyzer->_captureBlock;
+	block.channels = std::clamp<uint32_t>(analyzer->_channels, 1,
+					      uint32_t(maxChannels));
+
+	for (uint32_t offset = 0; offset < audio->frames;
+	     offset += AUDIO_OUTPUT_FRAMES) {
+		block.frames = std::min<uint32_t>(audio->frames - offset,
+						  AUDIO_OUTPUT_FRAMES);
+		for (uint32_t channel = 0; channel < block.channels;
+		     channel++) {
+			auto &samples = block.samples[channel];
+			const auto input = reinterpret_cast<const float *>(
+				audio->data[channel]);
+			if (muted || !input) {
+				std::fill_n(samples.begin(), block.frames,
+					    0.f);
+				continue;
+			}
+			std::copy_n(input + offset, block.frames,
+				    samples.begin());
+		}
+		if (!analyzer->_queue.Push(block)) {
+			analyzer->_droppedBlocks.fetch_add(
+				1, std::memory_order_relaxed);
+		}
+	}
+}
+
+AudioAnalyzer::Results AudioAnalyzer::GetResults() const
+{
+	std::lock_guard<std::mutex> lock(_resultsMutex);
+	if (Clock::now() - _lastUpdate > staleTimeout) {
+		return {};
+	}
+	return _results;
+}
+
+void AudioAnalyzer::Analyze()
+{
+	// Reuse the block to avoid copying it onto the stack for every pop
+	thread_local Block block;
+	while (_queue.Pop(block)) {
+		AnalyzeBlock(block);
+	}
+}
+
+void AudioAnalyzer::AnalyzeBlock(Block &block)
+{
+	const bool voiceActive = UpdateVoiceActivity(block);
+
+	double weighted = 0.0;
+	double unweighted = 0.0;
+	for (uint32_t channel = 0; channel < block.channels; channel++) {
+		auto samples = block.samples[channel].data();
+		unweighted +=
+			SumOfSquares(samples, block.frames) / block.channels;
+		_kWeighting[channel].Process(samples, block.frames);
+		// Channel weights are 1.0 for the front channels
+		weighted += SumOfSquares(samples, block.frames);
+	}
+
+	_window.Add(weighted, unweighted, block.frames);
+	if (_window.Empty()) {
+		return;
+	}
+
+	Results results;
+	results.rms = float(ToDecibel(_window.UnweightedMeanSquare()));
+	results.momentaryLoudness =
+		float(-0.691 + ToDecibel(_window.WeightedMeanSquare()));
+	results.voiceActive = voiceActive;
+
+	std::lock_guard<std::mutex> lock(_resultsMutex);
+	_results = results;
+	_lastUpdate = Clock::now();
+}
+
+bool AudioAnalyzer::UpdateVoiceActivity(const Block &block)
+{
+	if (block.frames == 0) {
+		return false;
+	}
+
+	// Mix down to mono before the samples are filtered
+	thread_local std::array<float, AUDIO_OUTPUT_FRAMES> mono;
+	const float scale = 1.f / float(block.channels);
+	std::fill_n(mono.begin(), block.frames, 0.f);
+	for (uint32_t channel = 0; channel < block.channels; channel++) {
+		const auto &samples = block.samples[channel];
+		for (uint32_t i = 0; i < block.frames; i++) {
+			mono[i] += samples[i] * scale;
+		}
+	}
+
+	return _voiceActivity.Process(mono.data(), block.frames);
+}
+
+} // namespace advss
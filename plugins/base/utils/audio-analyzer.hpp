@@ -0,0 +1,87 @@
+#pragma once
+#include "audio-analysis.hpp"
+#include "spsc-queue.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <obs.hpp>
+
+namespace advss {
+
+// Analyzes the raw audio of a source to determine its loudness and whether it
+// contains speech.
+// All users interested in the same source share a single analyzer.
+// The audio thread only copies the samples into a lock-free queue, while the
+// analysis itself is done by a worker thread shared by all analyzers.
+class AudioAnalyzer {
+public:
+	using Clock = std::chrono::steady_clock;
+
+	static constexpr float minLevel =
+		-std::numeric_limits<float>::infinity();
+
+	struct Results {
+		// Unweighted level of the last 400ms in dBFS
+		float rms = minLevel;
+		// EBU R128 momentary loudness of the last 400ms in LUFS
+		float momentaryLoudness = minLevel;
+		bool voiceActive = false;
+	};
+
+	~AudioAnalyzer();
+
+	// Returns the analyzer of the given source, which is created if
+	// necessary
+	static std::shared_ptr<AudioAnalyzer> Get(obs_weak_source_t *);
+
+	// If the source did not produce any audio recently, it is considered
+	// to be silent
+	Results GetResults() const;
+
+	// Processes all queued audio.
+	// Must only be called from the worker thread.
+	void Analyze();
+
+private:
+	// Only the first two channels are analyzed, which covers mono and
+	// stereo sources, which microphones usually are
+	static constexpr size_t maxChannels = 2;
+
+	struct Block {
+		std::array<std::array<float, AUDIO_OUTPUT_FRAMES>, maxChannels>
+			samples;
+		uint32_t frames = 0;
+		uint32_t channels = 0;
+	};
+
+	explicit AudioAnalyzer(obs_weak_source_t *);
+	static void ReceiveAudio(void *data, obs_source_t *,
+				 const struct audio_data *, bool muted);
+	void AnalyzeBlock(Block &);
+	bool UpdateVoiceActivity(const Block &);
+
+	OBSWeakSource _source;
+	const uint32_t _sampleRate;
+	const uint32_t _channels;
+
+	// Only accessed by the audio thread
+	Block _captureBlock;
+
+	SPSCQueue<Block> _queue;
+	std::atomic<uint64_t> _droppedBlocks{0};
+
+	// Only accessed by the worker thread
+	std::array<KWeighting, maxChannels> _kWeighting;
+	MomentaryWindow _window;
+	VoiceActivityDetector _voiceActivity;
+
+	mutable std::mutex _resultsMutex;
+	Results _results;
+	Clock::time_point _lastUpdate;
+};
+
+} // namespace advss
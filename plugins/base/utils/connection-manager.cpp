@@ -205,6 +205,11 @@ WebsocketMessageBuffer WSConnection::RegisterForEvents()
 	return _client.RegisterForEvents();
 }
 
+WSClientConnection::Stats WSConnection::GetStats() const
+{
+	return _client.GetStats();
+}
+
 void WSConnection::UseOBSWebsocketProtocol(bool useOBSWSProtocol)
 {
 	_useOBSWSProtocol = useOBSWSProtocol;
@@ -45,6 +45,7 @@ public:
 	bool IsUsingOBSProtocol() const { return _useOBSWSProtocol; }
 	std::string GetURI() const;
 	uint64_t GetPort() const { return _port; }
+	WSClientConnection::Stats GetStats() const;
 
 private:
 	void UseOBSWebsocketProtocol(bool);
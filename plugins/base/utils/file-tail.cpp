@@ -0,0 +1,127 @@
+#include "file-tail.hpp"
+
+#include <QFile>
+#include <algorithm>
+
+#ifdef _WIN32
+#include <io.h>
+#include <windows.h>
+#else
+#include <sys/stat.h>
+#endif
+
+namespace advss {
+
+constexpr qint64 headSize = 256;
+// Limits how much is read at once if a lot of content was appended
+constexpr qint64 maxReadSize = 4 * 1024 * 1024;
+// Content without any line breaks is split into lines of this length
+constexpr int maxLineLength = 1024 * 1024;
+
+void FileTail::SetPath(const QString &path)
+{
+	if (path == _path) {
+		return;
+	}
+	_path = path;
+	Reset();
+	_initialized = false;
+}
+
+void FileTail::Reset()
+{
+	_offset = 0;
+	_head.clear();
+	_id = {};
+	_partialLine.clear();
+}
+
+static FileTail::FileId getFileId(QFile &file)
+{
+	FileTail::FileId id;
+#ifdef _WIN32
+	const auto handle = (HANDLE)_get_osfhandle(file.handle());
+	BY_HANDLE_FILE_INFORMATION info;
+	if (handle != INVALID_HANDLE_VALUE &&
+	    GetFileInformationByHandle(handle, &info)) {
+		id.device = info.dwVolumeSerialNumber;
+		id.index = (uint64_t(info.nFileIndexHigh) << 32) |
+			   info.nFileIndexLow;
+	}
+#else
+	struct stat info;
+	if (fstat(file.handle(), &info) == 0) {
+		id.device = uint64_t(info.st_dev);
+		id.index = uint64_t(info.st_ino);
+	}
+#endif
+	return id;
+}
+
+static void extractLines(QByteArray &data, QStringList &lines)
+{
+	auto end = data.indexOf('\n');
+	decltype(end) start = 0;
+	for (; end != -1; end = data.indexOf('\n', start)) {
+		auto line = data.mid(start, end - start);
+		if (line.endsWith('\r')) {
+			line.chop(1);
+		}
+		lines << QString::fromUtf8(line);
+		start = end + 1;
+	}
+	data.remove(0, start);
+
+	if (data.size() > maxLineLength) {
+		lines << QString::fromUtf8(data);
+		data.clear();
+	}
+}
+
+QStringList FileTail::ReadNewLines()
+{
+	QFile file(_path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		// A file created later on will be read from the start
+		Reset();
+		_initialized = true;
+		return {};
+	}
+
+	const auto size = file.size();
+	const auto head = file.read(std::min(size, headSize));
+	const auto id = getFileId(file);
+	if (!_initialized) {
+		_initialized = true;
+		_offset = size;
+		_head = head;
+		_id = id;
+		return {};
+	}
+
+	// A new file with the same beginning and at least the same size, as
+	// created by log rotation, can only be detected by its ID
+	const bool replaced = size < _offset || !head.startsWith(_head) ||
+			      (id.IsValid() && _id.IsValid() && id != _id);
+	if (replaced) {
+		Reset();
+	}
+	_head = head;
+	_id = id;
+	if (size == _offset) {
+		return {};
+	}
+
+	if (!file.seek(_offset)) {
+		return {};
+	}
+	const auto data = file.read(std::min(size - _offset, maxReadSize));
+	_offset += data.size();
+	_partialLine += data;
+
+	QStringList lines;
+	extractLines(_partialLine, lines);
+	return lines;
+}
+
+} // namespace advss
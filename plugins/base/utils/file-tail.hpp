@@ -0,0 +1,46 @@
+#pragma once
+#include <QByteArray>
+#include <QString>
+#include <QStringList>
+
+#include <cstdint>
+
+namespace advss {
+
+// Reads the lines appended to a growing text file, like a log file, without
+// reading the whole file again.
+// If the file is truncated or replaced by a new one, as done by log rotation,
+// the new content is read from the start.
+class FileTail {
+public:
+	void SetPath(const QString &path);
+	// Returns the complete lines appended since the last call.
+	// Content which already existed when the file was first read is
+	// skipped.
+	QStringList ReadNewLines();
+
+	// Identifies the file independent of its path, like the inode number
+	struct FileId {
+		uint64_t device = 0;
+		uint64_t index = 0;
+		bool IsValid() const { return device != 0 || index != 0; }
+		bool operator!=(const FileId &other) const
+		{
+			return device != other.device || index != other.index;
+		}
+	};
+
+private:
+	void Reset();
+
+	QString _path;
+	bool _initialized = false;
+	qint64 _offset = 0;
+	// The first bytes of the file and its ID to detect if it was replaced
+	QByteArray _head;
+	FileId _id;
+	// Not yet terminated line at the end of the file
+	QByteArray _partialLine;
+};
+
+} // namespace advss
@@ -0,0 +1,176 @@
+#include "file-watch.hpp"
+#include "plugin-state-helpers.hpp"
+
+#include <QCoreApplication>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace advss {
+
+static std::mutex watchesMutex;
+static std::map<QString, std::weak_ptr<FileWatch>> watches;
+
+// Only accessed on the main thread
+static QFileSystemWatcher *watcher = nullptr;
+
+static bool setup();
+static bool setupDone = setup();
+
+static bool setup()
+{
+	AddPluginCleanupStep([]() {
+		delete watcher;
+		watcher = nullptr;
+	});
+	return true;
+}
+
+static QString getDirectory(const QString &path)
+{
+	return QFileInfo(path).absolutePath();
+}
+
+static void runOnMainThread(std::function<void()> function)
+{
+	QMetaObject::invokeMethod(QCoreApplication::instance(), function,
+				  Qt::QueuedConnection);
+}
+
+FileWatch::FileWatch(const QString &path) : _path(path) {}
+
+FileWatch::~FileWatch()
+{
+	{
+		std::lock_guard<std::mutex> lock(watchesMutex);
+		auto it = watches.find(_path);
+		// A new watch might have already replaced this one
+		if (it != watches.end() && it->second.expired()) {
+			watches.erase(it);
+		}
+	}
+	const auto path = _path;
+	runOnMainThread([path]() { Stop(path); });
+}
+
+std::shared_ptr<FileWatch> FileWatch::Get(const QString &path)
+{
+	if (path.isEmpty()) {
+		return {};
+	}
+
+	const auto absolutePath = QFileInfo(path).absoluteFilePath();
+	std::lock_guard<std::mutex> lock(watchesMutex);
+	auto &entry = watches[absolutePath];
+	auto watch = entry.lock();
+	if (!watch) {
+		watch = std::shared_ptr<FileWatch>(new FileWatch(absolutePath));
+		entry = watch;
+		runOnMainThread([absolutePath]() { Start(absolutePath); });
+	}
+	return watch;
+}
+
+uint64_t FileWatch::GetGeneration() const
+{
+	return _generation.load(std::memory_order_acquire);
+}
+
+void FileWatch::Start(const QString &path)
+{
+	if (!watcher) {
+		watcher = new QFileSystemWatcher();
+		QObject::connect(watcher, &QFileSystemWatcher::fileChanged,
+				 &FileWatch::FileChanged);
+		QObject::connect(watcher, &QFileSystemWatcher::directoryChanged,
+				 &FileWatch::DirectoryChanged);
+	}
+
+	// The directory is watched as well to notice the file being created
+	// again after it was removed or replaced
+	const auto directory = getDirectory(path);
+	if (!watcher->directories().contains(directory)) {
+		watcher->addPath(directory);
+	}
+	if (!watcher->files().contains(path) && QFileInfo::exists(path)) {
+		watcher->addPath(path);
+	}
+
+	// Changes which happened before the watch was active might have been
+	// missed
+	Notify(path);
+}
+
+void FileWatch::Stop(const QString &path)
+{
+	if (!watcher) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(watchesMutex);
+	if (watches.count(path)) {
+		return;
+	}
+	watcher->removePath(path);
+
+	const auto directory = getDirectory(path);
+	for (const auto &[watchedPath, _] : watches) {
+		if (getDirectory(watchedPath) == directory) {
+			return;
+		}
+	}
+	watcher->removePath(directory);
+}
+
+void FileWatch::FileChanged(const QString &path)
+{
+	// Removing or replacing a file removes it from the watcher
+	if (!watcher->files().contains(path) && QFileInfo::exists(path)) {
+		watcher->addPath(path);
+	}
+	Notify(path);
+}
+
+void FileWatch::DirectoryChanged(const QString &directory)
+{
+	std::vector<QString> paths;
+	{
+		std::lock_guard<std::mutex> lock(watchesMutex);
+		for (const auto &[path, _] : watches) {
+			if (getDirectory(path) == directory &&
+			    !watcher->files().contains(path)) {
+				paths.push_back(path);
+			}
+		}
+	}
+
+	// Only files which are not watched themselves, as they did not exist,
+	// are of interest here
+	for (const auto &path : paths) {
+		if (QFileInfo::exists(path)) {
+			watcher->addPath(path);
+			Notify(path);
+		}
+	}
+}
+
+void FileWatch::Notify(const QString &path)
+{
+	std::shared_ptr<FileWatch> watch;
+	{
+		std::lock_guard<std::mutex> lock(watchesMutex);
+		auto it = watches.find(path);
+		if (it == watches.end()) {
+			return;
+		}
+		watch = it->second.lock();
+	}
+	if (watch) {
+		watch->_generation.fetch_add(1, std::memory_order_release);
+	}
+}
+
+} // namespace advss
@@ -0,0 +1,36 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <QString>
+
+namespace advss {
+
+// Tracks modifications of a file using the file system notifications of the
+// operating system, like inotify, instead of polling it.
+// All users interested in the same file share a single watch and all watches
+// share a single QFileSystemWatcher living on the main thread.
+class FileWatch {
+public:
+	~FileWatch();
+
+	// Returns the watch of the given file, which is created if necessary.
+	// The file does not have to exist yet.
+	static std::shared_ptr<FileWatch> Get(const QString &path);
+
+	// Changes whenever the file was modified, created, removed or replaced
+	uint64_t GetGeneration() const;
+
+private:
+	explicit FileWatch(const QString &path);
+
+	static void Start(const QString &path);
+	static void Stop(const QString &path);
+	static void FileChanged(const QString &path);
+	static void DirectoryChanged(const QString &path);
+	static void Notify(const QString &path);
+
+	const QString _path;
+	std::atomic<uint64_t> _generation{0};
+};
+
+} // namespace advss
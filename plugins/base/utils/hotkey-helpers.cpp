@@ -6,6 +6,7 @@ namespace advss {
 
 std::vector<std::weak_ptr<Hotkey>> Hotkey::_registeredHotkeys = {};
 uint32_t Hotkey::_hotkeyCounter = 0;
+std::mutex Hotkey::_mutex;
 
 static bool setup()
 {
@@ -17,6 +18,8 @@ static bool setupDone = setup();
 std::shared_ptr<Hotkey> Hotkey::GetHotkey(const std::string &description,
 					  bool ignoreExistingHotkeys)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
+
 	// Clean up expired hotkeys
 	auto it = _registeredHotkeys.begin();
 	while (it != _registeredHotkeys.end()) {
@@ -66,6 +69,7 @@ bool Hotkey::Save(obs_data_t *obj) const
 bool Hotkey::Load(obs_data_t *obj)
 {
 	auto description = obs_data_get_string(obj, "desc");
+	std::lock_guard<std::mutex> lock(_mutex);
 	if (!DescriptionAvailable(description)) {
 		return false;
 	}
@@ -85,6 +89,7 @@ Hotkey::~Hotkey()
 
 bool Hotkey::UpdateDescription(const std::string &descritpion)
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	if (!DescriptionAvailable(descritpion)) {
 		return false;
 	}
@@ -95,6 +100,12 @@ bool Hotkey::UpdateDescription(const std::string &descritpion)
 	return true;
 }
 
+std::string Hotkey::GetDescription() const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	return _description;
+}
+
 bool Hotkey::DescriptionAvailable(const std::string &descritpion)
 {
 	for (const auto &hotkey : _registeredHotkeys) {
@@ -130,6 +141,7 @@ std::string Hotkey::GetNameFromDescription(const std::string &description)
 
 void Hotkey::ClearAllHotkeys()
 {
+	std::lock_guard<std::mutex> lock(_mutex);
 	_registeredHotkeys.clear();
 }
 
@@ -1,6 +1,7 @@
 #pragma once
 #include <chrono>
 #include <memory>
+#include <mutex>
 #include <obs.hpp>
 #include <string>
 #include <vector>
@@ -28,16 +29,18 @@ public:
 	bool GetPressed() const { return _pressed; }
 	auto GetLastPressed() const { return _lastPressed; }
 	auto GetLastReleased() const { return _lastReleased; }
-	std::string GetDescription() const { return _description; }
+	std::string GetDescription() const;
 	bool UpdateDescription(const std::string &);
 
 private:
+	// Must be called with _mutex locked
 	static bool DescriptionAvailable(const std::string &);
 	static void Callback(void *data, obs_hotkey_id, obs_hotkey_t *,
 			     bool pressed);
 	static std::string GetNameFromDescription(const std::string &desc);
 
 	static std::vector<std::weak_ptr<Hotkey>> _registeredHotkeys;
+	static std::mutex _mutex;
 	static uint32_t _hotkeyCounter;
 
 	std::string _description;
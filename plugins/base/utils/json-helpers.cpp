@@ -1,6 +1,7 @@
 #include "json-helpers.hpp"
 
 #include <QJsonDocument>
+#include <QJsonObject>
 
 namespace advss {
 
@@ -21,6 +22,16 @@ QString FormatJsonString(QString json)
 bool MatchJson(const std::string &json1, const std::string &json2,
 	       const RegexConfig &regex)
 {
+	if (!regex.Enabled()) {
+		const auto doc1 = QJsonDocument::fromJson(
+			QByteArray::fromStdString(json1));
+		const auto doc2 = QJsonDocument::fromJson(
+			QByteArray::fromStdString(json2));
+		if (doc1.isObject() && doc2.isObject()) {
+			return JsonContains(doc1.object(), doc2.object());
+		}
+	}
+
 	auto j1 = FormatJsonString(json1).toStdString();
 	auto j2 = FormatJsonString(json2).toStdString();
 
@@ -37,4 +48,26 @@ bool MatchJson(const std::string &json1, const std::string &json2,
 	return j1 == j2;
 }
 
+bool JsonContains(const QJsonValue &actual, const QJsonValue &expected)
+{
+	if (!expected.isObject()) {
+		return actual == expected;
+	}
+	if (!actual.isObject()) {
+		return false;
+	}
+
+	const auto actualObject = actual.toObject();
+	const auto expectedObject = expected.toObject();
+	for (auto it = expectedObject.begin(); it != expectedObject.end();
+	     ++it) {
+		auto value = actualObject.constFind(it.key());
+		if (value == actualObject.constEnd() ||
+		    !JsonContains(*value, it.value())) {
+			return false;
+		}
+	}
+	return true;
+}
+
 } // namespace advss
@@ -1,4 +1,5 @@
 #pragma once
+#include <QJsonValue>
 #include <QString>
 #include <string>
 #include <regex-config.hpp>
@@ -7,7 +8,14 @@ namespace advss {
 
 QString FormatJsonString(std::string);
 QString FormatJsonString(QString);
+// If regular expressions are disabled and both values are JSON objects, only
+// the values specified in the second one are compared
 bool MatchJson(const std::string &json1, const std::string &json2,
 	       const RegexConfig &regex);
+// Checks if all values of the expected JSON are present in the actual JSON.
+// Nested objects are compared the same way, so keys which are not part of the
+// expected JSON are ignored, while all other values, like arrays, must be
+// equal.
+bool JsonContains(const QJsonValue &actual, const QJsonValue &expected);
 
 } // namespace advss
@@ -0,0 +1,243 @@
+#include "osc-decoder.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace advss {
+
+static constexpr int maxBundleDepth = 8;
+
+static bool readUInt32(const char *&data, const char *end, uint32_t &value)
+{
+	if (end - data < 4) {
+		return false;
+	}
+	value = 0;
+	for (int i = 0; i < 4; i++) {
+		value = (value << 8) | static_cast<unsigned char>(data[i]);
+	}
+	data += 4;
+	return true;
+}
+
+static bool readUInt64(const char *&data, const char *end, uint64_t &value)
+{
+	uint32_t high, low;
+	if (!readUInt32(data, end, high) || !readUInt32(data, end, low)) {
+		return false;
+	}
+	value = (static_cast<uint64_t>(high) << 32) | low;
+	return true;
+}
+
+static bool readPaddedString(const char *&data, const char *end,
+			     std::string &value)
+{
+	const auto terminator = static_cast<const char *>(
+		memchr(data, '\0', static_cast<size_t>(end - data)));
+	if (!terminator) {
+		return false;
+	}
+	value.assign(data, terminator);
+	const auto paddedLength = (terminator - data + 4) & ~0x3;
+	if (paddedLength > end - data) {
+		return false;
+	}
+	data += paddedLength;
+	return true;
+}
+
+static std::string formatNumber(double value)
+{
+	char buffer[32];
+	snprintf(buffer, sizeof(buffer), "%g", value);
+	return buffer;
+}
+
+static bool readArgument(char typeTag, const char *&data, const char *end,
+			 std::string &value)
+{
+	uint32_t value32;
+	uint64_t value64;
+	switch (typeTag) {
+	case 'i':
+	case 'r':
+	case 'm':
+		if (!readUInt32(data, end, value32)) {
+			return false;
+		}
+		value = std::to_string(static_cast<int32_t>(value32));
+		return true;
+	case 'c':
+		if (!readUInt32(data, end, value32)) {
+			return false;
+		}
+		value = std::string(1, static_cast<char>(value32));
+		return true;
+	case 'f': {
+		if (!readUInt32(data, end, value32)) {
+			return false;
+		}
+		float f;
+		memcpy(&f, &value32, sizeof(f));
+		value = formatNumber(f);
+		return true;
+	}
+	case 'h':
+	case 't':
+		if (!readUInt64(data, end, value64)) {
+			return false;
+		}
+		value = typeTag == 'h'
+				? std::to_string(static_cast<int64_t>(value64))
+				: std::to_string(value64);
+		return true;
+	case 'd': {
+		if (!readUInt64(data, end, value64)) {
+			return false;
+		}
+		double d;
+		memcpy(&d, &value64, sizeof(d));
+		value = formatNumber(d);
+		return true;
+	}
+	case 's':
+	case 'S':
+		return readPaddedString(data, end, value);
+	case 'b': {
+		if (!readUInt32(data, end, value32)) {
+			return false;
+		}
+		const uint64_t paddedSize = (uint64_t(value32) + 3) & ~0x3ull;
+		if (paddedSize > static_cast<uint64_t>(end - data)) {
+			return false;
+		}
+		// Same representation as used when sending blobs
+		value.clear();
+		char byte[8];
+		for (uint32_t i = 0; i < value32; i++) {
+			snprintf(byte, sizeof(byte), "0x%02x ",
+				 static_cast<unsigned char>(data[i]));
+			value += byte;
+		}
+		if (!value.empty()) {
+			value.pop_back();
+		}
+		data += paddedSize;
+		return true;
+	}
+	case 'T':
+		value = "true";
+		return true;
+	case 'F':
+		value = "false";
+		return true;
+	case 'N':
+		value = "null";
+		return true;
+	case 'I':
+		value = "infinity";
+		return true;
+	default:
+		return false;
+	}
+}
+
+static bool decodeMessage(const char *data, const char *end,
+			  std::vector<OSCReceivedMessage> &messages)
+{
+	OSCReceivedMessage message;
+	if (!readPaddedString(data, end, message.address)) {
+		return false;
+	}
+
+	// Type tags might be omitted by older implementations
+	std::string typeTags;
+	if (data != end && (!readPaddedString(data, end, typeTags) ||
+			    typeTags.empty() || typeTags[0] != ',')) {
+		return false;
+	}
+
+	for (size_t i = 1; i < typeTags.size(); i++) {
+		// Arrays are flattened
+		if (typeTags[i] == '[' || typeTags[i] == ']') {
+			continue;
+		}
+		std::string value;
+		if (!readArgument(typeTags[i], data, end, value)) {
+			return false;
+		}
+		message.arguments.emplace_back(std::move(value));
+	}
+	messages.emplace_back(std::move(message));
+	return true;
+}
+
+static bool decodePacket(const char *data, const char *end,
+			 std::vector<OSCReceivedMessage> &messages, int depth)
+{
+	const auto size = static_cast<size_t>(end - data);
+	if (size >= sizeof(oscBundleHeader) &&
+	    memcmp(data, oscBundleHeader, sizeof(oscBundleHeader)) == 0) {
+		if (depth >= maxBundleDepth) {
+			return false;
+		}
+		uint64_t timeTag;
+		data += sizeof(oscBundleHeader);
+		if (!readUInt64(data, end, timeTag)) {
+			return false;
+		}
+		while (data != end) {
+			uint32_t elementSize;
+			if (!readUInt32(data, end, elementSize) ||
+			    elementSize % 4 != 0 ||
+			    elementSize > static_cast<size_t>(end - data)) {
+				return false;
+			}
+			if (!decodePacket(data, data + elementSize, messages,
+					  depth + 1)) {
+				return false;
+			}
+			data += elementSize;
+		}
+		return true;
+	}
+
+	if (size == 0 || *data != '/') {
+		return false;
+	}
+	return decodeMessage(data, end, messages);
+}
+
+bool DecodeOSCPacket(const char *data, size_t size,
+		     std::vector<OSCReceivedMessage> &messages)
+{
+	// The size of OSC packets is always a multiple of 4
+	if (size % 4 != 0) {
+		return false;
+	}
+	return decodePacket(data, data + size, messages, 0);
+}
+
+std::string OSCReceivedMessage::GetArgumentsString() const
+{
+	std::string result;
+	for (const auto &argument : arguments) {
+		if (!result.empty()) {
+			result += " ";
+		}
+		result += argument;
+	}
+	return result;
+}
+
+std::string OSCReceivedMessage::ToString() const
+{
+	if (arguments.empty()) {
+		return address;
+	}
+	return address + " " + GetArgumentsString();
+}
+
+} // namespace advss
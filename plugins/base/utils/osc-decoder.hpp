@@ -0,0 +1,23 @@
+#pragma once
+#include <string>
+#include <vector>
+
+namespace advss {
+
+constexpr char oscBundleHeader[] = "#bundle";
+
+struct OSCReceivedMessage {
+	std::string address;
+	// Text representation of each argument
+	std::vector<std::string> arguments;
+
+	std::string GetArgumentsString() const;
+	std::string ToString() const;
+};
+
+// Decodes an OSC message or bundle.
+// Returns false if the packet is malformed.
+bool DecodeOSCPacket(const char *data, size_t size,
+		     std::vector<OSCReceivedMessage> &messages);
+
+} // namespace advss
@@ -0,0 +1,584 @@
+#include "osc-transport.hpp"
+#include "log-helper.hpp"
+#include "message-dispatcher.hpp"
+#include "plugin-state-helpers.hpp"
+
+#include <algorithm>
+#include <asio.hpp>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <tuple>
+
+namespace advss {
+
+using namespace std::chrono_literals;
+
+// Messages sent to the same destination within this time are combined into
+// a single bundle
+static constexpr auto batchWindow = 1ms;
+static constexpr size_t maxUDPPacketSize = 65507;
+// Bundles sent via UDP are kept below the common Ethernet MTU, as a single
+// lost fragment would cause the whole bundle to be dropped
+static constexpr size_t maxUDPBundleSize = 1472;
+// Connections to destinations, which are no longer used, are closed after
+// this time
+static constexpr auto connectionIdleTimeout = 60s;
+static constexpr size_t maxPendingPackets = 1024;
+
+namespace {
+
+struct Destination {
+	OSCProtocol protocol;
+	std::string host;
+	int port;
+
+	bool operator<(const Destination &other) const
+	{
+		return std::tie(protocol, host, port) <
+		       std::tie(other.protocol, other.host, other.port);
+	}
+};
+
+struct Connection {
+	explicit Connection(asio::io_context &ctx)
+		: batchTimer(ctx),
+		  idleTimer(ctx),
+		  udpResolver(ctx),
+		  udpSocket(ctx),
+		  tcpResolver(ctx),
+		  tcpSocket(ctx)
+	{
+	}
+
+	// Protected by the mutex of the transport
+	std::vector<std::vector<char>> pending;
+	bool flushScheduled = false;
+
+	// Only accessed by the network thread
+	asio::steady_timer batchTimer;
+	asio::steady_timer idleTimer;
+	asio::ip::udp::resolver udpResolver;
+	asio::ip::udp::socket udpSocket;
+	asio::ip::udp::endpoint udpEndpoint;
+	bool resolvingUDP = false;
+	size_t udpSendsInProgress = 0;
+	asio::ip::tcp::resolver tcpResolver;
+	asio::ip::tcp::socket tcpSocket;
+	// Resolving the host is part of connecting
+	enum class State { DISCONNECTED, CONNECTING, CONNECTED };
+	State tcpState = State::DISCONNECTED;
+	std::deque<std::vector<char>> outgoing;
+	bool writing = false;
+};
+
+struct Listener {
+	explicit Listener(asio::io_context &ctx) : socket(ctx) {}
+
+	asio::ip::udp::socket socket;
+	asio::ip::udp::endpoint sender;
+	std::vector<char> buffer = std::vector<char>(maxUDPPacketSize);
+	MessageDispatcher<OSCReceivedMessage> dispatcher;
+	// Protected by the mutex of the transport
+	std::vector<std::weak_ptr<MessageBuffer<OSCReceivedMessage>>> clients;
+};
+
+// All network I/O is performed by a single thread shared by all OSC actions
+// and conditions
+class OSCTransport {
+public:
+	void Send(const Destination &, std::vector<char> &&message);
+	OSCMessageBuffer Register(int port);
+	void Stop();
+
+private:
+	void StartThread();
+	void Flush(const Destination &, Connection &);
+	void SendUDP(const Destination &, Connection &);
+	void SendTCP(const Destination &, Connection &);
+	void ConnectTCP(const Destination &, Connection &,
+			const asio::ip::tcp::endpoint &);
+	void ScheduleIdleCheck(const Destination &, Connection &);
+	void RemoveIfIdle(const Destination &, Connection &);
+	void Receive(const std::shared_ptr<Listener> &);
+	void RemoveUnusedListeners(int keepPort);
+
+	using WorkGuard =
+		asio::executor_work_guard<asio::io_context::executor_type>;
+
+	std::unique_ptr<asio::io_context> _ctx;
+	std::optional<WorkGuard> _work;
+	std::thread _thread;
+	std::mutex _mutex;
+	std::map<Destination, std::unique_ptr<Connection>> _connections;
+	std::map<int, std::shared_ptr<Listener>> _listeners;
+};
+
+} // namespace
+
+static OSCTransport transport;
+
+static bool setup();
+static bool setupDone = setup();
+
+static bool setup()
+{
+	AddPluginCleanupStep([]() { transport.Stop(); });
+	return true;
+}
+
+static const char *protocolName(OSCProtocol protocol)
+{
+	return protocol == OSCProtocol::UDP ? "UDP" : "TCP";
+}
+
+static void appendInt32(std::vector<char> &buffer, uint32_t value)
+{
+	for (int shift = 24; shift >= 0; shift -= 8) {
+		buffer.push_back(static_cast<char>((value >> shift) & 0xFF));
+	}
+}
+
+static std::vector<std::vector<char>>
+createPackets(std::vector<std::vector<char>> &messages, size_t maxPacketSize)
+{
+	std::vector<std::vector<char>> packets;
+	if (messages.size() == 1) {
+		packets.emplace_back(std::move(messages.front()));
+		return packets;
+	}
+
+	std::vector<char> bundle;
+	for (const auto &message : messages) {
+		if (!bundle.empty() &&
+		    bundle.size() + 4 + message.size() > maxPacketSize) {
+			packets.emplace_back(std::move(bundle));
+			bundle.clear();
+		}
+		if (bundle.empty()) {
+			bundle.insert(bundle.end(), std::begin(oscBundleHeader),
+				      std::end(oscBundleHeader));
+			// Time tag 1 means "immediately"
+			appendInt32(bundle, 0);
+			appendInt32(bundle, 1);
+		}
+		appendInt32(bundle, static_cast<uint32_t>(message.size()));
+		bundle.insert(bundle.end(), message.begin(), message.end());
+	}
+	packets.emplace_back(std::move(bundle));
+	return packets;
+}
+
+template<class Protocol, class Callback>
+static void resolve(typename Protocol::resolver &resolver,
+		    const Destination &destination, const Callback &callback)
+{
+	using Endpoint = typename Protocol::endpoint;
+	using Results = typename Protocol::resolver::results_type;
+	resolver.async_resolve(
+		destination.host, std::to_string(destination.port),
+		[destination, callback](const asio::error_code &ec,
+					const Results &results) {
+			if (ec || results.empty()) {
+				blog(LOG_WARNING,
+				     "failed to get IP for \"%s\": %s",
+				     destination.host.c_str(),
+				     ec.message().c_str());
+				callback(std::optional<Endpoint>());
+				return;
+			}
+			// Prefer IPv4 addresses
+			for (const auto &entry : results) {
+				if (entry.endpoint().address().is_v4()) {
+					callback(std::optional<Endpoint>(
+						entry.endpoint()));
+					return;
+				}
+			}
+			callback(std::optional<Endpoint>(
+				results.begin()->endpoint()));
+		});
+}
+
+void OSCTransport::StartThread()
+{
+	if (_thread.joinable()) {
+		return;
+	}
+	_ctx = std::make_unique<asio::io_context>();
+	_work.emplace(asio::make_work_guard(*_ctx));
+	_thread = std::thread([this]() { _ctx->run(); });
+}
+
+void OSCTransport::Stop()
+{
+	std::unique_lock<std::mutex> lock(_mutex);
+	if (!_thread.joinable()) {
+		return;
+	}
+	_work.reset();
+	_ctx->stop();
+	auto thread = std::move(_thread);
+
+	// The network thread might be waiting for the mutex
+	lock.unlock();
+	thread.join();
+	lock.lock();
+
+	// Sockets have to be closed before the context is destroyed
+	_connections.clear();
+	_listeners.clear();
+	_ctx.reset();
+}
+
+void OSCTransport::Send(const Destination &destination,
+			std::vector<char> &&message)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	StartThread();
+
+	auto &connection = _connections[destination];
+	if (!connection) {
+		connection = std::make_unique<Connection>(*_ctx);
+	}
+	if (connection->pending.size() >= maxPendingPackets) {
+		blog(LOG_WARNING,
+		     "dropping OSC message to %s %s %d: too many messages pending",
+		     protocolName(destination.protocol),
+		     destination.host.c_str(), destination.port);
+		return;
+	}
+	connection->pending.emplace_back(std::move(message));
+	if (connection->flushScheduled) {
+		return;
+	}
+	connection->flushScheduled = true;
+
+	auto conn = connection.get();
+	asio::post(*_ctx, [this, destination, conn]() {
+		conn->batchTimer.expires_after(batchWindow);
+		conn->batchTimer.async_wait(
+			[this, destination, conn](const asio::error_code &ec) {
+				if (ec) {
+					return;
+				}
+				Flush(destination, *conn);
+			});
+	});
+}
+
+void OSCTransport::Flush(const Destination &destination,
+			 Connection &connection)
+{
+	std::vector<std::vector<char>> messages;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		messages.swap(connection.pending);
+		connection.flushScheduled = false;
+	}
+	if (messages.empty()) {
+		return;
+	}
+
+	const bool isUDP = destination.protocol == OSCProtocol::UDP;
+	auto packets = createPackets(messages, isUDP ? maxUDPBundleSize
+						     : SIZE_MAX);
+	for (auto &packet : packets) {
+		if (connection.outgoing.size() >= maxPendingPackets) {
+			blog(LOG_WARNING,
+			     "dropping OSC message to %s %s %d: too many messages pending",
+			     protocolName(destination.protocol),
+			     destination.host.c_str(), destination.port);
+			break;
+		}
+		connection.outgoing.emplace_back(std::move(packet));
+	}
+
+	if (isUDP) {
+		SendUDP(destination, connection);
+	} else {
+		SendTCP(destination, connection);
+	}
+	ScheduleIdleCheck(destination, connection);
+}
+
+void OSCTransport::ScheduleIdleCheck(const Destination &destination,
+				     Connection &connection)
+{
+	connection.idleTimer.expires_after(connectionIdleTimeout);
+	connection.idleTimer.async_wait(
+		[this, destination, &connection](const asio::error_code &ec) {
+			if (ec) {
+				return;
+			}
+			RemoveIfIdle(destination, connection);
+		});
+}
+
+void OSCTransport::RemoveIfIdle(const Destination &destination,
+				Connection &connection)
+{
+	const bool busy =
+		connection.resolvingUDP || connection.udpSendsInProgress > 0 ||
+		connection.tcpState == Connection::State::CONNECTING ||
+		connection.writing || !connection.outgoing.empty();
+
+	std::unique_ptr<Connection> idleConnection;
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		if (connection.flushScheduled) {
+			// The check will be rescheduled once flushed
+			return;
+		}
+		auto it = _connections.find(destination);
+		if (!busy && it != _connections.end() &&
+		    it->second.get() == &connection) {
+			idleConnection = std::move(it->second);
+			_connections.erase(it);
+		}
+	}
+
+	if (!idleConnection) {
+		ScheduleIdleCheck(destination, connection);
+		return;
+	}
+	vblog(LOG_INFO, "closing idle OSC connection to %s %s %d",
+	      protocolName(destination.protocol), destination.host.c_str(),
+	      destination.port);
+}
+
+void OSCTransport::SendUDP(const Destination &destination,
+			   Connection &connection)
+{
+	if (!connection.udpSocket.is_open()) {
+		if (connection.resolvingUDP) {
+			// Messages will be sent once resolved
+			return;
+		}
+		connection.resolvingUDP = true;
+		resolve<asio::ip::udp>(
+			connection.udpResolver, destination,
+			[this, destination, &connection](const auto &endpoint) {
+				connection.resolvingUDP = false;
+				if (!endpoint) {
+					connection.outgoing.clear();
+					return;
+				}
+				asio::error_code ec;
+				connection.udpSocket.open(endpoint->protocol(),
+							  ec);
+				if (ec) {
+					blog(LOG_WARNING,
+					     "failed to connect to UDP %s %d: %s",
+					     destination.host.c_str(),
+					     destination.port,
+					     ec.message().c_str());
+					connection.outgoing.clear();
+					return;
+				}
+				connection.udpEndpoint = *endpoint;
+				SendUDP(destination, connection);
+			});
+		return;
+	}
+
+	while (!connection.outgoing.empty()) {
+		auto packet = std::make_shared<std::vector<char>>(
+			std::move(connection.outgoing.front()));
+		connection.outgoing.pop_front();
+		connection.udpSendsInProgress++;
+		connection.udpSocket.async_send_to(
+			asio::buffer(*packet), connection.udpEndpoint,
+			[packet, destination,
+			 &connection](const asio::error_code &ec, size_t) {
+				connection.udpSendsInProgress--;
+				if (!ec) {
+					return;
+				}
+				blog(LOG_WARNING,
+				     "failed to send OSC message via UDP %s %d: %s",
+				     destination.host.c_str(),
+				     destination.port, ec.message().c_str());
+				// Resolve the host again for the next message
+				asio::error_code closeError;
+				connection.udpSocket.close(closeError);
+			});
+	}
+}
+
+static void disconnectTCP(Connection &connection)
+{
+	asio::error_code ec;
+	connection.tcpSocket.close(ec);
+	connection.tcpState = Connection::State::DISCONNECTED;
+	connection.outgoing.clear();
+}
+
+void OSCTransport::SendTCP(const Destination &destination,
+			   Connection &connection)
+{
+	switch (connection.tcpState) {
+	case Connection::State::DISCONNECTED:
+		connection.tcpState = Connection::State::CONNECTING;
+		resolve<asio::ip::tcp>(
+			connection.tcpResolver, destination,
+			[this, destination, &connection](const auto &endpoint) {
+				if (!endpoint) {
+					disconnectTCP(connection);
+					return;
+				}
+				ConnectTCP(destination, connection, *endpoint);
+			});
+		return;
+	case Connection::State::CONNECTING:
+		// Messages will be sent once connected
+		return;
+	case Connection::State::CONNECTED:
+		break;
+	}
+
+	if (connection.writing || connection.outgoing.empty()) {
+		return;
+	}
+	connection.writing = true;
+	asio::async_write(
+		connection.tcpSocket, asio::buffer(connection.outgoing.front()),
+		[this, destination,
+		 &connection](const asio::error_code &ec, size_t) {
+			connection.writing = false;
+			if (ec) {
+				blog(LOG_WARNING,
+				     "failed to send OSC message via TCP %s %d: %s",
+				     destination.host.c_str(), destination.port,
+				     ec.message().c_str());
+				disconnectTCP(connection);
+				return;
+			}
+			connection.outgoing.pop_front();
+			SendTCP(destination, connection);
+		});
+}
+
+void OSCTransport::ConnectTCP(const Destination &destination,
+			      Connection &connection,
+			      const asio::ip::tcp::endpoint &endpoint)
+{
+	connection.tcpSocket.async_connect(
+		endpoint,
+		[this, destination, &connection](const asio::error_code &ec) {
+			if (ec) {
+				blog(LOG_WARNING,
+				     "failed to connect to TCP %s %d: %s",
+				     destination.host.c_str(), destination.port,
+				     ec.message().c_str());
+				disconnectTCP(connection);
+				return;
+			}
+			connection.tcpState = Connection::State::CONNECTED;
+			SendTCP(destination, connection);
+		});
+}
+
+OSCMessageBuffer OSCTransport::Register(int port)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	StartThread();
+	// The listener of the requested port is kept, even if it is currently
+	// unused, as its socket is still bound to the port
+	RemoveUnusedListeners(port);
+
+	auto it = _listeners.find(port);
+	if (it != _listeners.end()) {
+		auto buffer = it->second->dispatcher.RegisterClient();
+		it->second->clients.emplace_back(buffer);
+		return buffer;
+	}
+
+	auto listener = std::make_shared<Listener>(*_ctx);
+	auto buffer = listener->dispatcher.RegisterClient();
+	asio::error_code ec;
+	listener->socket.open(asio::ip::udp::v4(), ec);
+	if (!ec) {
+		// The sockets of removed listeners are only closed by the
+		// network thread, so they might still be bound to the port
+		listener->socket.set_option(
+			asio::ip::udp::socket::reuse_address(true), ec);
+	}
+	if (!ec) {
+		listener->socket.bind(
+			asio::ip::udp::endpoint(asio::ip::udp::v4(), port), ec);
+	}
+	if (ec) {
+		// Not stored, so the next registration tries again
+		blog(LOG_WARNING,
+		     "failed to listen for OSC messages on UDP port %d: %s",
+		     port, ec.message().c_str());
+		return buffer;
+	}
+
+	listener->clients.emplace_back(buffer);
+	_listeners[port] = listener;
+	asio::post(*_ctx, [this, listener]() { Receive(listener); });
+	return buffer;
+}
+
+void OSCTransport::RemoveUnusedListeners(int keepPort)
+{
+	for (auto it = _listeners.begin(); it != _listeners.end();) {
+		auto &clients = it->second->clients;
+		clients.erase(std::remove_if(clients.begin(), clients.end(),
+					     [](const auto &client) {
+						     return client.expired();
+					     }),
+			      clients.end());
+		if (!clients.empty() || it->first == keepPort) {
+			++it;
+			continue;
+		}
+		asio::post(*_ctx, [listener = it->second]() {
+			asio::error_code ec;
+			listener->socket.close(ec);
+		});
+		it = _listeners.erase(it);
+	}
+}
+
+void OSCTransport::Receive(const std::shared_ptr<Listener> &listener)
+{
+	listener->socket.async_receive_from(
+		asio::buffer(listener->buffer), listener->sender,
+		[this, listener](const asio::error_code &ec, size_t size) {
+			if (!listener->socket.is_open() ||
+			    ec == asio::error::operation_aborted) {
+				return;
+			}
+			if (!ec) {
+				std::vector<OSCReceivedMessage> messages;
+				if (!DecodeOSCPacket(listener->buffer.data(),
+						     size, messages)) {
+					vblog(LOG_INFO,
+					      "received malformed OSC packet");
+				}
+				for (auto &message : messages) {
+					listener->dispatcher.DispatchMessage(
+						std::move(message));
+				}
+			}
+			Receive(listener);
+		});
+}
+
+void SendOSCMessage(OSCProtocol protocol, const std::string &host, int port,
+		    std::vector<char> &&message)
+{
+	transport.Send({protocol, host, port}, std::move(message));
+}
+
+OSCMessageBuffer RegisterForOSCMessages(int port)
+{
+	return transport.Register(port);
+}
+
+} // namespace advss
@@ -0,0 +1,26 @@
+#pragma once
+#include "message-buffer.hpp"
+#include "osc-decoder.hpp"
+
+#include <string>
+#include <vector>
+
+namespace advss {
+
+enum class OSCProtocol {
+	TCP,
+	UDP,
+};
+
+using OSCMessageBuffer = std::shared_ptr<MessageBuffer<OSCReceivedMessage>>;
+
+// Queues an encoded OSC message to be sent by the shared OSC network thread.
+// Messages sent to the same destination in quick succession are combined
+// into a single OSC bundle.
+void SendOSCMessage(OSCProtocol, const std::string &host, int port,
+		    std::vector<char> &&message);
+// Starts listening for OSC messages on the given UDP port, if not done so
+// already, and returns a buffer receiving all messages arriving on that port
+[[nodiscard]] OSCMessageBuffer RegisterForOSCMessages(int port);
+
+} // namespace advss
@@ -0,0 +1,107 @@
+#include "source-settings-cache.hpp"
+#include "json-helpers.hpp"
+#include "source-settings-helpers.hpp"
+
+#include <QJsonDocument>
+#include <unordered_map>
+
+namespace advss {
+
+static std::mutex cachesMutex;
+static std::unordered_map<obs_weak_source_t *,
+			  std::weak_ptr<SourceSettingsCache>>
+	caches;
+
+SourceSettingsCache::SourceSettingsCache(const OBSWeakSource &source)
+	: _source(source)
+{
+	OBSSourceAutoRelease s = obs_weak_source_get_source(source);
+	if (s) {
+		signal_handler_connect(obs_source_get_signal_handler(s),
+				       "update", SourceUpdated, this);
+	}
+}
+
+SourceSettingsCache::~SourceSettingsCache()
+{
+	// The signal handler is gone already if the source was destroyed
+	OBSSourceAutoRelease s = obs_weak_source_get_source(_source);
+	if (s) {
+		signal_handler_disconnect(obs_source_get_signal_handler(s),
+					  "update", SourceUpdated, this);
+	}
+
+	std::lock_guard<std::mutex> lock(cachesMutex);
+	auto it = caches.find(_source);
+	// A new cache might have already replaced this one
+	if (it != caches.end() && it->second.expired()) {
+		caches.erase(it);
+	}
+}
+
+std::shared_ptr<SourceSettingsCache>
+SourceSettingsCache::Get(const OBSWeakSource &source)
+{
+	if (!source) {
+		return {};
+	}
+
+	std::lock_guard<std::mutex> lock(cachesMutex);
+	auto &entry = caches[source];
+	auto cache = entry.lock();
+	if (!cache) {
+		cache = std::shared_ptr<SourceSettingsCache>(
+			new SourceSettingsCache(source));
+		entry = cache;
+	}
+	return cache;
+}
+
+void SourceSettingsCache::SourceUpdated(void *param, calldata_t *)
+{
+	auto cache = static_cast<SourceSettingsCache *>(param);
+	cache->_generation.fetch_add(1, std::memory_order_release);
+}
+
+uint64_t SourceSettingsCache::GetGeneration() const
+{
+	return _generation.load(std::memory_order_acquire);
+}
+
+void SourceSettingsCache::Update()
+{
+	const auto generation = GetGeneration();
+	if (generation == _cachedGeneration) {
+		return;
+	}
+	_cachedGeneration = generation;
+	_settings = GetSourceSettings(_source);
+	const auto doc =
+		QJsonDocument::fromJson(QByteArray::fromStdString(_settings));
+	_isObject = doc.isObject();
+	_settingsObject = doc.object();
+}
+
+std::string SourceSettingsCache::GetSettings()
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	Update();
+	return _settings;
+}
+
+bool SourceSettingsCache::Matches(const std::string &settings,
+				  const RegexConfig &regex)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	Update();
+	if (!regex.Enabled() && _isObject) {
+		const auto expected = QJsonDocument::fromJson(
+			QByteArray::fromStdString(settings));
+		if (expected.isObject()) {
+			return JsonContains(_settingsObject, expected.object());
+		}
+	}
+	return MatchJson(_settings, settings, regex);
+}
+
+} // namespace advss
@@ -0,0 +1,46 @@
+#pragma once
+#include <regex-config.hpp>
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <obs.hpp>
+#include <QJsonObject>
+#include <string>
+
+namespace advss {
+
+// Keeps the serialized settings of a source around, which are only
+// serialized again after the source signalled that its settings were
+// updated, instead of every time they are checked.
+// All users interested in the same source share a single cache.
+class SourceSettingsCache {
+public:
+	~SourceSettingsCache();
+
+	// Returns the cache of the given source, which is created if necessary
+	static std::shared_ptr<SourceSettingsCache> Get(const OBSWeakSource &);
+
+	// Changes whenever the settings of the source were updated
+	uint64_t GetGeneration() const;
+	// Returns the settings of the source as JSON
+	std::string GetSettings();
+	// Compares the settings of the source the same way MatchJson() does
+	bool Matches(const std::string &settings, const RegexConfig &);
+
+private:
+	explicit SourceSettingsCache(const OBSWeakSource &);
+	static void SourceUpdated(void *param, calldata_t *);
+	void Update();
+
+	OBSWeakSource _source;
+	std::atomic<uint64_t> _generation{1};
+
+	std::mutex _mutex;
+	uint64_t _cachedGeneration = 0;
+	std::string _settings;
+	QJsonObject _settingsObject;
+	bool _isObject = false;
+};
+
+} // namespace advss
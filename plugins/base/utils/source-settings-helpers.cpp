@@ -1,6 +1,5 @@
 #include "source-settings-helpers.hpp"
 #include "log-helper.hpp"
-#include "json-helpers.hpp"
 
 namespace advss {
 
@@ -39,12 +38,4 @@ void SetSourceSettings(obs_source_t *s, const std::string &settings)
 	obs_data_release(data);
 }
 
-bool CompareSourceSettings(const OBSWeakSource &source,
-			   const std::string &settings,
-			   const RegexConfig &regex)
-{
-	std::string currentSettings = GetSourceSettings(source);
-	return MatchJson(currentSettings, settings, regex);
-}
-
 } // namespace advss
@@ -19,6 +19,9 @@ using websocketpp::lib::bind;
 
 static constexpr char VendorRequestMessage[] = "AdvancedSceneSwitcherMessage";
 static constexpr char VendorEventMessage[] = "AdvancedSceneSwitcherEvent";
+static constexpr char RequestBatchIdPrefix[] = "AdvancedSceneSwitcherBatch";
+static constexpr size_t maxQueuedMessages = 10000;
+static constexpr size_t maxPendingBatches = 1000;
 
 static WebsocketMessageDispatcher websocketMessageDispatcher;
 
@@ -54,7 +57,7 @@ static void receiveWebsocketMessage(obs_data_t *request_data, obs_data_t *)
 	}
 
 	auto msg = obs_data_get_string(request_data, "message");
-	websocketMessageDispatcher.DispatchMessage(msg);
+	websocketMessageDispatcher.DispatchMessage(std::string(msg));
 	vblog(LOG_INFO, "received message: %s", msg);
 }
 
@@ -208,6 +211,7 @@ WSClientConnection::Status WSClientConnection::GetStatus() const
 
 void WSClientConnection::UseOBSWebsocketProtocol(bool useOBSProtocol)
 {
+	_useOBSProtocol = useOBSProtocol;
 	_client.set_open_handler(
 		bind(useOBSProtocol ? &WSClientConnection::OnOBSOpen
 				    : &WSClientConnection::OnGenericOpen,
@@ -284,7 +288,7 @@ void WSClientConnection::HandleEvent(obs_data_t *msg)
 	}
 	auto eventDataNested = obs_data_get_obj(eventData, "eventData");
 	_dispatcher.DispatchMessage(
-		obs_data_get_string(eventDataNested, "message"));
+		std::string(obs_data_get_string(eventDataNested, "message")));
 	vblog(LOG_INFO, "received event msg \"%s\"",
 	      obs_data_get_string(eventDataNested, "message"));
 	obs_data_release(eventDataNested);
@@ -317,6 +321,7 @@ void WSClientConnection::OnGenericMessage(connection_hdl,
 	}
 
 	const auto payload = message->get_payload();
+	CountReceivedMessage(payload.size());
 	_dispatcher.DispatchMessage(payload);
 	vblog(LOG_INFO, "received event msg \"%s\"", payload.c_str());
 }
@@ -332,6 +337,7 @@ void WSClientConnection::OnOBSMessage(connection_hdl,
 	}
 
 	std::string payload = message->get_payload();
+	CountReceivedMessage(payload.size());
 	const char *msg = payload.c_str();
 	auto json = obs_data_create_from_json(msg);
 	if (!json) {
@@ -360,6 +366,9 @@ void WSClientConnection::OnOBSMessage(connection_hdl,
 	case 7: // RequestResponse
 		HandleResponse(json);
 		break;
+	case 9: // RequestBatchResponse
+		HandleBatchResponse(json);
+		break;
 	default:
 		vblog(LOG_INFO, "ignoring unknown opcode %d", opcode);
 		break;
@@ -367,22 +376,191 @@ void WSClientConnection::OnOBSMessage(connection_hdl,
 	obs_data_release(json);
 }
 
+void WSClientConnection::HandleBatchResponse(obs_data_t *response)
+{
+	OBSDataAutoRelease data = obs_data_get_obj(response, "d");
+	const std::string id = obs_data_get_string(data, "requestId");
+	auto it = _pendingBatches.find(id);
+	if (it != _pendingBatches.end()) {
+		const auto roundTripTime =
+			std::chrono::duration_cast<std::chrono::microseconds>(
+				Clock::now() - it->second);
+		_pendingBatches.erase(it);
+
+		std::lock_guard<std::mutex> lock(_statsMtx);
+		_roundTripCount++;
+		_totalRoundTripTime += roundTripTime;
+		_stats.averageRoundTripTime =
+			_totalRoundTripTime / _roundTripCount;
+	}
+
+	OBSDataArrayAutoRelease results = obs_data_get_array(data, "results");
+	const size_t count = obs_data_array_count(results);
+	for (size_t i = 0; i < count; i++) {
+		OBSDataAutoRelease result = obs_data_array_item(results, i);
+		OBSDataAutoRelease status =
+			obs_data_get_obj(result, "requestStatus");
+		vblog(LOG_INFO,
+		      "received result '%d' with code '%d' (%s) for id '%s'",
+		      obs_data_get_bool(status, "result"),
+		      (int)obs_data_get_int(status, "code"),
+		      obs_data_get_string(status, "comment"),
+		      obs_data_get_string(result, "requestId"));
+	}
+}
+
 void WSClientConnection::Send(const std::string &msg)
 {
 	if (_connection.expired()) {
 		return;
 	}
+
+	std::lock_guard<std::mutex> lock(_sendMtx);
+	if (_sendQueue.size() >= maxQueuedMessages) {
+		blog(LOG_WARNING,
+		     "dropping message to '%s' as too many messages are queued",
+		     _uri.c_str());
+		return;
+	}
+	_sendQueue.push_back({msg, Clock::now()});
+	if (_flushScheduled) {
+		return;
+	}
+	_flushScheduled = true;
+	websocketpp::lib::asio::post(_client.get_io_service(),
+				     [this]() { FlushSendQueue(); });
+}
+
+static bool isOBSRequest(obs_data_t *message)
+{
+	return message && obs_data_get_int(message, "op") == 6;
+}
+
+void WSClientConnection::FlushSendQueue()
+{
+	std::vector<QueuedMessage> messages;
+	{
+		std::lock_guard<std::mutex> lock(_sendMtx);
+		messages.swap(_sendQueue);
+		_flushScheduled = false;
+	}
+	if (messages.empty()) {
+		return;
+	}
+
+	const auto now = Clock::now();
+	{
+		std::lock_guard<std::mutex> lock(_statsMtx);
+		for (const auto &message : messages) {
+			_totalQueueTime += std::chrono::duration_cast<
+				std::chrono::microseconds>(now -
+							   message.queued);
+		}
+		_stats.messagesSent += messages.size();
+		_stats.averageQueueTime =
+			_totalQueueTime / _stats.messagesSent;
+	}
+
+	if (!_useOBSProtocol || messages.size() == 1) {
+		for (const auto &message : messages) {
+			SendFrame(message.message);
+		}
+		return;
+	}
+
+	// Consecutive requests are combined into a single request batch,
+	// which obs-websocket executes in order
+	std::vector<OBSDataAutoRelease> requests;
+	size_t firstRequest = 0;
+	auto flushRequests = [&](size_t end) {
+		if (requests.size() > 1) {
+			SendRequestBatch(requests);
+		} else {
+			for (size_t i = firstRequest; i < end; i++) {
+				SendFrame(messages[i].message);
+			}
+		}
+		requests.clear();
+	};
+	for (size_t i = 0; i < messages.size(); i++) {
+		OBSDataAutoRelease json = obs_data_create_from_json(
+			messages[i].message.c_str());
+		if (!isOBSRequest(json)) {
+			flushRequests(i);
+			SendFrame(messages[i].message);
+			firstRequest = i + 1;
+			continue;
+		}
+		requests.emplace_back(std::move(json));
+	}
+	flushRequests(messages.size());
+}
+
+void WSClientConnection::SendRequestBatch(
+	std::vector<OBSDataAutoRelease> &requests)
+{
+	const std::string id = std::string(RequestBatchIdPrefix) +
+			       std::to_string(++_batchCount);
+
+	OBSDataArrayAutoRelease requestArray = obs_data_array_create();
+	for (const auto &request : requests) {
+		OBSDataAutoRelease data = obs_data_get_obj(request, "d");
+		obs_data_array_push_back(requestArray, data);
+	}
+	OBSDataAutoRelease data = obs_data_create();
+	obs_data_set_string(data, "requestId", id.c_str());
+	obs_data_set_bool(data, "haltOnFailure", false);
+	// RequestBatchExecutionType::SerialRealtime
+	obs_data_set_int(data, "executionType", 0);
+	obs_data_set_array(data, "requests", requestArray);
+	OBSDataAutoRelease batch = obs_data_create();
+	obs_data_set_int(batch, "op", 8);
+	obs_data_set_obj(batch, "d", data);
+
+	// Responses might never arrive, e.g. if the connection is lost
+	if (_pendingBatches.size() >= maxPendingBatches) {
+		_pendingBatches.clear();
+	}
+	_pendingBatches[id] = Clock::now();
+	SendFrame(obs_data_get_json(batch));
+}
+
+void WSClientConnection::SendFrame(const std::string &msg)
+{
 	websocketpp::lib::error_code errorCode;
 	_client.send(_connection, msg, websocketpp::frame::opcode::text,
 		     errorCode);
+	{
+		std::lock_guard<std::mutex> lock(_statsMtx);
+		if (errorCode) {
+			_stats.sendFailures++;
+		} else {
+			_stats.framesSent++;
+			_stats.bytesSent += msg.size();
+		}
+	}
 	if (errorCode) {
 		std::string errorCodeMessage = errorCode.message();
 		blog(LOG_INFO, "websocket send failed: %s",
 		     errorCodeMessage.c_str());
+		return;
 	}
 	vblog(LOG_INFO, "sent message to '%s':\n%s", _uri.c_str(), msg.c_str());
 }
 
+void WSClientConnection::CountReceivedMessage(size_t size)
+{
+	std::lock_guard<std::mutex> lock(_statsMtx);
+	_stats.messagesReceived++;
+	_stats.bytesReceived += size;
+}
+
+WSClientConnection::Stats WSClientConnection::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(_statsMtx);
+	return _stats;
+}
+
 void WSClientConnection::OnClose(connection_hdl)
 {
 	blog(LOG_INFO, "client-connection to %s closed.", _uri.c_str());
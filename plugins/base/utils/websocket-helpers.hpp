@@ -2,6 +2,8 @@
 #include "message-buffer.hpp"
 #include "message-dispatcher.hpp"
 
+#include <chrono>
+#include <map>
 #include <set>
 #include <QtCore/QObject>
 #include <QtCore/QMutex>
@@ -54,7 +56,29 @@ public:
 	Status GetStatus() const;
 	void UseOBSWebsocketProtocol(bool);
 
+	struct Stats {
+		uint64_t messagesSent = 0;
+		// Might be lower than the number of messages sent, as requests
+		// are combined into request batches
+		uint64_t framesSent = 0;
+		uint64_t bytesSent = 0;
+		uint64_t sendFailures = 0;
+		uint64_t messagesReceived = 0;
+		uint64_t bytesReceived = 0;
+		// Time messages waited to be picked up by the network thread
+		std::chrono::microseconds averageQueueTime{0};
+		// Time until the response to a request batch was received
+		std::chrono::microseconds averageRoundTripTime{0};
+	};
+	Stats GetStats() const;
+
 private:
+	using Clock = std::chrono::steady_clock;
+	struct QueuedMessage {
+		std::string message;
+		Clock::time_point queued;
+	};
+
 	void OnGenericOpen(connection_hdl hdl);
 	void OnOBSOpen(connection_hdl hdl);
 	void OnGenericMessage(connection_hdl hdl, client::message_ptr message);
@@ -65,6 +89,11 @@ private:
 	void HandleHello(obs_data_t *helloMsg);
 	void HandleEvent(obs_data_t *event);
 	void HandleResponse(obs_data_t *response);
+	void HandleBatchResponse(obs_data_t *response);
+	void FlushSendQueue();
+	void SendRequestBatch(std::vector<OBSDataAutoRelease> &requests);
+	void SendFrame(const std::string &);
+	void CountReceivedMessage(size_t size);
 
 	client _client;
 	std::string _uri = "";
@@ -79,6 +108,22 @@ private:
 	std::string _failMsg = "";
 	std::atomic<Status> _status = {Status::DISCONNECTED};
 	std::atomic_bool _disconnect{false};
+	std::atomic_bool _useOBSProtocol{true};
+
+	// Messages are sent by the network thread, so callers never block on
+	// the connection and messages queued in the meantime can be batched
+	std::mutex _sendMtx;
+	std::vector<QueuedMessage> _sendQueue;
+	bool _flushScheduled = false;
+	// Only accessed by the network thread
+	std::map<std::string, Clock::time_point> _pendingBatches;
+	uint64_t _batchCount = 0;
+
+	mutable std::mutex _statsMtx;
+	Stats _stats;
+	std::chrono::microseconds _totalQueueTime{0};
+	std::chrono::microseconds _totalRoundTripTime{0};
+	uint64_t _roundTripCount = 0;
 
 	WebsocketMessageDispatcher _dispatcher;
 };
@@ -108,6 +108,21 @@ static QString formatProtocolUsageText(WSConnection *connection)
 			: "AdvSceneSwitcher.websocketConnectionTab.protocol.no");
 }
 
+static QString formatStatsText(WSConnection *connection)
+{
+	const auto stats = connection->GetStats();
+	auto toMs = [](std::chrono::microseconds duration) {
+		return QString::number(duration.count() / 1000.0, 'f', 2);
+	};
+	return QString(obs_module_text(
+			       "AdvSceneSwitcher.websocketConnectionTab.statistics"))
+		.arg(stats.messagesSent)
+		.arg(stats.framesSent)
+		.arg(stats.messagesReceived)
+		.arg(toMs(stats.averageQueueTime))
+		.arg(toMs(stats.averageRoundTripTime));
+}
+
 static QStringList getCellLabels(WSConnection *connection, bool addName = true)
 {
 	assert(connection);
@@ -118,7 +133,8 @@ static QStringList getCellLabels(WSConnection *connection, bool addName = true)
 	}
 	result << QString::fromStdString(connection->GetURI())
 	       << QString::number(connection->GetPort())
-	       << formatProtocolUsageText(connection);
+	       << formatProtocolUsageText(connection)
+	       << formatStatsText(connection);
 	return result;
 }
 
@@ -160,7 +176,9 @@ static const QStringList headers =
 	<< obs_module_text(
 		   "AdvSceneSwitcher.websocketConnectionTab.port.header")
 	<< obs_module_text(
-		   "AdvSceneSwitcher.websocketConnectionTab.protocol.header");
+		   "AdvSceneSwitcher.websocketConnectionTab.protocol.header")
+	<< obs_module_text(
+		   "AdvSceneSwitcher.websocketConnectionTab.statistics.header");
 
 WSConnectionsTable::WSConnectionsTable(QTabWidget *parent)
 	: ResourceTable(
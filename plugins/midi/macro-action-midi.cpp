@@ -204,11 +204,15 @@ void MacroActionMidiEdit::ToggleListen()
 void MacroActionMidiEdit::SetMessageSelectionToLastReceived()
 {
 	auto lock = LockContext();
-	if (!_entryData || !_messageBuffer || _messageBuffer->Empty()) {
+	if (!_entryData || !_messageBuffer) {
+		return;
+	}
+	_entryData->_device.DispatchPendingMessages();
+	if (_messageBuffer->Empty()) {
 		return;
 	}
 
-	std::optional<MidiMessage> message;
+	std::shared_ptr<const MidiMessage> message;
 	while (!_messageBuffer->Empty()) {
 		message = _messageBuffer->ConsumeMessage();
 		if (!message) {
@@ -21,26 +21,38 @@ bool MacroConditionMidi::CheckCondition()
 	const bool macroWasPausedSinceLastCheck =
 		MacroWasPausedSince(GetMacro(), _lastCheck);
 	_lastCheck = std::chrono::high_resolution_clock::now();
+
+	// Messages received while paused might still be pending, so they have
+	// to be dispatched before the buffer is cleared
+	_device.DispatchPendingMessages();
 	if (macroWasPausedSinceLastCheck) {
 		_messageBuffer->Clear();
 		return false;
 	}
 
+	const auto key = _message.GetMatchKey();
+	bool matched = false;
 	while (!_messageBuffer->Empty()) {
 		auto message = _messageBuffer->ConsumeMessage();
 		if (!message) {
 			continue;
 		}
-		if (message->Matches(_message)) {
-			SetVariableValues(*message);
-			if (_clearBufferOnMatch) {
-				_messageBuffer->Clear();
-			}
-			return true;
+		if (!key.Matches(message->GetMatchKey())) {
+			continue;
+		}
+		SetVariableValues(*message);
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
+		if (_clearBufferOnMatch) {
+			_messageBuffer->Clear();
 		}
+		return true;
 	}
 
-	return false;
+	return matched;
 }
 
 bool MacroConditionMidi::Save(obs_data_t *obj) const
@@ -49,6 +61,8 @@ bool MacroConditionMidi::Save(obs_data_t *obj) const
 	_message.Save(obj);
 	_device.Save(obj);
 	obs_data_set_bool(obj, "clearBufferOnMatch", _clearBufferOnMatch);
+	obs_data_set_bool(obj, "runForEachMessage", _runForEachMessage);
+	_bufferSettings.Save(obj);
 	obs_data_set_int(obj, "version", 1);
 	return true;
 }
@@ -58,11 +72,13 @@ bool MacroConditionMidi::Load(obs_data_t *obj)
 	MacroCondition::Load(obj);
 	_message.Load(obj);
 	_device.Load(obj);
-	_messageBuffer = _device.RegisterForMidiMessages();
+	_bufferSettings.Load(obj);
+	RegisterForMessages();
 	_clearBufferOnMatch = obs_data_get_bool(obj, "clearBufferOnMatch");
 	if (!obs_data_has_user_value(obj, "version")) {
 		_clearBufferOnMatch = true;
 	}
+	_runForEachMessage = obs_data_get_bool(obj, "runForEachMessage");
 	return true;
 }
 
@@ -74,7 +90,42 @@ std::string MacroConditionMidi::GetShortDesc() const
 void MacroConditionMidi::SetDevice(const MidiDevice &dev)
 {
 	_device = dev;
-	_messageBuffer = dev.RegisterForMidiMessages();
+	RegisterForMessages();
+}
+
+void MacroConditionMidi::SetMessage(const MidiMessage &message)
+{
+	const bool ignoredValue = _message.IgnoresValue();
+	_message = message;
+	if (ignoredValue != _message.IgnoresValue()) {
+		RegisterForMessages();
+	}
+}
+
+void MacroConditionMidi::SetBufferSettings(
+	const MessageBufferSettings &settings)
+{
+	_bufferSettings = settings;
+	_bufferSettings.Apply(_messageBuffer.get());
+}
+
+MessageBufferSettings MacroConditionMidi::GetBufferSettings() const
+{
+	return _bufferSettings;
+}
+
+std::shared_ptr<MessageBufferBase> MacroConditionMidi::GetMessageBuffer() const
+{
+	return _messageBuffer;
+}
+
+void MacroConditionMidi::RegisterForMessages()
+{
+	// Every value has to be received if the value is checked, as e.g. a
+	// button press would otherwise be coalesced with its release
+	_messageBuffer =
+		_device.RegisterForMidiMessages(_message.IgnoresValue());
+	_bufferSettings.Apply(_messageBuffer.get());
 }
 
 void MacroConditionMidi::SetupTempVars()
@@ -117,7 +168,10 @@ MacroConditionMidiEdit::MacroConditionMidiEdit(
 	  _listen(new QPushButton(
 		  obs_module_text("AdvSceneSwitcher.midi.startListen"))),
 	  _clearBufferOnMatch(new QCheckBox(
-		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch")))
+		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch"))),
+	  _runForEachMessage(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.runForEachMessage"))),
+	  _bufferSettings(new MessageBufferSettingsWidget(this))
 {
 	QWidget::connect(_devices,
 			 SIGNAL(DeviceSelectionChanged(const MidiDevice &)),
@@ -132,6 +186,12 @@ MacroConditionMidiEdit::MacroConditionMidiEdit(
 			 SLOT(ToggleListen()));
 	QWidget::connect(_clearBufferOnMatch, SIGNAL(stateChanged(int)), this,
 			 SLOT(ClearBufferOnMatchChanged(int)));
+	QWidget::connect(_runForEachMessage, SIGNAL(stateChanged(int)), this,
+			 SLOT(RunForEachMessageChanged(int)));
+	QWidget::connect(
+		_bufferSettings,
+		SIGNAL(SettingsChanged(const MessageBufferSettings &)), this,
+		SLOT(BufferSettingsChanged(const MessageBufferSettings &)));
 	QWidget::connect(&_listenTimer, SIGNAL(timeout()), this,
 			 SLOT(SetMessageSelectionToLastReceived()));
 
@@ -149,6 +209,8 @@ MacroConditionMidiEdit::MacroConditionMidiEdit(
 	mainLayout->addLayout(listenLayout);
 	mainLayout->addWidget(_resetMidiDevices);
 	mainLayout->addWidget(_clearBufferOnMatch);
+	mainLayout->addWidget(_runForEachMessage);
+	mainLayout->addWidget(_bufferSettings);
 	setLayout(mainLayout);
 
 	_listenTimer.setInterval(100);
@@ -172,6 +234,13 @@ void MacroConditionMidiEdit::UpdateEntryData()
 	_message->SetMessage(_entryData->_message);
 	_devices->SetDevice(_entryData->GetDevice());
 	_clearBufferOnMatch->setChecked(_entryData->_clearBufferOnMatch);
+	_clearBufferOnMatch->setDisabled(_entryData->_runForEachMessage);
+	_runForEachMessage->setChecked(_entryData->_runForEachMessage);
+	_bufferSettings->SetSettings(_entryData->GetBufferSettings());
+	_bufferSettings->SetStatsSource([this]() {
+		auto lock = LockContext();
+		return _entryData->GetMessageBuffer();
+	});
 
 	adjustSize();
 	updateGeometry();
@@ -198,7 +267,7 @@ void MacroConditionMidiEdit::DeviceSelectionChanged(const MidiDevice &device)
 void MacroConditionMidiEdit::MidiMessageChanged(const MidiMessage &message)
 {
 	GUARD_LOADING_AND_LOCK();
-	_entryData->_message = message;
+	_entryData->SetMessage(message);
 }
 
 void MacroConditionMidiEdit::ClearBufferOnMatchChanged(int value)
@@ -207,6 +276,20 @@ void MacroConditionMidiEdit::ClearBufferOnMatchChanged(int value)
 	_entryData->_clearBufferOnMatch = value;
 }
 
+void MacroConditionMidiEdit::RunForEachMessageChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_runForEachMessage = value;
+	_clearBufferOnMatch->setDisabled(value);
+}
+
+void MacroConditionMidiEdit::BufferSettingsChanged(
+	const MessageBufferSettings &settings)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->SetBufferSettings(settings);
+}
+
 void MacroConditionMidiEdit::ResetMidiDevices()
 {
 	auto lock = LockContext();
@@ -246,11 +329,15 @@ void MacroConditionMidiEdit::ToggleListen()
 void MacroConditionMidiEdit::SetMessageSelectionToLastReceived()
 {
 	auto lock = LockContext();
-	if (!_entryData || !_messageBuffer || _messageBuffer->Empty()) {
+	if (!_entryData || !_messageBuffer) {
+		return;
+	}
+	_entryData->GetDevice().DispatchPendingMessages();
+	if (_messageBuffer->Empty()) {
 		return;
 	}
 
-	std::optional<MidiMessage> message;
+	std::shared_ptr<const MidiMessage> message;
 	while (!_messageBuffer->Empty()) {
 		message = _messageBuffer->ConsumeMessage();
 		if (!message) {
@@ -263,7 +350,7 @@ void MacroConditionMidiEdit::SetMessageSelectionToLastReceived()
 	}
 
 	_message->SetMessage(*message);
-	_entryData->_message = *message;
+	_entryData->SetMessage(*message);
 }
 
 } // namespace advss
@@ -1,6 +1,7 @@
 #pragma once
 #include "macro-condition-edit.hpp"
 #include "midi-helpers.hpp"
+#include "message-buffer-settings.hpp"
 
 #include <QCheckBox>
 #include <QPushButton>
@@ -23,15 +24,22 @@ public:
 
 	void SetDevice(const MidiDevice &dev);
 	const MidiDevice &GetDevice() const { return _device; }
+	void SetMessage(const MidiMessage &);
+	void SetBufferSettings(const MessageBufferSettings &);
+	MessageBufferSettings GetBufferSettings() const;
+	std::shared_ptr<MessageBufferBase> GetMessageBuffer() const override;
 	MidiMessage _message;
 	bool _clearBufferOnMatch = true;
+	bool _runForEachMessage = false;
 
 private:
 	void SetupTempVars();
 	void SetVariableValues(const MidiMessage &);
+	void RegisterForMessages();
 
 	MidiDevice _device;
 	MidiMessageBuffer _messageBuffer;
+	MessageBufferSettings _bufferSettings;
 	std::chrono::high_resolution_clock::time_point _lastCheck{};
 	static bool _registered;
 	static const std::string id;
@@ -58,6 +66,8 @@ private slots:
 	void DeviceSelectionChanged(const MidiDevice &);
 	void MidiMessageChanged(const MidiMessage &);
 	void ClearBufferOnMatchChanged(int);
+	void RunForEachMessageChanged(int);
+	void BufferSettingsChanged(const MessageBufferSettings &);
 	void ResetMidiDevices();
 	void ToggleListen();
 	void SetMessageSelectionToLastReceived();
@@ -72,6 +82,8 @@ private:
 	QPushButton *_resetMidiDevices;
 	QPushButton *_listen;
 	QCheckBox *_clearBufferOnMatch;
+	QCheckBox *_runForEachMessage;
+	MessageBufferSettingsWidget *_bufferSettings;
 
 	std::shared_ptr<MacroConditionMidi> _entryData;
 	QTimer _listenTimer;
@@ -16,6 +16,7 @@ namespace advss {
 
 std::map<std::pair<MidiDeviceType, std::string>, MidiDeviceInstance *>
 	MidiDeviceInstance::devices = {};
+std::mutex MidiDeviceInstance::devicesMutex;
 
 static bool setupDeviceObservers()
 {
@@ -81,6 +82,7 @@ static bool deviceObserversAreSetup = setupDeviceObservers();
 
 void MidiDeviceInstance::ResetAllDevices()
 {
+	std::lock_guard<std::mutex> lock(devicesMutex);
 	for (auto const &[_, device] : MidiDeviceInstance::devices) {
 		device->ClosePort();
 		device->OpenPort();
@@ -260,17 +262,33 @@ std::string MidiMessage::GetMidiType(const libremidi::message &msg)
 
 bool MidiMessage::Matches(const MidiMessage &m) const
 {
-	const bool channelMatch = _channel == optionalChannelIndicator ||
-				  m._channel == optionalChannelIndicator ||
-				  (_channel == m._channel);
-	const bool noteMatch = _note == optionalNoteIndicator ||
-			       m._note == optionalNoteIndicator ||
-			       (_note == m._note);
-	const bool valueMatch = _value == optionalValueIndicator ||
-				m._value == optionalValueIndicator ||
-				(_value == m._value);
-	const bool typeMatch = _typeIsOptional || m._typeIsOptional ||
-			       (_type == m._type);
+	return GetMatchKey().Matches(m.GetMatchKey());
+}
+
+MidiMessage::MatchKey MidiMessage::GetMatchKey() const
+{
+	return {_typeIsOptional, _type, _channel, _note, _value};
+}
+
+bool MidiMessage::IgnoresValue() const
+{
+	return _value.IsFixedType() &&
+	       _value.GetFixedValue() == optionalValueIndicator;
+}
+
+bool MidiMessage::MatchKey::Matches(const MatchKey &other) const
+{
+	const bool channelMatch = channel == optionalChannelIndicator ||
+				  other.channel == optionalChannelIndicator ||
+				  channel == other.channel;
+	const bool noteMatch = note == optionalNoteIndicator ||
+			       other.note == optionalNoteIndicator ||
+			       note == other.note;
+	const bool valueMatch = value == optionalValueIndicator ||
+				other.value == optionalValueIndicator ||
+				value == other.value;
+	const bool typeMatch = typeIsOptional || other.typeIsOptional ||
+			       type == other.type;
 	return channelMatch && noteMatch && valueMatch && typeMatch;
 }
 
@@ -282,6 +300,7 @@ MidiDeviceInstance::GetDeviceAndOpen(MidiDeviceType type,
 		return nullptr;
 	}
 
+	std::lock_guard<std::mutex> lock(devicesMutex);
 	auto key = std::make_pair(type, name);
 	auto it = devices.find(key);
 	if (it != devices.end()) {
@@ -320,6 +339,7 @@ advss::MidiDeviceInstance::GetDevice(const libremidi::input_port &p)
 {
 	auto key = std::make_pair(MidiDeviceType::INPUT,
 				  getNameFromPortInformation(p));
+	std::lock_guard<std::mutex> lock(devicesMutex);
 	auto it = MidiDeviceInstance::devices.find(key);
 	if (it == devices.end()) {
 		return nullptr;
@@ -332,6 +352,7 @@ advss::MidiDeviceInstance::GetDevice(const libremidi::output_port &p)
 {
 	auto key = std::make_pair(MidiDeviceType::OUTPUT,
 				  getNameFromPortInformation(p));
+	std::lock_guard<std::mutex> lock(devicesMutex);
 	auto it = MidiDeviceInstance::devices.find(key);
 	if (it == devices.end()) {
 		return nullptr;
@@ -637,25 +658,91 @@ bool MidiDeviceInstance::SendMessge(const MidiMessage &m)
 	return false;
 }
 
-MidiMessageBuffer MidiDeviceInstance::RegisterForMidiMessages()
+MidiMessageBuffer
+MidiDeviceInstance::RegisterForMidiMessages(bool coalesceControlChanges)
 {
-	return _dispatcher.RegisterClient();
+	return coalesceControlChanges ? _coalescedDispatcher.RegisterClient()
+				      : _dispatcher.RegisterClient();
 }
 
 void MidiDeviceInstance::ReceiveMidiMessage(libremidi::message &&msg)
 {
-	_dispatcher.DispatchMessage(msg);
-	vblog(LOG_INFO, "received midi: %s",
-	      MidiMessage::ToString(msg).c_str());
+	// Called by the MIDI driver thread, so avoid locking, allocating
+	// memory, and logging here
+	RawMidiMessage raw;
+	raw.size = std::min(msg.bytes.size(), raw.bytes.size());
+	std::copy_n(msg.bytes.begin(), raw.size, raw.bytes.begin());
+
+	const bool wasEmpty = _pendingMessages.Empty();
+	if (!_pendingMessages.Push(raw)) {
+		_droppedMessages.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	if (wasEmpty) {
+		RequestImmediateCheck();
+	}
+}
+
+static void dispatchMessages(const std::vector<RawMidiMessage> &messages,
+			     MidiMessageDispatcher &dispatcher)
+{
+	libremidi::message msg;
+	for (const auto &message : messages) {
+		msg.bytes.assign(message.bytes.begin(),
+				 message.bytes.begin() + message.size);
+		dispatcher.DispatchMessage(MidiMessage(msg));
+	}
 }
 
-[[nodiscard]] MidiMessageBuffer MidiDevice::RegisterForMidiMessages() const
+void MidiDeviceInstance::DispatchPendingMessages()
+{
+	// Only one thread at a time may consume the pending messages
+	std::lock_guard<std::mutex> lock(_dispatchMutex);
+	_dispatchBatch.Clear();
+	RawMidiMessage raw;
+	while (_pendingMessages.Pop(raw)) {
+		_dispatchBatch.Add(raw);
+	}
+
+	const auto dropped = _droppedMessages.exchange(0);
+	if (dropped > 0) {
+		blog(LOG_WARNING, "dropped %llu messages of midi port '%s'",
+		     (unsigned long long)dropped, _name.c_str());
+	}
+	if (_dispatchBatch.Empty()) {
+		return;
+	}
+
+	if (VerboseLoggingEnabled()) {
+		libremidi::message msg;
+		for (const auto &message : _dispatchBatch.All()) {
+			msg.bytes.assign(message.bytes.begin(),
+					 message.bytes.begin() + message.size);
+			blog(LOG_INFO, "received midi: %s",
+			     MidiMessage::ToString(msg).c_str());
+		}
+	}
+	dispatchMessages(_dispatchBatch.All(), _dispatcher);
+	dispatchMessages(_dispatchBatch.Coalesced(), _coalescedDispatcher);
+}
+
+[[nodiscard]] MidiMessageBuffer
+MidiDevice::RegisterForMidiMessages(bool coalesceControlChanges) const
 {
 	if (_type == MidiDeviceType::OUTPUT || _name.empty() || !_dev) {
 		return {};
 	}
 
-	return _dev->RegisterForMidiMessages();
+	return _dev->RegisterForMidiMessages(coalesceControlChanges);
+}
+
+void MidiDevice::DispatchPendingMessages() const
+{
+	if (_type == MidiDeviceType::OUTPUT || !_dev) {
+		return;
+	}
+
+	_dev->DispatchPendingMessages();
 }
 
 std::string MidiDevice::Name() const
@@ -1,7 +1,11 @@
 #pragma once
+#include <array>
 #include <QComboBox>
 #include <message-dispatcher.hpp>
+#include "midi-message-batch.hpp"
+#include <mutex>
 #include <obs-data.h>
+#include <spsc-queue.hpp>
 #include <variable-number.hpp>
 #include <variable-spinbox.hpp>
 #include <variable-string.hpp>
@@ -26,6 +30,21 @@ public:
 
 	bool Matches(const MidiMessage &) const;
 
+	// Message with all variables resolved, so comparing a configured
+	// message against many received ones only resolves the variables once
+	struct MatchKey {
+		bool typeIsOptional;
+		libremidi::message_type type;
+		int channel;
+		int note;
+		int value;
+
+		bool Matches(const MatchKey &) const;
+	};
+	MatchKey GetMatchKey() const;
+	// Whether messages with any value are matched
+	bool IgnoresValue() const;
+
 	static std::string ToString(const libremidi::message &msg);
 	static std::string MidiTypeToString(libremidi::message_type type);
 	static std::string GetMidiType(const libremidi::message &msg);
@@ -81,12 +100,16 @@ private:
 	~MidiDeviceInstance() = default;
 	bool IsOpened() const;
 	bool SendMessge(const MidiMessage &);
-	[[nodiscard]] MidiMessageBuffer RegisterForMidiMessages();
+	[[nodiscard]] MidiMessageBuffer
+	RegisterForMidiMessages(bool coalesceControlChanges);
 	void ReceiveMidiMessage(libremidi::message &&);
+	void DispatchPendingMessages();
 
 	static std::map<std::pair<MidiDeviceType, std::string>,
 			MidiDeviceInstance *>
 		devices;
+	// Also accessed by the device observer callbacks on other threads
+	static std::mutex devicesMutex;
 
 	MidiDeviceType _type = MidiDeviceType::INPUT;
 	std::string _name;
@@ -98,6 +121,15 @@ private:
 	libremidi::midi_out _out =
 		libremidi::midi_out(libremidi::output_configuration());
 	MidiMessageDispatcher _dispatcher;
+	// Only receives the most recent value of each controller
+	MidiMessageDispatcher _coalescedDispatcher;
+
+	// Filled by the MIDI driver callback and emptied by the first condition
+	// checking for new messages
+	SPSCQueue<RawMidiMessage> _pendingMessages{4096};
+	std::atomic<uint64_t> _droppedMessages{0};
+	std::mutex _dispatchMutex;
+	MidiMessageBatch _dispatchBatch;
 
 	friend class MidiDevice;
 };
@@ -110,7 +142,12 @@ public:
 	void Load(obs_data_t *obj);
 
 	bool SendMessge(const MidiMessage &) const;
-	[[nodiscard]] MidiMessageBuffer RegisterForMidiMessages() const;
+	// Control changes are coalesced for listeners, which are only
+	// interested in the most recent value of each controller
+	[[nodiscard]] MidiMessageBuffer
+	RegisterForMidiMessages(bool coalesceControlChanges = false) const;
+	// Passes messages received since the last call to the message buffers
+	void DispatchPendingMessages() const;
 
 	std::string Name() const;
 
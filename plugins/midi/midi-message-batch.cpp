@@ -0,0 +1,54 @@
+#include "midi-message-batch.hpp"
+
+#include <bitset>
+
+namespace advss {
+
+static bool isControlChange(const RawMidiMessage &message)
+{
+	return message.size == 3 && (message.bytes[0] & 0xF0) == 0xB0;
+}
+
+void MidiMessageBatch::Add(const RawMidiMessage &message)
+{
+	_messages.emplace_back(message);
+	_coalescedValid = false;
+}
+
+void MidiMessageBatch::Clear()
+{
+	_messages.clear();
+	_coalesced.clear();
+	_coalescedValid = false;
+}
+
+const std::vector<RawMidiMessage> &MidiMessageBatch::Coalesced()
+{
+	if (_coalescedValid) {
+		return _coalesced;
+	}
+
+	std::bitset<16 * 128> seen;
+	_coalesced.resize(_messages.size());
+	auto keep = _coalesced.end();
+	for (auto it = _messages.end(); it != _messages.begin();) {
+		--it;
+		if (!isControlChange(*it)) {
+			*--keep = *it;
+			continue;
+		}
+		const size_t channel = it->bytes[0] & 0x0F;
+		const size_t controller = it->bytes[1] & 0x7F;
+		const size_t index = channel * 128 + controller;
+		if (seen[index]) {
+			continue;
+		}
+		seen[index] = true;
+		*--keep = *it;
+	}
+	_coalesced.erase(_coalesced.begin(), keep);
+	_coalescedValid = true;
+	return _coalesced;
+}
+
+} // namespace advss
@@ -0,0 +1,36 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <vector>
+
+namespace advss {
+
+// The parts of a MIDI message used by MidiMessage, which can be copied
+// without allocating memory in the MIDI driver callback
+struct RawMidiMessage {
+	std::array<unsigned char, 3> bytes = {};
+	size_t size = 0;
+};
+
+// Messages received since they were last dispatched
+class MidiMessageBatch {
+public:
+	void Add(const RawMidiMessage &);
+	void Clear();
+	bool Empty() const { return _messages.empty(); }
+
+	// All messages in the order they were received
+	const std::vector<RawMidiMessage> &All() const { return _messages; }
+	// Only the most recent value of each controller on each channel, as
+	// faders and knobs can send lots of updates in a short amount of time.
+	// Must only be used for listeners, which do not care about the value,
+	// as e.g. a button press and release would be reduced to the release.
+	const std::vector<RawMidiMessage> &Coalesced();
+
+private:
+	std::vector<RawMidiMessage> _messages;
+	std::vector<RawMidiMessage> _coalesced;
+	bool _coalescedValid = false;
+};
+
+} // namespace advss
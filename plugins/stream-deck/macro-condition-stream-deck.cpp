@@ -64,7 +64,7 @@ void receiveStreamDeckMessage(obs_data_t *request_data, obs_data_t *)
 	}
 	message.data = obs_data_get_string(settings, "data");
 
-	messageDispatcher.DispatchMessage(message);
+	messageDispatcher.DispatchMessage(std::move(message));
 }
 
 StreamDeckMessageBuffer RegisterForStreamDeckMessages()
@@ -18,294 +18,6 @@ static const auto reconnectDelay = 15s;
 
 /* ------------------------------------------------------------------------- */
 
-static std::vector<IRCMessage::Badge> parseBadgeTag(const std::string &tag)
-{
-	std::vector<std::string> badgePairs;
-	size_t badgePos = 0;
-	size_t badgeEndPos;
-
-	while ((badgeEndPos = tag.find(',', badgePos)) != std::string::npos) {
-		badgePairs.push_back(
-			tag.substr(badgePos, badgeEndPos - badgePos));
-		badgePos = badgeEndPos + 1;
-	}
-
-	badgePairs.push_back(tag.substr(badgePos));
-
-	std::vector<IRCMessage::Badge> badges;
-	for (const auto &badgePair : badgePairs) {
-		size_t slashPos = badgePair.find('/');
-		const auto badgeName = badgePair.substr(0, slashPos);
-		const auto badgeValue = (slashPos != std::string::npos)
-						? badgePair.substr(slashPos + 1)
-						: "";
-		badges.push_back({badgeName, badgeValue != "0"});
-	}
-
-	return badges;
-}
-
-static void parseTags(const std::string &tags, IRCMessage &message)
-{
-	static constexpr std::array<std::string_view, 2> tagsToIgnore = {
-		"client-nonce", "flags"};
-
-	std::vector<std::string> properties;
-	size_t pos = 0;
-	size_t endPos;
-
-	while ((endPos = tags.find(';', pos)) != std::string::npos) {
-		properties.push_back(tags.substr(pos, endPos - pos));
-		pos = endPos + 1;
-	}
-
-	properties.push_back(tags.substr(pos));
-
-	for (const auto &tagPair : properties) {
-		size_t equalsPos = tagPair.find('=');
-		std::string tagName = tagPair.substr(0, equalsPos);
-		std::string tagValue = (equalsPos != std::string::npos)
-					       ? tagPair.substr(equalsPos + 1)
-					       : "";
-
-		if (std::find(tagsToIgnore.begin(), tagsToIgnore.end(),
-			      tagName) != tagsToIgnore.end()) {
-			continue;
-		}
-
-		if (tagValue.empty()) {
-			continue;
-		}
-
-		if (tagName == "badge-info") {
-			message.properties.badgeInfoString = tagValue;
-		} else if (tagName == "badges") {
-			message.properties.badges = parseBadgeTag(tagValue);
-			message.properties.badgesString = tagValue;
-		} else if (tagName == "bits") {
-			message.properties.bits = std::stoi(tagValue);
-		} else if (tagName == "color") {
-			message.properties.color = tagValue;
-		} else if (tagName == "display-name") {
-			message.properties.displayName = tagValue;
-		} else if (tagName == "emote-only") {
-			message.properties.isUsingOnlyEmotes = tagValue == "1";
-		} else if (tagName == "emotes") {
-			message.properties.emotesString = tagValue;
-		} else if (tagName == "first-msg") {
-			message.properties.isFirstMessage = tagValue == "1";
-		} else if (tagName == "id") {
-			message.properties.id = tagValue;
-		} else if (tagName == "mod") {
-			message.properties.isMod = tagValue == "1";
-		} else if (tagName == "reply-parent-msg-body") {
-			message.properties.replyParentBody = tagValue;
-		} else if (tagName == "reply-parent-display-name") {
-			message.properties.replyParentDisplayName = tagValue;
-		} else if (tagName == "reply-parent-msg-id") {
-			message.properties.replyParentId = tagValue;
-		} else if (tagName == "reply-parent-user-id") {
-			message.properties.replyParentUserId = tagValue;
-		} else if (tagName == "reply-parent-user-login") {
-			message.properties.replyParentUserLogin = tagValue;
-		} else if (tagName == "reply-thread-parent-msg-id") {
-			message.properties.rootParentId = tagValue;
-		} else if (tagName == "reply-thread-parent-user-login") {
-			message.properties.rootParentUserLogin = tagValue;
-		} else if (tagName == "subscriber") {
-			message.properties.isSubscriber = tagValue == "1";
-		} else if (tagName == "tmi-sent-ts") {
-			message.properties.timestamp = std::stoull(tagValue);
-		} else if (tagName == "turbo") {
-			message.properties.isTurbo = tagValue == "1";
-		} else if (tagName == "user-id") {
-			message.properties.userId = tagValue;
-		} else if (tagName == "user-type") {
-			message.properties.userType = tagValue;
-		} else if (tagName == "vip") {
-			message.properties.isVIP = tagValue == "1";
-		}
-	}
-}
-
-static void parseSource(const std::string &rawSourceComponent,
-			IRCMessage &message)
-{
-	if (rawSourceComponent.empty()) {
-		return;
-	}
-	size_t nickPos = 0;
-	size_t nickEndPos = rawSourceComponent.find('!');
-
-	if (nickEndPos != std::string::npos) {
-		message.source.nick = rawSourceComponent.substr(
-			nickPos, nickEndPos - nickPos);
-		message.source.host = rawSourceComponent.substr(nickEndPos + 1);
-	} else {
-		// Assume the entire source is the host if no '!' is found
-		message.source.host = rawSourceComponent;
-	}
-}
-
-static void parseCommand(const std::string &rawCommandComponent,
-			 IRCMessage &message)
-{
-	std::vector<std::string> commandParts;
-	size_t pos = 0;
-	size_t endPos;
-
-	while ((endPos = rawCommandComponent.find(' ', pos)) !=
-	       std::string::npos) {
-		commandParts.push_back(
-			rawCommandComponent.substr(pos, endPos - pos));
-		pos = endPos + 1;
-	}
-
-	commandParts.push_back(rawCommandComponent.substr(pos));
-
-	if (commandParts.empty()) {
-		return;
-	}
-
-	message.command.command = commandParts[0];
-	if (message.command.command == "CAP") {
-		if (commandParts.size() < 3) {
-			return;
-		}
-		message.command.parameters = (commandParts[2] == "ACK");
-	} else if (message.command.command == "RECONNECT") {
-		blog(LOG_INFO,
-		     "The Twitch IRC server is about to terminate the connection for maintenance.");
-	} else if (message.command.command == "421") {
-		// Unsupported command
-		return;
-	} else if (message.command.command == "PING" ||
-		   message.command.command == "001" ||
-		   message.command.command == "NOTICE" ||
-		   message.command.command == "CLEARCHAT" ||
-		   message.command.command == "HOSTTARGET" ||
-		   message.command.command == "PRIVMSG") {
-		if (commandParts.size() < 2) {
-			return;
-		}
-		message.command.parameters = commandParts[1];
-	} else if (message.command.command == "JOIN") {
-		if (commandParts.size() < 2) {
-			return;
-		}
-		message.properties.joinedChannel = true;
-		message.command.parameters = commandParts[1];
-	} else if (message.command.command == "PART") {
-		if (commandParts.size() < 2) {
-			return;
-		}
-		message.properties.leftChannel = true;
-		message.command.parameters = commandParts[1];
-	} else if (message.command.command == "GLOBALUSERSTATE" ||
-		   message.command.command == "USERSTATE" ||
-		   message.command.command == "ROOMSTATE" ||
-		   message.command.command == "002" ||
-		   message.command.command == "003" ||
-		   message.command.command == "004" ||
-		   message.command.command == "353" ||
-		   message.command.command == "366" ||
-		   message.command.command == "372" ||
-		   message.command.command == "375" ||
-		   message.command.command == "376") {
-		// Do nothing for these cases for now
-	} else {
-		vblog(LOG_INFO, "Unexpected IRC command: %s",
-		      message.command.command.c_str());
-	}
-}
-
-static IRCMessage parseMessage(const std::string &message)
-{
-	IRCMessage parsedMessage;
-
-	size_t idx = 0;
-	std::string rawTagsComponent;
-	std::string rawSourceComponent;
-	std::string rawCommandComponent;
-	std::string rawMessageComponent;
-
-	if (message[idx] == '@') {
-		size_t endIdx = message.find(' ');
-		rawTagsComponent = message.substr(1, endIdx - 1);
-		idx = endIdx + 1;
-	}
-
-	if (message[idx] == ':') {
-		idx += 1;
-		size_t endIdx = message.find(' ', idx);
-		rawSourceComponent = message.substr(idx, endIdx - idx);
-		idx = endIdx + 1;
-	}
-
-	size_t endIdx = message.find(':', idx);
-	if (endIdx == std::string::npos) {
-		endIdx = message.length();
-	}
-
-	rawCommandComponent = message.substr(idx, endIdx - idx);
-	if (endIdx != message.length()) {
-		idx = endIdx + 1;
-		rawMessageComponent = message.substr(idx);
-	}
-
-	parseTags(rawTagsComponent, parsedMessage);
-	parseSource(rawSourceComponent, parsedMessage);
-	parseCommand(rawCommandComponent, parsedMessage);
-	parsedMessage.message = rawMessageComponent;
-	return parsedMessage;
-}
-
-static std::vector<IRCMessage> parseMessages(const std::string &messagesStr)
-{
-	static constexpr std::string_view delimiter = "\r\n";
-	std::vector<IRCMessage> messages;
-
-	auto isWhitespace = [](const std::string &str) -> bool {
-		for (char c : str) {
-			if (!std::isspace(static_cast<unsigned char>(c))) {
-				return false;
-			}
-		}
-		return true;
-	};
-
-	size_t start = 0;
-	size_t end = messagesStr.find(delimiter);
-	while (end != std::string::npos) {
-		auto message = messagesStr.substr(start, end - start);
-		if (isWhitespace(message)) {
-			continue;
-		}
-		auto parsedMessage = parseMessage(message);
-		if (parsedMessage.command.command.empty()) {
-			vblog(LOG_INFO, "discarding IRC message: %s",
-			      message.c_str());
-		} else {
-			messages.emplace_back(parsedMessage);
-		}
-		start = end + delimiter.length();
-		end = messagesStr.find(delimiter, start);
-	}
-	auto message = messagesStr.substr(start);
-	if (isWhitespace(message)) {
-		return messages;
-	}
-	auto parsedMessage = parseMessage(message);
-	if (parsedMessage.command.command.empty()) {
-		vblog(LOG_INFO, "discarding IRC message: %s", message.c_str());
-		return messages;
-	}
-	messages.emplace_back(parsedMessage);
-	return messages;
-}
-
-/* ------------------------------------------------------------------------- */
-
 static constexpr std::string_view defaultURL =
 	"wss://irc-ws.chat.twitch.tv:443";
 
@@ -596,10 +308,7 @@ void TwitchChatConnection::OnOpen(connection_hdl)
 	Authenticate();
 }
 
-void TwitchChatConnection::OnMessage(
-	connection_hdl,
-	websocketpp::client<websocketpp::config::asio_tls_client>::message_ptr
-		message)
+void TwitchChatConnection::HandleMessage(const IRCMessage &message)
 {
 	static constexpr std::string_view authOKCommand = "001";
 	static constexpr std::string_view pingCommand = "PING";
@@ -610,6 +319,33 @@ void TwitchChatConnection::OnMessage(
 	static constexpr std::string_view newMessageCommand = "PRIVMSG";
 	static constexpr std::string_view whisperCommand = "WHISPER";
 
+	if (message.command.command == authOKCommand) {
+		vblog(LOG_INFO, "Twitch chat connection authenticated!");
+		_authenticated = true;
+		JoinChannel(_channel.GetName());
+	} else if (message.command.command == pingCommand) {
+		Send("PONG " +
+		     std::get<std::string>(message.command.parameters));
+	} else if (message.command.command == joinCommand) {
+		HandleJoin(message);
+	} else if (message.command.command == partCommand) {
+		HandlePart(message);
+	} else if (message.command.command == newMessageCommand) {
+		HandleNewMessage(message);
+	} else if (message.command.command == whisperCommand) {
+		HandleWhisper(message);
+	} else if (message.command.command == noticeCommand) {
+		HandleNotice(message);
+	} else if (message.command.command == reconnectCommand) {
+		HandleReconnect();
+	}
+}
+
+void TwitchChatConnection::OnMessage(
+	connection_hdl,
+	websocketpp::client<websocketpp::config::asio_tls_client>::message_ptr
+		message)
+{
 	if (!message) {
 		return;
 	}
@@ -617,32 +353,9 @@ void TwitchChatConnection::OnMessage(
 		return;
 	}
 
-	std::string payload = message->get_payload();
-	const auto messages = parseMessages(payload);
-
-	for (const auto &message : messages) {
-		if (message.command.command == authOKCommand) {
-			vblog(LOG_INFO,
-			      "Twitch chat connection authenticated!");
-			_authenticated = true;
-			JoinChannel(_channel.GetName());
-		} else if (message.command.command == pingCommand) {
-			Send("PONG " +
-			     std::get<std::string>(message.command.parameters));
-		} else if (message.command.command == joinCommand) {
-			HandleJoin(message);
-		} else if (message.command.command == partCommand) {
-			HandlePart(message);
-		} else if (message.command.command == newMessageCommand) {
-			HandleNewMessage(message);
-		} else if (message.command.command == whisperCommand) {
-			HandleWhisper(message);
-		} else if (message.command.command == noticeCommand) {
-			HandleNotice(message);
-		} else if (message.command.command == reconnectCommand) {
-			HandleReconnect();
-		}
-	}
+	ParseIRCMessages(
+		message->get_payload(), _parsedMessage,
+		[this](const IRCMessage &message) { HandleMessage(message); });
 }
 
 void TwitchChatConnection::OnClose(connection_hdl hdl)
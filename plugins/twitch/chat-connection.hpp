@@ -1,5 +1,6 @@
 #pragma once
 #include "channel-selection.hpp"
+#include "irc-parser.hpp"
 #include "token.hpp"
 
 #include <condition_variable>
@@ -14,54 +15,6 @@ namespace advss {
 
 using websocketpp::connection_hdl;
 
-struct IRCMessage {
-	struct Badge {
-		std::string name;
-		bool enabled;
-	};
-	struct {
-		std::string badgeInfoString;
-		std::string badgesString;
-		std::vector<Badge> badges;
-		int bits = 0;
-		std::string color;
-		std::string displayName;
-		bool isUsingOnlyEmotes = false;
-		std::string emotesString;
-		bool isFirstMessage = false;
-		std::string id;
-		bool isMod = false;
-		std::string replyParentBody;
-		std::string replyParentDisplayName;
-		std::string replyParentId;
-		std::string replyParentUserId;
-		std::string replyParentUserLogin;
-		std::string rootParentId;
-		std::string rootParentUserLogin;
-		bool isSubscriber = false;
-		unsigned long long timestamp;
-		bool isTurbo = false;
-		std::string userId;
-		std::string userType;
-		bool isVIP = false;
-		bool joinedChannel = false;
-		bool leftChannel = false;
-	} properties;
-
-	struct {
-		std::string nick;
-		std::string host;
-	} source;
-
-	struct {
-		std::string command;
-		std::variant<std::string, bool, std::vector<std::string>>
-			parameters;
-	} command;
-
-	std::string message;
-};
-
 using ChatMessageBuffer = std::shared_ptr<MessageBuffer<IRCMessage>>;
 using ChatMessageDispatcher = MessageDispatcher<IRCMessage>;
 
@@ -96,6 +49,7 @@ private:
 
 	void Authenticate();
 	void JoinChannel(const std::string &);
+	void HandleMessage(const IRCMessage &);
 	void HandleJoin(const IRCMessage &);
 	void HandlePart(const IRCMessage &);
 	void HandleNewMessage(const IRCMessage &);
@@ -129,6 +83,9 @@ private:
 	std::atomic_bool _stop{false};
 	std::string _url;
 
+	// Only used by the websocket thread to avoid allocations while parsing
+	IRCMessage _parsedMessage;
+
 	ChatMessageDispatcher _messageDispatcher;
 	ChatMessageDispatcher _whisperDispatcher;
 };
@@ -51,7 +51,7 @@ const std::vector<ChatMessageProperty::PropertyInfo> ChatMessageProperty::_suppo
 	 "AdvSceneSwitcher.condition.twitch.type.chat.properties.color",
 	 std::string(),
 	 [](const IRCMessage &message, const ChatMessageProperty &property) {
-		 auto value = std::get<StringVariable>(property._value);
+		 const auto &value = std::get<StringVariable>(property._value);
 		 return !property._regex.Enabled()
 				? message.properties.color == std::string(value)
 				: property._regex.Matches(
@@ -61,7 +61,7 @@ const std::vector<ChatMessageProperty::PropertyInfo> ChatMessageProperty::_suppo
 	 "AdvSceneSwitcher.condition.twitch.type.chat.properties.displayName",
 	 std::string(),
 	 [](const IRCMessage &message, const ChatMessageProperty &property) {
-		 auto value = std::get<StringVariable>(property._value);
+		 const auto &value = std::get<StringVariable>(property._value);
 		 return !property._regex.Enabled()
 				? message.properties.displayName ==
 					  std::string(value)
@@ -73,7 +73,7 @@ const std::vector<ChatMessageProperty::PropertyInfo> ChatMessageProperty::_suppo
 	 "AdvSceneSwitcher.condition.twitch.type.chat.properties.loginName",
 	 std::string(),
 	 [](const IRCMessage &message, const ChatMessageProperty &property) {
-		 auto value = std::get<StringVariable>(property._value);
+		 const auto &value = std::get<StringVariable>(property._value);
 		 return !property._regex.Enabled()
 				? message.source.nick == std::string(value)
 				: property._regex.Matches(message.source.nick,
@@ -83,14 +83,15 @@ const std::vector<ChatMessageProperty::PropertyInfo> ChatMessageProperty::_suppo
 	 "AdvSceneSwitcher.condition.twitch.type.chat.properties.badge",
 	 std::string("broadcaster"),
 	 [](const IRCMessage &message, const ChatMessageProperty &property) {
-		 auto value = std::get<StringVariable>(property._value);
+		 const std::string value =
+			 std::get<StringVariable>(property._value);
 		 for (const auto &badge : message.properties.badges) {
 			 if (!badge.enabled) {
 				 continue;
 			 }
 			 const bool badgeNameMatches =
 				 !property._regex.Enabled()
-					 ? badge.name == std::string(value)
+					 ? badge.name == value
 					 : property._regex.Matches(badge.name,
 								   value);
 			 if (badgeNameMatches) {
@@ -460,7 +461,7 @@ bool ChatMessageProperty::Matches(const IRCMessage &message) const
 	auto it = std::find_if(_supportedProperties.begin(),
 			       _supportedProperties.end(),
 			       [this](const PropertyInfo &pi) {
-				       return std::string(pi._id) == _id;
+				       return _id == pi._id;
 			       });
 	if (it == _supportedProperties.end()) {
 		return false;
@@ -474,7 +475,7 @@ bool ChatMessageProperty::IsReusable() const
 	auto it = std::find_if(_supportedProperties.begin(),
 			       _supportedProperties.end(),
 			       [this](const PropertyInfo &pi) {
-				       return std::string(pi._id) == _id;
+				       return _id == pi._id;
 			       });
 	if (it == _supportedProperties.end()) {
 		return false;
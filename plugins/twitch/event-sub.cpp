@@ -4,6 +4,8 @@
 
 #include <log-helper.hpp>
 
+#include <algorithm>
+
 namespace advss {
 
 using websocketpp::lib::placeholders::_1;
@@ -119,8 +121,14 @@ void EventSub::Connect()
 
 void EventSub::ClearActiveSubscriptions()
 {
-	std::lock_guard<std::mutex> lock(_subscriptionMtx);
-	_activeSubscriptions.clear();
+	{
+		std::lock_guard<std::mutex> lock(_subscriptionMtx);
+		_activeSubscriptions.clear();
+	}
+	// Buffers of existing clients stay valid but will no longer receive
+	// any events, as the subscription IDs are no longer in use
+	std::lock_guard<std::mutex> lock(_dispatcherMtx);
+	_dispatchers.clear();
 }
 
 void EventSub::Disconnect()
@@ -148,9 +156,47 @@ void EventSub::Disconnect()
 	ClearActiveSubscriptions();
 }
 
-EventSubMessageBuffer EventSub::RegisterForEvents()
+EventSubMessageBuffer
+EventSub::RegisterForEvents(const std::string &subscriptionID)
 {
-	return _dispatcher.RegisterClient();
+	std::lock_guard<std::mutex> lock(_dispatcherMtx);
+	auto &entry = _dispatchers[subscriptionID];
+	auto buffer = entry.dispatcher.RegisterClient();
+	entry.clients.emplace_back(buffer);
+	return buffer;
+}
+
+bool EventSub::SubscriptionDispatcher::HasClients()
+{
+	clients.erase(std::remove_if(clients.begin(), clients.end(),
+				     [](const std::weak_ptr<
+					     MessageBuffer<Event>> &client) {
+					     return client.expired();
+				     }),
+		      clients.end());
+	return !clients.empty();
+}
+
+std::vector<std::string> EventSub::RemoveUnusedSubscriptions()
+{
+	// Must be called with _subscriptionMtx locked
+	std::vector<std::string> removedIDs;
+	std::lock_guard<std::mutex> lock(_dispatcherMtx);
+	for (auto it = _activeSubscriptions.begin();
+	     it != _activeSubscriptions.end();) {
+		auto dispatcher = _dispatchers.find(it->id);
+		if (dispatcher != _dispatchers.end() &&
+		    dispatcher->second.HasClients()) {
+			++it;
+			continue;
+		}
+		if (dispatcher != _dispatchers.end()) {
+			_dispatchers.erase(dispatcher);
+		}
+		removedIDs.emplace_back(it->id);
+		it = _activeSubscriptions.erase(it);
+	}
+	return removedIDs;
 }
 
 bool EventSub::SubscriptionIsActive(const std::string &id)
@@ -187,13 +233,14 @@ static obs_data_t *copyData(const OBSData &data)
 	return obs_data_create_from_json(json);
 }
 
-std::string EventSub::AddEventSubscribtion(std::shared_ptr<TwitchToken> token,
-					   Subscription subscription)
+SubscriptionRegistration
+EventSub::AddEventSubscribtion(std::shared_ptr<TwitchToken> token,
+			       Subscription subscription)
 {
 	auto eventSub = token->GetEventSub();
 	if (!eventSub) {
 		blog(LOG_WARNING, "failed to get Twitch EventSub from token!");
-		return "";
+		return {};
 	}
 
 	std::lock_guard<std::mutex> lock(eventSub->_subscriptionMtx);
@@ -202,11 +249,22 @@ std::string EventSub::AddEventSubscribtion(std::shared_ptr<TwitchToken> token,
 		t.detach();
 		vblog(LOG_INFO, "Twitch EventSub connect started for %s",
 		      token->GetName().c_str());
-		return "";
+		return {};
+	}
+
+	// Subscriptions no longer used by any condition, e.g. because the
+	// channel was changed, are removed so Twitch stops sending their events
+	for (const auto &id : eventSub->RemoveUnusedSubscriptions()) {
+		vblog(LOG_INFO, "removing unused Twitch EventSub '%s'",
+		      id.c_str());
+		SendDeleteRequest(*token, registerSubscriptionURL.data(),
+				  registerSubscriptionPath.data(),
+				  {{"id", id}});
 	}
 
 	if (isAlreadySubscribed(eventSub->_activeSubscriptions, subscription)) {
-		return eventSub->_activeSubscriptions.find(subscription)->id;
+		auto id = eventSub->_activeSubscriptions.find(subscription)->id;
+		return {id, eventSub->RegisterForEvents(id)};
 	}
 
 	OBSDataAutoRelease postData = copyData(subscription.data);
@@ -218,15 +276,18 @@ std::string EventSub::AddEventSubscribtion(std::shared_ptr<TwitchToken> token,
 	if (result.status != 202) {
 		vblog(LOG_INFO, "failed to register Twitch EventSub (%d)",
 		      result.status);
-		return "";
+		return {};
 	}
 
 	OBSDataArrayAutoRelease replyArray =
 		obs_data_get_array(result.data, "data");
 	OBSDataAutoRelease replyData = obs_data_array_item(replyArray, 0);
 	subscription.id = obs_data_get_string(replyData, "id");
+	// Register the buffer right away, as events might arrive before the
+	// requesting condition is checked again
+	auto buffer = eventSub->RegisterForEvents(subscription.id);
 	eventSub->_activeSubscriptions.emplace(subscription);
-	return subscription.id;
+	return {subscription.id, buffer};
 }
 
 void EventSub::OnOpen(connection_hdl)
@@ -250,15 +311,7 @@ static bool isValidTimestamp(const std::string &timestamp)
 
 bool EventSub::IsValidMessageID(const std::string &id)
 {
-	auto it = std::find(_messageIDs.begin(), _messageIDs.end(), id);
-	if (it != _messageIDs.end()) {
-		return false;
-	}
-	if (!_messageIDs.empty()) {
-		_messageIDs.pop_front();
-	}
-	_messageIDs.push_back(id);
-	return true;
+	return _messageIDs.Add(id);
 }
 
 bool EventSub::IsValidID(const std::string &id)
@@ -336,7 +389,22 @@ void EventSub::HandleNotification(obs_data_t *data)
 	event.type = obs_data_get_string(subscription, "type");
 	OBSDataAutoRelease eventData = obs_data_get_obj(data, "event");
 	event.data = eventData;
-	_dispatcher.DispatchMessage(event);
+
+	std::lock_guard<std::mutex> lock(_dispatcherMtx);
+	auto it = _dispatchers.find(event.id);
+	if (it == _dispatchers.end() || !it->second.HasClients()) {
+		vblog(LOG_INFO,
+		      "ignoring Twitch EventSub notification without clients "
+		      "for subscription '%s'",
+		      event.id.c_str());
+		if (it != _dispatchers.end()) {
+			// The subscription itself is removed the next time a
+			// subscription is added or the connection is closed
+			_dispatchers.erase(it);
+		}
+		return;
+	}
+	it->second.dispatcher.DispatchMessage(std::move(event));
 }
 
 void EventSub::HandleReconnect(obs_data_t *data)
@@ -374,15 +442,19 @@ void EventSub::HanldeRevocation(obs_data_t *data)
 	     "condition: %s\n",
 	     id, status, type, version, conditionJson ? conditionJson : "");
 
-	std::lock_guard<std::mutex> lock(_subscriptionMtx);
-	for (auto it = _activeSubscriptions.begin();
-	     it != _activeSubscriptions.begin();) {
-		if (it->id == id) {
-			it = _activeSubscriptions.erase(it);
-		} else {
-			++it;
+	{
+		std::lock_guard<std::mutex> lock(_subscriptionMtx);
+		for (auto it = _activeSubscriptions.begin();
+		     it != _activeSubscriptions.end();) {
+			if (it->id == id) {
+				it = _activeSubscriptions.erase(it);
+			} else {
+				++it;
+			}
 		}
 	}
+	std::lock_guard<std::mutex> lock(_dispatcherMtx);
+	_dispatchers.erase(id);
 }
 
 void EventSub::OnClose(connection_hdl hdl)
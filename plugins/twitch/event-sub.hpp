@@ -1,5 +1,6 @@
 #pragma once
 #include "message-dispatcher.hpp"
+#include "message-id-history.hpp"
 
 #include <obs.hpp>
 #include <websocketpp/client.hpp>
@@ -7,6 +8,7 @@
 #include <mutex>
 #include <condition_variable>
 #include <set>
+#include <unordered_map>
 
 #ifdef USE_TWITCH_CLI_MOCK
 #include <websocketpp/config/asio_no_tls_client.hpp>
@@ -46,6 +48,13 @@ struct Subscription {
 	bool operator<(const Subscription &) const;
 };
 
+struct SubscriptionRegistration {
+	// Empty if the subscription could not be registered
+	std::string id;
+	// Receives the events of the subscription
+	EventSubMessageBuffer buffer;
+};
+
 class EventSub : public QObject {
 public:
 	explicit EventSub();
@@ -53,10 +62,13 @@ public:
 
 	void Connect();
 	void Disconnect();
-	[[nodiscard]] EventSubMessageBuffer RegisterForEvents();
+	// Only events of the given subscription will be delivered to the
+	// returned buffer
+	[[nodiscard]] EventSubMessageBuffer
+	RegisterForEvents(const std::string &subscriptionID);
 	bool SubscriptionIsActive(const std::string &id);
-	static std::string AddEventSubscribtion(std::shared_ptr<TwitchToken>,
-						Subscription);
+	static SubscriptionRegistration
+	AddEventSubscribtion(std::shared_ptr<TwitchToken>, Subscription);
 	void ClearActiveSubscriptions();
 
 private:
@@ -79,6 +91,8 @@ private:
 	void RegisterInstance();
 	void UnregisterInstance();
 
+	std::vector<std::string> RemoveUnusedSubscriptions();
+
 	EventSubWSClient _client;
 	connection_hdl _connection;
 	std::thread _thread;
@@ -90,12 +104,21 @@ private:
 	std::string _url;
 	std::string _sessionID;
 
-	std::deque<std::string> _messageIDs;
+	// Used to discard duplicate messages
+	MessageIDHistory _messageIDs;
+
 	std::mutex _subscriptionMtx;
 	std::set<Subscription> _activeSubscriptions;
 	static std::mutex _instancesMtx;
 	static std::vector<EventSub *> _instances;
-	EventSubMessageDispatcher _dispatcher;
+
+	struct SubscriptionDispatcher {
+		EventSubMessageDispatcher dispatcher;
+		std::vector<std::weak_ptr<MessageBuffer<Event>>> clients;
+		bool HasClients();
+	};
+	std::mutex _dispatcherMtx;
+	std::unordered_map<std::string, SubscriptionDispatcher> _dispatchers;
 };
 
 } // namespace advss
@@ -0,0 +1,394 @@
+#include "irc-parser.hpp"
+
+#include <log-helper.hpp>
+
+#include <array>
+#include <cctype>
+#include <charconv>
+#include <cstdint>
+
+namespace advss {
+
+static constexpr uint32_t hashTagName(std::string_view name)
+{
+	// FNV-1a
+	uint32_t hash = 2166136261u;
+	for (char c : name) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
+static void clearParameters(IRCMessage &message)
+{
+	auto parameters = std::get_if<std::string>(&message.command.parameters);
+	if (parameters) {
+		parameters->clear();
+		return;
+	}
+	message.command.parameters = std::string();
+}
+
+static void resetMessage(IRCMessage &message)
+{
+	auto &properties = message.properties;
+	properties.badgeInfoString.clear();
+	properties.badgesString.clear();
+	properties.badges.clear();
+	properties.bits = 0;
+	properties.color.clear();
+	properties.displayName.clear();
+	properties.isUsingOnlyEmotes = false;
+	properties.emotesString.clear();
+	properties.isFirstMessage = false;
+	properties.id.clear();
+	properties.isMod = false;
+	properties.replyParentBody.clear();
+	properties.replyParentDisplayName.clear();
+	properties.replyParentId.clear();
+	properties.replyParentUserId.clear();
+	properties.replyParentUserLogin.clear();
+	properties.rootParentId.clear();
+	properties.rootParentUserLogin.clear();
+	properties.isSubscriber = false;
+	properties.timestamp = 0;
+	properties.isTurbo = false;
+	properties.userId.clear();
+	properties.userType.clear();
+	properties.isVIP = false;
+	properties.joinedChannel = false;
+	properties.leftChannel = false;
+
+	message.source.nick.clear();
+	message.source.host.clear();
+	message.command.command.clear();
+	clearParameters(message);
+	message.message.clear();
+}
+
+// Returns the part of the string up to the next occurrence of the delimiter
+// and removes it, including the delimiter, from the string
+static std::string_view nextToken(std::string_view &str, char delimiter)
+{
+	const auto pos = str.find(delimiter);
+	const auto token = str.substr(0, pos);
+	str.remove_prefix(pos == std::string_view::npos ? str.size() : pos + 1);
+	return token;
+}
+
+static void parseBadgeTag(std::string_view tag, IRCMessage &message)
+{
+	auto &badges = message.properties.badges;
+	while (true) {
+		const bool isLast = tag.find(',') == std::string_view::npos;
+		auto value = nextToken(tag, ',');
+		const auto name = nextToken(value, '/');
+		badges.emplace_back();
+		badges.back().name.assign(name.data(), name.size());
+		badges.back().enabled = value != "0";
+		if (isLast) {
+			return;
+		}
+	}
+}
+
+template<class T> static void parseNumber(std::string_view value, T &result)
+{
+	std::from_chars(value.data(), value.data() + value.size(), result);
+}
+
+static void parseTag(std::string_view name, std::string_view value,
+		     IRCMessage &message)
+{
+	auto &properties = message.properties;
+	auto assign = [&value](std::string &target) {
+		target.assign(value.data(), value.size());
+	};
+
+	switch (hashTagName(name)) {
+	case hashTagName("badge-info"):
+		if (name == "badge-info") {
+			assign(properties.badgeInfoString);
+		}
+		break;
+	case hashTagName("badges"):
+		if (name == "badges") {
+			parseBadgeTag(value, message);
+			assign(properties.badgesString);
+		}
+		break;
+	case hashTagName("bits"):
+		if (name == "bits") {
+			parseNumber(value, properties.bits);
+		}
+		break;
+	case hashTagName("color"):
+		if (name == "color") {
+			assign(properties.color);
+		}
+		break;
+	case hashTagName("display-name"):
+		if (name == "display-name") {
+			assign(properties.displayName);
+		}
+		break;
+	case hashTagName("emote-only"):
+		if (name == "emote-only") {
+			properties.isUsingOnlyEmotes = value == "1";
+		}
+		break;
+	case hashTagName("emotes"):
+		if (name == "emotes") {
+			assign(properties.emotesString);
+		}
+		break;
+	case hashTagName("first-msg"):
+		if (name == "first-msg") {
+			properties.isFirstMessage = value == "1";
+		}
+		break;
+	case hashTagName("id"):
+		if (name == "id") {
+			assign(properties.id);
+		}
+		break;
+	case hashTagName("mod"):
+		if (name == "mod") {
+			properties.isMod = value == "1";
+		}
+		break;
+	case hashTagName("reply-parent-msg-body"):
+		if (name == "reply-parent-msg-body") {
+			assign(properties.replyParentBody);
+		}
+		break;
+	case hashTagName("reply-parent-display-name"):
+		if (name == "reply-parent-display-name") {
+			assign(properties.replyParentDisplayName);
+		}
+		break;
+	case hashTagName("reply-parent-msg-id"):
+		if (name == "reply-parent-msg-id") {
+			assign(properties.replyParentId);
+		}
+		break;
+	case hashTagName("reply-parent-user-id"):
+		if (name == "reply-parent-user-id") {
+			assign(properties.replyParentUserId);
+		}
+		break;
+	case hashTagName("reply-parent-user-login"):
+		if (name == "reply-parent-user-login") {
+			assign(properties.replyParentUserLogin);
+		}
+		break;
+	case hashTagName("reply-thread-parent-msg-id"):
+		if (name == "reply-thread-parent-msg-id") {
+			assign(properties.rootParentId);
+		}
+		break;
+	case hashTagName("reply-thread-parent-user-login"):
+		if (name == "reply-thread-parent-user-login") {
+			assign(properties.rootParentUserLogin);
+		}
+		break;
+	case hashTagName("subscriber"):
+		if (name == "subscriber") {
+			properties.isSubscriber = value == "1";
+		}
+		break;
+	case hashTagName("tmi-sent-ts"):
+		if (name == "tmi-sent-ts") {
+			parseNumber(value, properties.timestamp);
+		}
+		break;
+	case hashTagName("turbo"):
+		if (name == "turbo") {
+			properties.isTurbo = value == "1";
+		}
+		break;
+	case hashTagName("user-id"):
+		if (name == "user-id") {
+			assign(properties.userId);
+		}
+		break;
+	case hashTagName("user-type"):
+		if (name == "user-type") {
+			assign(properties.userType);
+		}
+		break;
+	case hashTagName("vip"):
+		if (name == "vip") {
+			properties.isVIP = value == "1";
+		}
+		break;
+	default:
+		// Unknown or ignored tags, like "client-nonce" and "flags"
+		break;
+	}
+}
+
+static void parseTags(std::string_view tags, IRCMessage &message)
+{
+	while (!tags.empty()) {
+		auto value = nextToken(tags, ';');
+		const auto name = nextToken(value, '=');
+		if (value.empty()) {
+			continue;
+		}
+		parseTag(name, value, message);
+	}
+}
+
+static void parseSource(std::string_view rawSourceComponent,
+			IRCMessage &message)
+{
+	if (rawSourceComponent.empty()) {
+		return;
+	}
+	const auto nickEndPos = rawSourceComponent.find('!');
+	if (nickEndPos == std::string_view::npos) {
+		// Assume the entire source is the host if no '!' is found
+		message.source.host.assign(rawSourceComponent.data(),
+					   rawSourceComponent.size());
+		return;
+	}
+	const auto nick = rawSourceComponent.substr(0, nickEndPos);
+	const auto host = rawSourceComponent.substr(nickEndPos + 1);
+	message.source.nick.assign(nick.data(), nick.size());
+	message.source.host.assign(host.data(), host.size());
+}
+
+static void setStringParameter(std::string_view value, IRCMessage &message)
+{
+	std::get<std::string>(message.command.parameters)
+		.assign(value.data(), value.size());
+}
+
+static void parseCommand(std::string_view rawCommandComponent,
+			 IRCMessage &message)
+{
+	// No command handled here uses more than two parameters
+	std::array<std::string_view, 3> parts;
+	size_t partCount = 0;
+	while (partCount < parts.size()) {
+		const bool isLast = rawCommandComponent.find(' ') ==
+				    std::string_view::npos;
+		parts[partCount++] = nextToken(rawCommandComponent, ' ');
+		if (isLast) {
+			break;
+		}
+	}
+
+	const auto command = parts[0];
+	message.command.command.assign(command.data(), command.size());
+	const bool hasParameter = partCount > 1;
+	const auto parameter = parts[1];
+
+	if (command == "CAP") {
+		if (partCount < 3) {
+			return;
+		}
+		message.command.parameters = parts[2] == "ACK";
+	} else if (command == "RECONNECT") {
+		blog(LOG_INFO,
+		     "The Twitch IRC server is about to terminate the connection for maintenance.");
+	} else if (command == "421") {
+		// Unsupported command
+		return;
+	} else if (command == "PING" || command == "001" ||
+		   command == "NOTICE" || command == "CLEARCHAT" ||
+		   command == "HOSTTARGET" || command == "PRIVMSG") {
+		if (!hasParameter) {
+			return;
+		}
+		setStringParameter(parameter, message);
+	} else if (command == "JOIN") {
+		if (!hasParameter) {
+			return;
+		}
+		message.properties.joinedChannel = true;
+		setStringParameter(parameter, message);
+	} else if (command == "PART") {
+		if (!hasParameter) {
+			return;
+		}
+		message.properties.leftChannel = true;
+		setStringParameter(parameter, message);
+	} else if (command == "GLOBALUSERSTATE" || command == "USERSTATE" ||
+		   command == "ROOMSTATE" || command == "002" ||
+		   command == "003" || command == "004" || command == "353" ||
+		   command == "366" || command == "372" || command == "375" ||
+		   command == "376") {
+		// Do nothing for these cases for now
+	} else {
+		vblog(LOG_INFO, "Unexpected IRC command: %s",
+		      message.command.command.c_str());
+	}
+}
+
+bool ParseIRCMessage(std::string_view rawMessage, IRCMessage &message)
+{
+	resetMessage(message);
+
+	std::string_view rawTagsComponent;
+	if (!rawMessage.empty() && rawMessage.front() == '@') {
+		rawMessage.remove_prefix(1);
+		rawTagsComponent = nextToken(rawMessage, ' ');
+	}
+
+	std::string_view rawSourceComponent;
+	if (!rawMessage.empty() && rawMessage.front() == ':') {
+		rawMessage.remove_prefix(1);
+		rawSourceComponent = nextToken(rawMessage, ' ');
+	}
+
+	const bool hasMessageComponent =
+		rawMessage.find(':') != std::string_view::npos;
+	const auto rawCommandComponent = nextToken(rawMessage, ':');
+
+	parseTags(rawTagsComponent, message);
+	parseSource(rawSourceComponent, message);
+	parseCommand(rawCommandComponent, message);
+	if (hasMessageComponent) {
+		message.message.assign(rawMessage.data(), rawMessage.size());
+	}
+	return !message.command.command.empty();
+}
+
+static bool isWhitespace(std::string_view str)
+{
+	for (char c : str) {
+		if (!std::isspace(static_cast<unsigned char>(c))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void ParseIRCMessages(std::string_view rawMessages, IRCMessage &message,
+		      const std::function<void(const IRCMessage &)> &callback)
+{
+	static constexpr std::string_view delimiter = "\r\n";
+
+	while (!rawMessages.empty()) {
+		const auto end = rawMessages.find(delimiter);
+		const auto rawMessage = rawMessages.substr(0, end);
+		rawMessages.remove_prefix(end == std::string_view::npos
+						  ? rawMessages.size()
+						  : end + delimiter.size());
+		if (isWhitespace(rawMessage)) {
+			continue;
+		}
+		if (!ParseIRCMessage(rawMessage, message)) {
+			vblog(LOG_INFO, "discarding IRC message: %.*s",
+			      static_cast<int>(rawMessage.size()),
+			      rawMessage.data());
+			continue;
+		}
+		callback(message);
+	}
+}
+
+} // namespace advss
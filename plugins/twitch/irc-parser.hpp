@@ -0,0 +1,71 @@
+#pragma once
+#include <functional>
+#include <string>
+#include <string_view>
+#include <variant>
+#include <vector>
+
+namespace advss {
+
+struct IRCMessage {
+	struct Badge {
+		std::string name;
+		bool enabled;
+	};
+	struct {
+		std::string badgeInfoString;
+		std::string badgesString;
+		std::vector<Badge> badges;
+		int bits = 0;
+		std::string color;
+		std::string displayName;
+		bool isUsingOnlyEmotes = false;
+		std::string emotesString;
+		bool isFirstMessage = false;
+		std::string id;
+		bool isMod = false;
+		std::string replyParentBody;
+		std::string replyParentDisplayName;
+		std::string replyParentId;
+		std::string replyParentUserId;
+		std::string replyParentUserLogin;
+		std::string rootParentId;
+		std::string rootParentUserLogin;
+		bool isSubscriber = false;
+		unsigned long long timestamp = 0;
+		bool isTurbo = false;
+		std::string userId;
+		std::string userType;
+		bool isVIP = false;
+		bool joinedChannel = false;
+		bool leftChannel = false;
+	} properties;
+
+	struct {
+		std::string nick;
+		std::string host;
+	} source;
+
+	struct {
+		std::string command;
+		std::variant<std::string, bool, std::vector<std::string>>
+			parameters;
+	} command;
+
+	std::string message;
+};
+
+// Parses a single IRC message without the trailing "\r\n".
+// All fields of the given message are overwritten, but the memory already
+// held by them is reused, so passing in the same object for each message
+// avoids allocations once it has grown large enough.
+// Returns false if no command was found.
+bool ParseIRCMessage(std::string_view rawMessage, IRCMessage &);
+
+// Parses all "\r\n" separated IRC messages of a websocket frame and calls the
+// callback for each of them.
+// The message passed to the callback is only valid until it returns.
+void ParseIRCMessages(std::string_view rawMessages, IRCMessage &,
+		      const std::function<void(const IRCMessage &)> &callback);
+
+} // namespace advss
@@ -295,27 +295,30 @@ bool MacroConditionTwitch::CheckChannelGenericEvents()
 		return false;
 	}
 
+	bool matched = false;
 	while (!_eventBuffer->Empty()) {
 		auto event = _eventBuffer->ConsumeMessage();
 		if (!event) {
 			continue;
 		}
-		if (_subscriptionID != event->id) {
-			continue;
-		}
 		SetVariableValue(event->ToString());
 		setTempVarsHelper(event->data,
 				  [this](const char *id, const char *value) {
 					  SetTempVarValue(id, value);
 				  });
 
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
 		if (_clearBufferOnMatch) {
 			_eventBuffer->Clear();
 		}
 		return true;
 	}
 
-	return false;
+	return matched;
 }
 
 bool MacroConditionTwitch::CheckChannelLiveEvents()
@@ -324,14 +327,12 @@ bool MacroConditionTwitch::CheckChannelLiveEvents()
 		return false;
 	}
 
+	bool matched = false;
 	while (!_eventBuffer->Empty()) {
 		auto event = _eventBuffer->ConsumeMessage();
 		if (!event) {
 			continue;
 		}
-		if (_subscriptionID != event->id) {
-			continue;
-		}
 
 		auto it = liveEventIDs.find(_condition);
 		if (it == liveEventIDs.end()) {
@@ -350,13 +351,18 @@ bool MacroConditionTwitch::CheckChannelLiveEvents()
 					  SetTempVarValue(id, value);
 				  });
 
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
 		if (_clearBufferOnMatch) {
 			_eventBuffer->Clear();
 		}
 		return true;
 	}
 
-	return false;
+	return matched;
 }
 
 static bool stringMatches(const RegexConfig &regex, const std::string &string,
@@ -378,9 +384,11 @@ bool MacroConditionTwitch::CheckChatMessages(TwitchToken &token)
 			return false;
 		}
 		_chatBuffer = _chatConnection->RegisterForMessages();
+		_bufferSettings.Apply(_chatBuffer.get());
 		return false;
 	}
 
+	bool matched = false;
 	while (!_chatBuffer->Empty()) {
 		auto message = _chatBuffer->ConsumeMessage();
 		if (!message) {
@@ -443,12 +451,17 @@ bool MacroConditionTwitch::CheckChatMessages(TwitchToken &token)
 		SetTempVarValue("is_vip",
 				message->properties.isVIP ? "true" : "false");
 
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
 		if (_clearBufferOnMatch) {
 			_chatBuffer->Clear();
 		}
 		return true;
 	}
-	return false;
+	return matched;
 }
 
 bool MacroConditionTwitch::CheckChatUserJoinOrLeave(TwitchToken &token)
@@ -460,9 +473,11 @@ bool MacroConditionTwitch::CheckChatUserJoinOrLeave(TwitchToken &token)
 			return false;
 		}
 		_chatBuffer = _chatConnection->RegisterForMessages();
+		_bufferSettings.Apply(_chatBuffer.get());
 		return false;
 	}
 
+	bool matched = false;
 	while (!_chatBuffer->Empty()) {
 		auto message = _chatBuffer->ConsumeMessage();
 		if (!message) {
@@ -478,12 +493,17 @@ bool MacroConditionTwitch::CheckChatUserJoinOrLeave(TwitchToken &token)
 
 		SetTempVarValue("user_login", message->source.nick);
 
+		if (_runForEachMessage) {
+			QueueMessageRun();
+			matched = true;
+			continue;
+		}
 		if (_clearBufferOnMatch) {
 			_chatBuffer->Clear();
 		}
 		return true;
 	}
-	return false;
+	return matched;
 }
 
 void MacroConditionTwitch::SetTempVarValues(const ChannelLiveInfo &info)
@@ -547,7 +567,7 @@ bool MacroConditionTwitch::EventSubscriptionIsSetup(
 		return false;
 	}
 	SetupEventSubscription(*eventSub);
-	if (_subscriptionIDFuture.valid()) {
+	if (_subscriptionFuture.valid()) {
 		// Still waiting for the subscription to be registered
 		return false;
 	}
@@ -697,6 +717,8 @@ bool MacroConditionTwitch::Save(obs_data_t *obj) const
 	_chatMessagePattern.Save(obj);
 	_category.Save(obj);
 	obs_data_set_bool(obj, "clearBufferOnMatch", _clearBufferOnMatch);
+	obs_data_set_bool(obj, "runForEachMessage", _runForEachMessage);
+	_bufferSettings.Save(obj);
 	obs_data_set_int(obj, "version", 1);
 
 	return true;
@@ -718,6 +740,8 @@ bool MacroConditionTwitch::Load(obs_data_t *obj)
 	if (!obs_data_has_user_value(obj, "version")) {
 		_clearBufferOnMatch = false;
 	}
+	_runForEachMessage = obs_data_get_bool(obj, "runForEachMessage");
+	_bufferSettings.Load(obj);
 
 	_subscriptionID = "";
 	ResetChatConnection();
@@ -937,32 +961,60 @@ void MacroConditionTwitch::ResetSubscription()
 
 void MacroConditionTwitch::SetupEventSubscription(EventSub &eventSub)
 {
-	if (_subscriptionIDFuture.valid()) {
-		if (_subscriptionIDFuture.wait_for(std::chrono::seconds(0)) !=
+	if (_subscriptionFuture.valid()) {
+		if (_subscriptionFuture.wait_for(std::chrono::seconds(0)) !=
 		    std::future_status::ready)
 			return;
 
-		_subscriptionID = _subscriptionIDFuture.get();
+		auto registration = _subscriptionFuture.get();
+		_subscriptionID = registration.id;
+		_eventBuffer = registration.buffer;
+		_bufferSettings.Apply(_eventBuffer.get());
 	}
 	if (eventSub.SubscriptionIsActive(_subscriptionID)) {
+		if (!_eventBuffer) {
+			_eventBuffer = eventSub.RegisterForEvents(_subscriptionID);
+			_bufferSettings.Apply(_eventBuffer.get());
+		}
 		return;
 	}
+	_eventBuffer.reset();
 	RegisterEventSubscription();
-	_eventBuffer = eventSub.RegisterForEvents();
 }
 
-bool MacroConditionTwitch::IsUsingEventSubCondition()
+bool MacroConditionTwitch::IsUsingEventSubCondition() const
 {
 	return eventIdentifiers.find(_condition) != eventIdentifiers.end();
 }
 
-std::future<std::string>
+void MacroConditionTwitch::SetBufferSettings(
+	const MessageBufferSettings &settings)
+{
+	_bufferSettings = settings;
+	_bufferSettings.Apply(_eventBuffer.get());
+	_bufferSettings.Apply(_chatBuffer.get());
+}
+
+MessageBufferSettings MacroConditionTwitch::GetBufferSettings() const
+{
+	return _bufferSettings;
+}
+
+std::shared_ptr<MessageBufferBase>
+MacroConditionTwitch::GetMessageBuffer() const
+{
+	if (IsUsingEventSubCondition()) {
+		return _eventBuffer;
+	}
+	return _chatBuffer;
+}
+
+std::future<SubscriptionRegistration>
 waitForSubscription(const std::shared_ptr<TwitchToken> &token,
 		    const Subscription &subscription)
 {
 	return std::async(std::launch::async, [token, subscription]() {
-		auto id = EventSub::AddEventSubscribtion(token, subscription);
-		return id;
+		return EventSub::AddEventSubscribtion(token, subscription);
 	});
 }
 
@@ -995,7 +1047,7 @@ void MacroConditionTwitch::AddChannelGenericEventSubscription(
 
 	obs_data_apply(condition, extraConditions);
 	obs_data_set_obj(subscription.data, "condition", condition);
-	_subscriptionIDFuture = waitForSubscription(token, subscription);
+	_subscriptionFuture = waitForSubscription(token, subscription);
 }
 
 static std::string tryTranslate(const std::string &testString)
@@ -1393,7 +1445,10 @@ MacroConditionTwitchEdit::MacroConditionTwitchEdit(
 	  _chatMesageEdit(new ChatMessageEdit(this)),
 	  _category(new TwitchCategoryWidget(this)),
 	  _clearBufferOnMatch(new QCheckBox(
-		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch")))
+		  obs_module_text("AdvSceneSwitcher.clearBufferOnMatch"))),
+	  _runForEachMessage(new QCheckBox(
+		  obs_module_text("AdvSceneSwitcher.runForEachMessage"))),
+	  _bufferSettings(new MessageBufferSettingsWidget(this))
 {
 	_streamTitle->setSizePolicy(QSizePolicy::MinimumExpanding,
 				    QSizePolicy::Preferred);
@@ -1429,6 +1484,12 @@ MacroConditionTwitchEdit::MacroConditionTwitchEdit(
 			 SLOT(CategoreyChanged(const TwitchCategory &)));
 	QWidget::connect(_clearBufferOnMatch, SIGNAL(stateChanged(int)), this,
 			 SLOT(ClearBufferOnMatchChanged(int)));
+	QWidget::connect(_runForEachMessage, SIGNAL(stateChanged(int)), this,
+			 SLOT(RunForEachMessageChanged(int)));
+	QWidget::connect(
+		_bufferSettings,
+		SIGNAL(SettingsChanged(const MessageBufferSettings &)), this,
+		SLOT(BufferSettingsChanged(const MessageBufferSettings &)));
 
 	PlaceWidgets(obs_module_text("AdvSceneSwitcher.condition.twitch.entry"),
 		     _layout,
@@ -1452,6 +1513,8 @@ MacroConditionTwitchEdit::MacroConditionTwitchEdit(
 	mainLayout->addLayout(accountLayout);
 	mainLayout->addWidget(_tokenWarning);
 	mainLayout->addWidget(_clearBufferOnMatch);
+	mainLayout->addWidget(_runForEachMessage);
+	mainLayout->addWidget(_bufferSettings);
 	setLayout(mainLayout);
 
 	_tokenCheckTimer.start(1000);
@@ -1581,6 +1644,20 @@ void MacroConditionTwitchEdit::ClearBufferOnMatchChanged(int value)
 	_entryData->_clearBufferOnMatch = value;
 }
 
+void MacroConditionTwitchEdit::RunForEachMessageChanged(int value)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->_runForEachMessage = value;
+	_clearBufferOnMatch->setDisabled(value);
+}
+
+void MacroConditionTwitchEdit::BufferSettingsChanged(
+	const MessageBufferSettings &settings)
+{
+	GUARD_LOADING_AND_LOCK();
+	_entryData->SetBufferSettings(settings);
+}
+
 void MacroConditionTwitchEdit::SetWidgetVisibility()
 {
 	auto condition = _entryData->GetCondition();
@@ -1603,14 +1680,17 @@ void MacroConditionTwitchEdit::SetWidgetVisibility()
 		MacroConditionTwitch::Condition::CHAT_MESSAGE_RECEIVED);
 	_category->setVisible(
 		condition == MacroConditionTwitch::Condition::CATEGORY_POLLING);
-	_clearBufferOnMatch->setVisible(
+	const bool isUsingMessageBuffer =
 		_entryData->IsUsingEventSubCondition() ||
 		_entryData->GetCondition() ==
 			MacroConditionTwitch::Condition::CHAT_MESSAGE_RECEIVED ||
 		_entryData->GetCondition() ==
 			MacroConditionTwitch::Condition::CHAT_USER_JOINED ||
 		_entryData->GetCondition() ==
-			MacroConditionTwitch::Condition::CHAT_USER_LEFT);
+			MacroConditionTwitch::Condition::CHAT_USER_LEFT;
+	_clearBufferOnMatch->setVisible(isUsingMessageBuffer);
+	_runForEachMessage->setVisible(isUsingMessageBuffer);
+	_bufferSettings->setVisible(isUsingMessageBuffer);
 
 	if (condition == MacroConditionTwitch::Condition::TITLE_POLLING) {
 		RemoveStretchIfPresent(_layout);
@@ -1644,6 +1724,13 @@ void MacroConditionTwitchEdit::UpdateEntryData()
 	_category->SetToken(_entryData->GetToken());
 	_category->SetCategory(_entryData->_category);
 	_clearBufferOnMatch->setChecked(_entryData->_clearBufferOnMatch);
+	_clearBufferOnMatch->setDisabled(_entryData->_runForEachMessage);
+	_runForEachMessage->setChecked(_entryData->_runForEachMessage);
+	_bufferSettings->SetSettings(_entryData->GetBufferSettings());
+	_bufferSettings->SetStatsSource([this]() {
+		auto lock = LockContext();
+		return _entryData->GetMessageBuffer();
+	});
 
 	SetWidgetVisibility();
 }
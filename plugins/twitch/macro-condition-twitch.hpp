@@ -7,6 +7,7 @@
 #include "chat-connection.hpp"
 #include "chat-message-pattern.hpp"
 
+#include <message-buffer-settings.hpp>
 #include <variable-line-edit.hpp>
 #include <variable-text-edit.hpp>
 #include <regex-config.hpp>
@@ -92,7 +93,10 @@ public:
 	void SetPointsReward(const TwitchPointsReward &pointsReward);
 	TwitchPointsReward GetPointsReward() const { return _pointsReward; }
 	void ResetChatConnection();
-	bool IsUsingEventSubCondition();
+	bool IsUsingEventSubCondition() const;
+	void SetBufferSettings(const MessageBufferSettings &);
+	MessageBufferSettings GetBufferSettings() const;
+	std::shared_ptr<MessageBufferBase> GetMessageBuffer() const override;
 
 	bool CheckCondition();
 	bool Save(obs_data_t *obj) const;
@@ -107,6 +111,7 @@ public:
 	ChatMessagePattern _chatMessagePattern;
 	TwitchCategory _category;
 	bool _clearBufferOnMatch = false;
+	bool _runForEachMessage = false;
 
 private:
 	bool CheckChannelGenericEvents();
@@ -134,12 +139,14 @@ private:
 	std::weak_ptr<TwitchToken> _token;
 
 	EventSubMessageBuffer _eventBuffer;
-	std::future<std::string> _subscriptionIDFuture;
+	std::future<SubscriptionRegistration> _subscriptionFuture;
 	std::string _subscriptionID;
 
 	ChatMessageBuffer _chatBuffer;
 	std::shared_ptr<TwitchChatConnection> _chatConnection;
 
+	MessageBufferSettings _bufferSettings;
+
 	std::chrono::high_resolution_clock::time_point _lastCheck{};
 
 	static bool _registered;
@@ -173,6 +180,8 @@ private slots:
 	void ChatMessagePatternChanged(const ChatMessagePattern &);
 	void CategoreyChanged(const TwitchCategory &);
 	void ClearBufferOnMatchChanged(int);
+	void RunForEachMessageChanged(int);
+	void BufferSettingsChanged(const MessageBufferSettings &);
 
 signals:
 	void HeaderInfoChanged(const QString &);
@@ -193,6 +202,8 @@ private:
 	ChatMessageEdit *_chatMesageEdit;
 	TwitchCategoryWidget *_category;
 	QCheckBox *_clearBufferOnMatch;
+	QCheckBox *_runForEachMessage;
+	MessageBufferSettingsWidget *_bufferSettings;
 
 	std::shared_ptr<MacroConditionTwitch> _entryData;
 	bool _loading = true;
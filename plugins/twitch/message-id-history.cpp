@@ -0,0 +1,26 @@
+#include "message-id-history.hpp"
+
+namespace advss {
+
+MessageIDHistory::MessageIDHistory(size_t limit) : _limit(limit) {}
+
+bool MessageIDHistory::Add(const std::string &id)
+{
+	if (!_ids.insert(id).second) {
+		return false;
+	}
+	_order.push_back(id);
+	if (_order.size() > _limit) {
+		_ids.erase(_order.front());
+		_order.pop_front();
+	}
+	return true;
+}
+
+void MessageIDHistory::Clear()
+{
+	_ids.clear();
+	_order.clear();
+}
+
+} // namespace advss
@@ -0,0 +1,25 @@
+#pragma once
+#include <cstddef>
+#include <deque>
+#include <string>
+#include <unordered_set>
+
+namespace advss {
+
+// Remembers the most recently received message IDs to detect duplicates.
+// Once the limit is reached the oldest ID is forgotten.
+class MessageIDHistory {
+public:
+	explicit MessageIDHistory(size_t limit = 256);
+	// Returns false if the ID was already received recently
+	bool Add(const std::string &id);
+	void Clear();
+
+private:
+	size_t _limit;
+	std::unordered_set<std::string> _ids;
+	// The IDs in the order they were received
+	std::deque<std::string> _order;
+};
+
+} // namespace advss
@@ -40,30 +40,38 @@ void MacroConditionUSB::DeviceMatchOption::Load(obs_data_t *obj,
 
 bool MacroConditionUSB::CheckCondition()
 {
-	const auto devs = GetUSBDevices();
-	if (devs.empty()) {
-		return false;
+	const auto snapshot = GetUSBDeviceSnapshot();
+	if (_checkedVersion != snapshot->version) {
+		_checkedVersion = snapshot->version;
+		_matchedDevice.reset();
+		for (const auto &dev : snapshot->devices) {
+			if (_vendorID.Matches(dev.vendorID) &&
+			    _productID.Matches(dev.productID) &&
+			    _busNumber.Matches(dev.busNumber) &&
+			    _deviceAddress.Matches(dev.deviceAddress) &&
+			    _vendorName.Matches(dev.vendorName) &&
+			    _productName.Matches(dev.productName) &&
+			    _serialNumber.Matches(dev.serialNumber)) {
+				_matchedDevice = dev;
+				break;
+			}
+		}
 	}
 
-	for (const auto &dev : devs) {
-		if (_vendorID.Matches(dev.vendorID) &&
-		    _productID.Matches(dev.productID) &&
-		    _busNumber.Matches(dev.busNumber) &&
-		    _deviceAddress.Matches(dev.deviceAddress) &&
-		    _vendorName.Matches(dev.vendorName) &&
-		    _productName.Matches(dev.productName) &&
-		    _serialNumber.Matches(dev.serialNumber)) {
-			SetTempVarValue("vendorID", dev.vendorID);
-			SetTempVarValue("productID", dev.productID);
-			SetTempVarValue("busNumber", dev.busNumber);
-			SetTempVarValue("deviceAddress", dev.deviceAddress);
-			SetTempVarValue("vendorName", dev.vendorName);
-			SetTempVarValue("productName", dev.productName);
-			SetTempVarValue("serialNumber", dev.serialNumber);
-			return true;
-		}
+	if (!_matchedDevice) {
+		return false;
 	}
-	return false;
+
+	// The temp var values are reset each interval, so they have to be set
+	// again even if the cached match is used
+	SetTempVarValue("vendorID", _matchedDevice->vendorID);
+	SetTempVarValue("productID", _matchedDevice->productID);
+	SetTempVarValue("busNumber", _matchedDevice->busNumber);
+	SetTempVarValue("deviceAddress", _matchedDevice->deviceAddress);
+	SetTempVarValue("vendorName", _matchedDevice->vendorName);
+	SetTempVarValue("productName", _matchedDevice->productName);
+	SetTempVarValue("serialNumber", _matchedDevice->serialNumber);
+	return true;
 }
 
 bool MacroConditionUSB::Save(obs_data_t *obj) const
@@ -89,6 +97,7 @@ bool MacroConditionUSB::Load(obs_data_t *obj)
 	_vendorName.Load(obj, "vendorName");
 	_productName.Load(obj, "productName");
 	_serialNumber.Load(obj, "serialNumber");
+	ResetMatchCache();
 	return true;
 }
 
@@ -298,84 +307,98 @@ void MacroConditionUSBEdit::VendorIDChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_vendorID.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::ProductIDChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_productID.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::BusNumberChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_busNumber.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::DeviceAddressChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_deviceAddress.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::VendorNameChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_vendorName.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::ProductNameChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_productName.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::SerialNumberChanged(const QString &text)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_serialNumber.pattern = text.toStdString();
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::VendorIDRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_vendorID.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::ProductIDRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_productID.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::BusNumberRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_busNumber.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::DeviceAddressRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_deviceAddress.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::VendorNameRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_vendorName.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::ProductNameRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_productName.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 void MacroConditionUSBEdit::SerialNumberRegexChanged(const RegexConfig &regex)
 {
 	GUARD_LOADING_AND_LOCK();
 	_entryData->_serialNumber.regex = regex;
+	_entryData->ResetMatchCache();
 }
 
 } // namespace advss
@@ -3,6 +3,7 @@
 #include "usb-helpers.hpp"
 #include "regex-config.hpp"
 
+#include <optional>
 #include <QPushButton>
 
 namespace advss {
@@ -36,9 +37,16 @@ public:
 	DeviceMatchOption _productName;
 	DeviceMatchOption _serialNumber;
 
+	// Has to be called whenever the device match options are modified
+	void ResetMatchCache() { _checkedVersion.reset(); }
+
 private:
 	void SetupTempVars();
 
+	// The devices are only matched again if the device list changed
+	std::optional<uint64_t> _checkedVersion;
+	std::optional<USBDeviceInfo> _matchedDevice;
+
 	static bool _registered;
 	static const std::string id;
 };
@@ -2,27 +2,74 @@
 #include "log-helper.hpp"
 #include "plugin-state-helpers.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
 #include <libusb.h>
 #include <mutex>
+#include <thread>
 
 #define LOG_PREFIX "[usb] "
 
 namespace advss {
 
+using namespace std::chrono_literals;
+
+// Used if hotplug events are not supported
+static constexpr auto pollingInterval = 10s;
+// Used if hotplug events are supported in case an event was missed
+static constexpr auto hotplugRescanInterval = 60s;
+static constexpr timeval eventTimeout = {0, 500000};
+
+namespace {
+
+class USBDeviceMonitor {
+public:
+	void Start();
+	void Stop();
+	std::shared_ptr<const USBDeviceSnapshot> GetSnapshot() const;
+
+private:
+	void Run();
+	void Rescan();
+	static int LIBUSB_CALL HotplugCallback(libusb_context *,
+					       libusb_device *,
+					       libusb_hotplug_event,
+					       void *userData);
+
+	std::thread _thread;
+	std::atomic_bool _stop{false};
+	std::atomic_bool _rescanRequired{true};
+	std::mutex _waitMtx;
+	std::condition_variable _cv;
+
+	// Written by Stop() while the monitor thread might still read it
+	std::atomic_bool _hotplugRegistered{false};
+	libusb_hotplug_callback_handle _hotplugHandle = 0;
+
+	mutable std::mutex _snapshotMtx;
+	std::shared_ptr<const USBDeviceSnapshot> _snapshot =
+		std::make_shared<USBDeviceSnapshot>();
+};
+
+} // namespace
+
+static USBDeviceMonitor monitor;
+
 static bool setup();
 static bool setupDone = setup();
-static bool hotplugsAreSupported = false;
-static std::mutex mutex;
 
 static bool setup()
 {
 	AddPluginInitStep([]() {
 		libusb_init(NULL);
-		hotplugsAreSupported =
-			libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG);
+		monitor.Start();
+	});
+	AddPluginCleanupStep([]() {
+		monitor.Stop();
+		libusb_exit(NULL);
 	});
-	AddPluginCleanupStep([]() { libusb_exit(NULL); });
 	return true;
 }
 
@@ -67,7 +114,19 @@ getDeviceInfo(libusb_device *device, libusb_device_handle *handle,
 	return deviceInfo;
 }
 
-static std::vector<USBDeviceInfo> pollUSBDevices()
+static bool isSameDevice(const USBDeviceInfo &info, libusb_device *device,
+			 const struct libusb_device_descriptor &descriptor)
+{
+	const auto busNumber = libusb_get_bus_number(device);
+	const auto deviceAddress = libusb_get_device_address(device);
+	return info.vendorID == std::to_string(descriptor.idVendor) &&
+	       info.productID == std::to_string(descriptor.idProduct) &&
+	       info.busNumber == std::to_string(busNumber) &&
+	       info.deviceAddress == std::to_string(deviceAddress);
+}
+
+static std::vector<USBDeviceInfo>
+pollUSBDevices(const std::vector<USBDeviceInfo> &knownDevices)
 {
 	libusb_device **devices;
 	ssize_t count = libusb_get_device_list(NULL, &devices);
@@ -88,6 +147,19 @@ static std::vector<USBDeviceInfo> pollUSBDevices()
 			continue;
 		}
 
+		// Opening the device to read its string descriptors is
+		// expensive, so only do so for newly connected devices
+		auto it = std::find_if(knownDevices.begin(), knownDevices.end(),
+				       [device, &descriptor](
+					       const USBDeviceInfo &info) {
+					       return isSameDevice(info, device,
+								   descriptor);
+				       });
+		if (it != knownDevices.end()) {
+			result.emplace_back(*it);
+			continue;
+		}
+
 		libusb_device_handle *handle;
 		ret = libusb_open(device, &handle);
 		if (ret != LIBUSB_SUCCESS) {
@@ -103,97 +175,115 @@ static std::vector<USBDeviceInfo> pollUSBDevices()
 	return result;
 }
 
-static int hotplugCallback(struct libusb_context *,
-			   struct libusb_device *device,
-			   libusb_hotplug_event event, void *user_data)
+void USBDeviceMonitor::Start()
 {
-	auto devices = static_cast<std::vector<USBDeviceInfo> *>(user_data);
+	if (libusb_has_capability(LIBUSB_CAP_HAS_HOTPLUG)) {
+		int ret = libusb_hotplug_register_callback(
+			nullptr,
+			LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED |
+				LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
+			0, LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
+			LIBUSB_HOTPLUG_MATCH_ANY, HotplugCallback, this,
+			&_hotplugHandle);
+		logLibusbError(ret, "Failed to register hotplug callback");
+		_hotplugRegistered = ret == LIBUSB_SUCCESS;
+	}
 
-	static libusb_device_handle *handle = nullptr;
-	struct libusb_device_descriptor descriptor;
+	_stop = false;
+	_thread = std::thread(&USBDeviceMonitor::Run, this);
+}
 
-	int ret = libusb_get_device_descriptor(device, &descriptor);
-	logLibusbError(ret, "Error getting device descriptor");
+void USBDeviceMonitor::Stop()
+{
+	{
+		std::lock_guard<std::mutex> lock(_waitMtx);
+		_stop = true;
+	}
+	_cv.notify_all();
 
-	ret = libusb_open(device, &handle);
-	if (ret != LIBUSB_SUCCESS) {
-		logLibusbError(ret, "Error opening device");
-		return 0;
+	// Also wakes up the event handling of the monitor thread
+	if (_hotplugRegistered) {
+		libusb_hotplug_deregister_callback(nullptr, _hotplugHandle);
+		_hotplugRegistered = false;
 	}
-	const auto deviceInfo = getDeviceInfo(device, handle, descriptor);
-
-	std::lock_guard<std::mutex> lock(mutex);
-	if (LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED == event) {
-		devices->emplace_back(deviceInfo);
-	} else if (LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT == event) {
-		devices->erase(std::find(devices->begin(), devices->end(),
-					 deviceInfo));
+	if (_thread.joinable()) {
+		_thread.join();
 	}
-
-	libusb_close(handle);
-
-	return 0;
 }
 
-static std::vector<USBDeviceInfo> getHotplugBasedDeviceList()
+std::shared_ptr<const USBDeviceSnapshot> USBDeviceMonitor::GetSnapshot() const
 {
-	static std::vector<USBDeviceInfo> devices;
-	static bool hotplugSetupDone = false;
+	std::lock_guard<std::mutex> lock(_snapshotMtx);
+	return _snapshot;
+}
 
-	if (!hotplugSetupDone) {
-		hotplugSetupDone = true;
-		devices = pollUSBDevices();
+void USBDeviceMonitor::Run()
+{
+	// Stop() resets _hotplugRegistered while this thread is still running
+	const bool useHotplug = _hotplugRegistered;
+	const auto rescanInterval = useHotplug ? hotplugRescanInterval
+					       : pollingInterval;
+	auto lastRescan = std::chrono::steady_clock::now();
+
+	while (!_stop) {
+		const auto now = std::chrono::steady_clock::now();
+		if (_rescanRequired.exchange(false) ||
+		    now - lastRescan >= rescanInterval) {
+			Rescan();
+			lastRescan = now;
+		}
 
-		int ret = libusb_hotplug_register_callback(
-			nullptr,
-			LIBUSB_HOTPLUG_EVENT_DEVICE_ARRIVED |
-				LIBUSB_HOTPLUG_EVENT_DEVICE_LEFT,
-			0, LIBUSB_HOTPLUG_MATCH_ANY, LIBUSB_HOTPLUG_MATCH_ANY,
-			LIBUSB_HOTPLUG_MATCH_ANY, hotplugCallback, &devices,
-			nullptr);
-		if (ret != LIBUSB_SUCCESS) {
-			hotplugsAreSupported = false;
-		} else {
-			blog(LOG_WARNING, LOG_PREFIX "hotplug supported!");
+		if (useHotplug) {
+			// Hotplug callbacks are only called from within
+			// libusb's event handling
+			auto timeout = eventTimeout;
+			libusb_handle_events_timeout_completed(
+				nullptr, &timeout, nullptr);
+			continue;
 		}
-	}
 
-	std::lock_guard<std::mutex> lock(mutex);
-	return devices;
+		std::unique_lock<std::mutex> lock(_waitMtx);
+		_cv.wait_for(lock, rescanInterval - (now - lastRescan),
+			     [this]() { return _stop.load(); });
+	}
 }
 
-static std::vector<USBDeviceInfo> getPollingBasedDeviceList()
+void USBDeviceMonitor::Rescan()
 {
-	// Polling can be very expensive
-	// Perform this operation at most once every 10 seconds
-	static const int timeout = 10;
-	static std::vector<USBDeviceInfo> deviceList = {};
-	static std::chrono::high_resolution_clock::time_point lastUpdate = {};
-
-	std::lock_guard<std::mutex> lock(mutex);
-	auto now = std::chrono::high_resolution_clock::now();
-	if (std::chrono::duration_cast<std::chrono::seconds>(now - lastUpdate)
-		    .count() >= timeout) {
-		deviceList = pollUSBDevices();
-		lastUpdate = now;
+	const auto current = GetSnapshot();
+	auto devices = pollUSBDevices(current->devices);
+	if (devices == current->devices) {
+		return;
 	}
 
-	return deviceList;
+	auto snapshot = std::make_shared<USBDeviceSnapshot>();
+	snapshot->version = current->version + 1;
+	snapshot->devices = std::move(devices);
+
+	std::lock_guard<std::mutex> lock(_snapshotMtx);
+	_snapshot = std::move(snapshot);
 }
 
-std::vector<USBDeviceInfo> GetUSBDevices()
+int LIBUSB_CALL USBDeviceMonitor::HotplugCallback(libusb_context *,
+						  libusb_device *,
+						  libusb_hotplug_event,
+						  void *userData)
 {
-	// Hotplug events do not seem to be firing consistently during testing
-	// on Linux so for now only rely on polling based functionality instead
-	return getPollingBasedDeviceList();
+	// The device list is updated from the monitor thread once the event
+	// handling returns, as opening devices is not allowed in here
+	auto monitor = static_cast<USBDeviceMonitor *>(userData);
+	monitor->_rescanRequired = true;
+	return 0;
+}
 
-	/*
-	if (hotplugsAreSupported) {
-		return getHotplugBasedDeviceList();
-	} else {
-		return getPollingBasedDeviceList();
-	}
-	*/
+std::shared_ptr<const USBDeviceSnapshot> GetUSBDeviceSnapshot()
+{
+	return monitor.GetSnapshot();
+}
+
+std::vector<USBDeviceInfo> GetUSBDevices()
+{
+	return GetUSBDeviceSnapshot()->devices;
 }
 
 QStringList GetUSBDevicesStringList()
@@ -220,7 +310,7 @@ QString USBDeviceInfo::ToQString() const
 	return QString::fromStdString(ToString());
 }
 
-bool USBDeviceInfo::operator==(const USBDeviceInfo &other)
+bool USBDeviceInfo::operator==(const USBDeviceInfo &other) const
 {
 	return vendorID == other.vendorID && productID == other.productID &&
 	       busNumber == other.busNumber &&
@@ -1,6 +1,7 @@
 #pragma once
 #include <QString>
 #include <QStringList>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -18,9 +19,18 @@ struct USBDeviceInfo {
 	std::string ToString() const;
 	QString ToQString() const;
 
-	bool operator==(const USBDeviceInfo &other);
+	bool operator==(const USBDeviceInfo &other) const;
 };
 
+struct USBDeviceSnapshot {
+	// Incremented whenever the list of connected devices changes
+	uint64_t version = 0;
+	std::vector<USBDeviceInfo> devices;
+};
+
+// Returns the list of connected devices maintained by a background thread,
+// so calling this function does not result in any device I/O
+std::shared_ptr<const USBDeviceSnapshot> GetUSBDeviceSnapshot();
 std::vector<USBDeviceInfo> GetUSBDevices();
 QStringList GetUSBDevicesStringList();
 
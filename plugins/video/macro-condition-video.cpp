@@ -1,5 +1,6 @@
 #include "macro-condition-video.hpp"
 #include "screenshot-dialog.hpp"
+#include "source-list-model.hpp"
 
 #include <layout-helpers.hpp>
 #include <macro-condition-edit.hpp>
@@ -1148,9 +1149,7 @@ MacroConditionVideoEdit::MacroConditionVideoEdit(
 	_area->setSizePolicy(QSizePolicy::MinimumExpanding,
 			     QSizePolicy::Preferred);
 
-	auto sources = GetVideoSourceNames();
-	sources.sort();
-	_sources->SetSourceNameList(sources);
+	_sources->SetSourceModel(SourceListFilterModel::VideoSources());
 
 	QWidget::connect(_videoInputTypes, SIGNAL(currentIndexChanged(int)),
 			 this, SLOT(VideoInputTypeChanged(int)));
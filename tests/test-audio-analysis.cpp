@@ -0,0 +1,229 @@
+#include "catch.hpp"
+
+#include <audio-analysis.hpp>
+
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <vector>
+
+static constexpr uint32_t sampleRate = 48000;
+static constexpr size_t blockSize = 1024;
+static const double pi = 3.14159265358979323846;
+
+static std::vector<float> sine(double frequency, double amplitude,
+			       size_t count, size_t offset = 0)
+{
+	std::vector<float> samples(count);
+	for (size_t i = 0; i < count; i++) {
+		samples[i] = float(amplitude * std::sin(2.0 * pi * frequency *
+							double(i + offset) /
+							sampleRate));
+	}
+	return samples;
+}
+
+static double amplitudeFromDb(double db)
+{
+	// Amplitude of a sine wave with the given RMS level
+	return std::sqrt(2.0) * std::pow(10.0, db / 20.0);
+}
+
+static double kWeightedLoudness(double frequency, double amplitude)
+{
+	advss::KWeighting filter(sampleRate);
+	advss::MomentaryWindow window(sampleRate);
+	// Let the filter settle for a second before measuring the last 400ms
+	for (size_t offset = 0; offset < 2 * sampleRate; offset += blockSize) {
+		auto samples = sine(frequency, amplitude, blockSize, offset);
+		filter.Process(samples.data(), samples.size());
+		window.Add(advss::SumOfSquares(samples.data(), samples.size()),
+			   0.0, blockSize);
+	}
+	return -0.691 + advss::ToDecibel(window.WeightedMeanSquare());
+}
+
+TEST_CASE("Sum of squares", "[audio-analysis]")
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> distribution(-1.f, 1.f);
+
+	// Sizes not divisible by the vector width use the scalar tail
+	for (size_t count : {0, 1, 3, 4, 5, 17, 1024, 1027}) {
+		std::vector<float> samples(count);
+		double expected = 0.0;
+		for (auto &sample : samples) {
+			sample = distribution(rng);
+			expected += double(sample) * sample;
+		}
+		INFO("count " << count);
+		REQUIRE(advss::SumOfSquares(samples.data(), count) ==
+			Approx(expected).epsilon(1e-5));
+	}
+}
+
+TEST_CASE("Zero crossings and decibels", "[audio-analysis]")
+{
+	auto samples = sine(100.0, 0.5, sampleRate);
+	// Two crossings per period
+	REQUIRE(advss::CountZeroCrossings(samples.data(), samples.size()) ==
+		Approx(200).margin(2));
+
+	REQUIRE(advss::ToDecibel(1.0) == Approx(0.0));
+	REQUIRE(advss::ToDecibel(0.01) == Approx(-20.0));
+	REQUIRE(advss::ToDecibel(0.0) == advss::minEnergyDb);
+	REQUIRE(advss::ToDecibel(1e-20) == advss::minEnergyDb);
+}
+
+TEST_CASE("K-weighting coefficients", "[audio-analysis]")
+{
+	// Reference values for 48kHz from ITU-R BS.1770
+	advss::KWeighting filter(48000);
+	const auto &shelf = filter.Shelf();
+	REQUIRE(shelf.b0 == Approx(1.53512485958697).margin(1e-6));
+	REQUIRE(shelf.b1 == Approx(-2.69169618940638).margin(1e-6));
+	REQUIRE(shelf.b2 == Approx(1.19839281085285).margin(1e-6));
+	REQUIRE(shelf.a1 == Approx(-1.69065929318241).margin(1e-6));
+	REQUIRE(shelf.a2 == Approx(0.73248077421585).margin(1e-6));
+	const auto &highPass = filter.HighPass();
+	REQUIRE(highPass.b0 == Approx(1.0));
+	REQUIRE(highPass.b1 == Approx(-2.0));
+	REQUIRE(highPass.b2 == Approx(1.0));
+	REQUIRE(highPass.a1 == Approx(-1.99004745483398).margin(1e-6));
+	REQUIRE(highPass.a2 == Approx(0.99007225036621).margin(1e-6));
+}
+
+TEST_CASE("Momentary loudness of sine waves", "[audio-analysis]")
+{
+	// A full scale 1kHz sine wave in a single channel is -3.01 LUFS
+	REQUIRE(kWeightedLoudness(997.0, 1.0) == Approx(-3.01).margin(0.05));
+	REQUIRE(kWeightedLoudness(997.0, amplitudeFromDb(-23.0)) ==
+		Approx(-23.0).margin(0.1));
+
+	// The high shelf boosts high frequencies by about 4dB, which is
+	// reduced by the -0.691 offset calibrating the response at 997Hz
+	REQUIRE(kWeightedLoudness(10000.0, amplitudeFromDb(-23.0)) ==
+		Approx(-19.65).margin(0.1));
+	// The high pass attenuates low frequencies
+	REQUIRE(kWeightedLoudness(20.0, amplitudeFromDb(-23.0)) < -30.0);
+}
+
+TEST_CASE("Momentary window", "[audio-analysis]")
+{
+	advss::MomentaryWindow window(sampleRate);
+	REQUIRE(window.Empty());
+	REQUIRE(window.UnweightedMeanSquare() == 0.0);
+
+	// 10ms blocks with a mean square of 1 for the first second
+	constexpr uint32_t frames = sampleRate / 100;
+	for (int i = 0; i < 100; i++) {
+		window.Add(frames, frames, frames);
+	}
+	REQUIRE_FALSE(window.Empty());
+	REQUIRE(window.UnweightedMeanSquare() == Approx(1.0));
+	REQUIRE(window.WeightedMeanSquare() == Approx(1.0));
+
+	// Silence for 200ms leaves half of the window
+	for (int i = 0; i < 20; i++) {
+		window.Add(0.0, 0.0, frames);
+	}
+	REQUIRE(window.UnweightedMeanSquare() == Approx(0.5));
+
+	// The loud blocks leave the window after 400ms
+	for (int i = 0; i < 19; i++) {
+		window.Add(0.0, 0.0, frames);
+	}
+	REQUIRE(window.UnweightedMeanSquare() == Approx(1.0 / 40));
+	window.Add(0.0, 0.0, frames);
+	REQUIRE(window.UnweightedMeanSquare() == 0.0);
+}
+
+static bool processSeconds(advss::VoiceActivityDetector &detector,
+			   double seconds, double frequency, double db)
+{
+	bool active = false;
+	const auto total = size_t(seconds * sampleRate);
+	for (size_t offset = 0; offset < total; offset += blockSize) {
+		auto samples = db == advss::minEnergyDb
+				       ? std::vector<float>(blockSize, 0.f)
+				       : sine(frequency, amplitudeFromDb(db),
+					      blockSize, offset);
+		active = detector.Process(samples.data(), samples.size());
+	}
+	return active;
+}
+
+TEST_CASE("Voice activity", "[audio-analysis]")
+{
+	advss::VoiceActivityDetector detector(sampleRate);
+
+	// Background hum is not speech
+	REQUIRE_FALSE(processSeconds(detector, 1.0, 100.0, -45.0));
+	// Speech is well above the noise floor
+	REQUIRE(processSeconds(detector, 0.5, 300.0, -20.0));
+	// Short pauses are bridged
+	REQUIRE(processSeconds(detector, 0.2, 100.0, -45.0));
+	REQUIRE_FALSE(processSeconds(detector, 0.5, 100.0, -45.0));
+	// Too quiet to be speech
+	REQUIRE_FALSE(processSeconds(detector, 1.0, 300.0, -60.0));
+}
+
+TEST_CASE("Voice activity after digital silence", "[audio-analysis]")
+{
+	advss::VoiceActivityDetector detector(sampleRate);
+	REQUIRE_FALSE(processSeconds(detector, 1.0, 100.0, -45.0));
+
+	// Muting the source must not reset the noise floor, as the background
+	// noise would otherwise be considered to be speech once unmuted
+	REQUIRE_FALSE(processSeconds(detector, 5.0, 0.0, advss::minEnergyDb));
+	REQUIRE_FALSE(processSeconds(detector, 1.0, 100.0, -45.0));
+
+	// Starting with silence
+	advss::VoiceActivityDetector silentStart(sampleRate);
+	REQUIRE_FALSE(
+		processSeconds(silentStart, 1.0, 0.0, advss::minEnergyDb));
+	REQUIRE_FALSE(processSeconds(silentStart, 1.0, 100.0, -45.0));
+}
+
+TEST_CASE("Analysis throughput", "[.benchmark][audio-analysis]")
+{
+	// Analysis steps performed for each stereo source per block
+	constexpr int sourceCount = 8;
+	constexpr double seconds = 60.0;
+	const auto blocks = size_t(seconds * sampleRate / blockSize);
+
+	std::vector<advss::KWeighting> filters(2 * sourceCount,
+					       advss::KWeighting(sampleRate));
+	std::vector<advss::MomentaryWindow> windows(
+		sourceCount, advss::MomentaryWindow(sampleRate));
+	std::vector<advss::VoiceActivityDetector> detectors(
+		sourceCount, advss::VoiceActivityDetector(sampleRate));
+	auto input = sine(440.0, 0.5, blockSize);
+	std::vector<float> samples(blockSize);
+
+	const auto start = std::chrono::steady_clock::now();
+	for (size_t block = 0; block < blocks; block++) {
+		for (int source = 0; source < sourceCount; source++) {
+			detectors[source].Process(input.data(), blockSize);
+			double weighted = 0.0;
+			double unweighted = 0.0;
+			for (int channel = 0; channel < 2; channel++) {
+				samples = input;
+				unweighted += advss::SumOfSquares(
+					samples.data(), blockSize);
+				filters[source * 2 + channel].Process(
+					samples.data(), blockSize);
+				weighted += advss::SumOfSquares(samples.data(),
+								blockSize);
+			}
+			windows[source].Add(weighted, unweighted, blockSize);
+		}
+	}
+	const auto elapsed = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start);
+
+	WARN(sourceCount << " stereo sources: " << seconds
+			 << " s of audio analyzed in " << elapsed.count()
+			 << " s (" << 100.0 * elapsed.count() / seconds
+			 << "% of one core)");
+}
@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include <deadline-scheduler.hpp>
+
+using namespace std::chrono_literals;
+
+TEST_CASE("Earliest deadline is returned", "[deadline-scheduler]")
+{
+	advss::DeadlineScheduler scheduler;
+	const auto now = advss::DeadlineScheduler::Clock::now();
+	int a, b, c;
+
+	REQUIRE_FALSE(scheduler.NextDeadline(now));
+
+	scheduler.Schedule(&a, now + 3s);
+	scheduler.Schedule(&b, now + 1s);
+	scheduler.Schedule(&c, now + 2s);
+	REQUIRE(scheduler.Size() == 3);
+	REQUIRE(*scheduler.NextDeadline(now) == now + 1s);
+}
+
+TEST_CASE("Deadlines are replaced and cancelled", "[deadline-scheduler]")
+{
+	advss::DeadlineScheduler scheduler;
+	const auto now = advss::DeadlineScheduler::Clock::now();
+	int a, b;
+
+	scheduler.Schedule(&a, now + 1s);
+	scheduler.Schedule(&b, now + 2s);
+	scheduler.Schedule(&a, now + 3s);
+	REQUIRE(scheduler.Size() == 2);
+	REQUIRE(*scheduler.NextDeadline(now) == now + 2s);
+
+	scheduler.Cancel(&b);
+	REQUIRE(scheduler.Size() == 1);
+	REQUIRE(*scheduler.NextDeadline(now) == now + 3s);
+
+	scheduler.Cancel(&a);
+	REQUIRE(scheduler.Size() == 0);
+	REQUIRE_FALSE(scheduler.NextDeadline(now));
+}
+
+TEST_CASE("Reached deadlines are discarded", "[deadline-scheduler]")
+{
+	advss::DeadlineScheduler scheduler;
+	const auto now = advss::DeadlineScheduler::Clock::now();
+	int a, b;
+
+	scheduler.Schedule(&a, now + 1s);
+	scheduler.Schedule(&b, now + 2s);
+	REQUIRE(*scheduler.NextDeadline(now + 1s) == now + 2s);
+	REQUIRE(scheduler.Size() == 1);
+	REQUIRE_FALSE(scheduler.NextDeadline(now + 5s));
+	REQUIRE(scheduler.Size() == 0);
+}
+
+TEST_CASE("Frequently moved deadlines", "[deadline-scheduler]")
+{
+	advss::DeadlineScheduler scheduler;
+	const auto now = advss::DeadlineScheduler::Clock::now();
+	int a, b;
+
+	scheduler.Schedule(&b, now + 500s);
+	for (int i = 1000; i > 0; i--) {
+		scheduler.Schedule(&a, now + std::chrono::seconds(i));
+	}
+	REQUIRE(scheduler.Size() == 2);
+	REQUIRE(*scheduler.NextDeadline(now) == now + 1s);
+
+	for (int i = 1; i <= 1000; i++) {
+		scheduler.Schedule(&a, now + std::chrono::seconds(i));
+	}
+	REQUIRE(*scheduler.NextDeadline(now) == now + 500s);
+}
@@ -0,0 +1,94 @@
+#include "catch.hpp"
+
+#include <file-tail.hpp>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+static void writeFile(const QString &path, const QByteArray &data,
+		      bool append = true)
+{
+	QFile file(path);
+	QIODevice::OpenMode mode = QIODevice::WriteOnly;
+	if (append) {
+		mode |= QIODevice::Append;
+	}
+	REQUIRE(file.open(mode));
+	file.write(data);
+}
+
+TEST_CASE("Only appended lines are read", "[file-tail]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("log.txt");
+	writeFile(path, "old 1\nold 2\n");
+
+	advss::FileTail tail;
+	tail.SetPath(path);
+	REQUIRE(tail.ReadNewLines().isEmpty());
+
+	writeFile(path, "new 1\nnew");
+	REQUIRE(tail.ReadNewLines() == QStringList{"new 1"});
+	REQUIRE(tail.ReadNewLines().isEmpty());
+
+	writeFile(path, " 2\r\nnew 3\n");
+	REQUIRE(tail.ReadNewLines() == QStringList({"new 2", "new 3"}));
+}
+
+TEST_CASE("Truncated and replaced files", "[file-tail]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("log.txt");
+	writeFile(path, "old 1\nold 2\n");
+
+	advss::FileTail tail;
+	tail.SetPath(path);
+	REQUIRE(tail.ReadNewLines().isEmpty());
+
+	writeFile(path, "a\n", false);
+	REQUIRE(tail.ReadNewLines() == QStringList{"a"});
+
+	writeFile(path, "a file with different content\nb\n", false);
+	REQUIRE(tail.ReadNewLines() ==
+		QStringList({"a file with different content", "b"}));
+
+	REQUIRE(QFile::remove(path));
+	REQUIRE(tail.ReadNewLines().isEmpty());
+	writeFile(path, "c\n");
+	REQUIRE(tail.ReadNewLines() == QStringList{"c"});
+}
+
+TEST_CASE("File created later on is read from the start", "[file-tail]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("log.txt");
+
+	advss::FileTail tail;
+	tail.SetPath(path);
+	REQUIRE(tail.ReadNewLines().isEmpty());
+
+	writeFile(path, "a\nb\n");
+	REQUIRE(tail.ReadNewLines() == QStringList({"a", "b"}));
+}
+
+TEST_CASE("Rotated file with the same beginning", "[file-tail]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("log.txt");
+	writeFile(path, "header\n");
+
+	advss::FileTail tail;
+	tail.SetPath(path);
+	REQUIRE(tail.ReadNewLines().isEmpty());
+
+	writeFile(path, "old\n");
+	REQUIRE(tail.ReadNewLines() == QStringList{"old"});
+
+	// The new file starts with the content of the old one and is larger
+	REQUIRE(QFile::rename(path, dir.filePath("log.1.txt")));
+	writeFile(path, "header\nold\nnew\n");
+	REQUIRE(tail.ReadNewLines() == QStringList({"header", "old", "new"}));
+
+	writeFile(path, "newer\n");
+	REQUIRE(tail.ReadNewLines() == QStringList{"newer"});
+}
@@ -0,0 +1,161 @@
+#include "catch.hpp"
+
+#include <file-writer.hpp>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+static std::string readFile(const QString &path)
+{
+	QFile file(path);
+	if (!file.open(QIODevice::ReadOnly)) {
+		return "";
+	}
+	return file.readAll().toStdString();
+}
+
+TEST_CASE("Write and append", "[file-writer]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("file.txt");
+	const auto pathString = path.toStdString();
+
+	advss::FileWriter writer;
+	writer.Write(pathString, "a");
+	writer.Flush();
+	REQUIRE(readFile(path) == "a");
+
+	writer.Append(pathString, "b");
+	writer.Append(pathString, "c");
+	writer.Flush();
+	REQUIRE(readFile(path) == "abc");
+
+	writer.Write(pathString, "d", true);
+	writer.Flush();
+	REQUIRE(readFile(path) == "d");
+
+	writer.Stop();
+}
+
+TEST_CASE("Write and append ordering", "[file-writer]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("file.txt");
+	const auto pathString = path.toStdString();
+
+	advss::FileWriter writer;
+
+	// The result must not depend on which of these requests are coalesced
+	writer.Append(pathString, "1");
+	writer.Write(pathString, "2");
+	writer.Append(pathString, "3");
+	writer.Flush();
+	REQUIRE(readFile(path) == "23");
+
+	writer.Write(pathString, "4");
+	writer.Append(pathString, "5");
+	writer.Write(pathString, "6");
+	writer.Flush();
+	REQUIRE(readFile(path) == "6");
+
+	writer.Stop();
+}
+
+TEST_CASE("Coalesced appends", "[file-writer]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("file.txt");
+	const auto pathString = path.toStdString();
+
+	advss::FileWriter writer;
+	writer.Write(pathString, "");
+
+	constexpr int threadCount = 4;
+	constexpr int linesPerThread = 500;
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; t++) {
+		threads.emplace_back([&writer, &pathString, t]() {
+			for (int i = 0; i < linesPerThread; i++) {
+				writer.Append(pathString,
+					      std::to_string(t) + " " +
+						      std::to_string(i) + "\n");
+			}
+		});
+	}
+	for (auto &thread : threads) {
+		thread.join();
+	}
+	writer.Flush();
+
+	// No append may be lost and appends of the same thread must keep their
+	// order, even if they were combined with others into a single write
+	std::vector<int> next(threadCount, 0);
+	int lines = 0;
+	std::istringstream content(readFile(path));
+	int t = 0, i = 0;
+	while (content >> t >> i) {
+		REQUIRE(t >= 0);
+		REQUIRE(t < threadCount);
+		REQUIRE(i == next[t]);
+		next[t]++;
+		lines++;
+	}
+	REQUIRE(lines == threadCount * linesPerThread);
+
+	writer.Stop();
+}
+
+TEST_CASE("Files modified by others are rewritten", "[file-writer]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("file.txt");
+	const auto pathString = path.toStdString();
+
+	advss::FileWriter writer;
+	writer.Write(pathString, "content");
+	writer.Flush();
+	REQUIRE(readFile(path) == "content");
+
+	// Same content as before, so no write is needed
+	writer.Write(pathString, "content");
+	writer.Flush();
+	REQUIRE(readFile(path) == "content");
+
+	REQUIRE(QFile::remove(path));
+	writer.Write(pathString, "content");
+	writer.Flush();
+	REQUIRE(readFile(path) == "content");
+
+	{
+		QFile file(path);
+		REQUIRE(file.open(QIODevice::WriteOnly));
+		file.write("modified by someone else");
+	}
+	writer.Write(pathString, "content");
+	writer.Flush();
+	REQUIRE(readFile(path) == "content");
+
+	writer.Stop();
+}
+
+TEST_CASE("Requests after stopping", "[file-writer]")
+{
+	QTemporaryDir dir;
+	const auto path = dir.filePath("file.txt");
+	const auto pathString = path.toStdString();
+
+	advss::FileWriter writer;
+	writer.Write(pathString, "a");
+	writer.Stop();
+	REQUIRE(readFile(path) == "a");
+
+	// Processed right away without the background thread
+	writer.Append(pathString, "b");
+	REQUIRE(readFile(path) == "ab");
+	writer.Write(pathString, "c");
+	REQUIRE(readFile(path) == "c");
+}
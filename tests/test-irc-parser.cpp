@@ -0,0 +1,222 @@
+#include "catch.hpp"
+
+#include <irc-parser.hpp>
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+
+// Recorded from a busy channel with user names and IDs replaced
+static const std::vector<std::string> recordedTraffic = {
+	":tmi.twitch.tv 001 bot :Welcome, GLHF!",
+	":tmi.twitch.tv CAP * ACK :twitch.tv/tags twitch.tv/commands",
+	":bot!bot@bot.tmi.twitch.tv JOIN #channel",
+	"@badge-info=subscriber/12;badges=subscriber/12,premium/1;"
+	"client-nonce=abc;color=#1E90FF;display-name=User1;emotes=;"
+	"first-msg=0;flags=;id=11111111-2222-3333-4444-555555555555;mod=0;"
+	"returning-chatter=0;room-id=1234;subscriber=1;"
+	"tmi-sent-ts=1700000000000;turbo=0;user-id=5678;user-type= "
+	":user1!user1@user1.tmi.twitch.tv PRIVMSG #channel :!song",
+	"@badge-info=;badges=moderator/1,partner/1;bits=100;color=;"
+	"display-name=User2;emote-only=1;emotes=25:0-4;first-msg=1;"
+	"id=66666666-7777-8888-9999-000000000000;mod=1;room-id=1234;"
+	"subscriber=0;tmi-sent-ts=1700000000123;turbo=1;user-id=91011;"
+	"user-type=mod;vip=1 "
+	":user2!user2@user2.tmi.twitch.tv PRIVMSG #channel :Kappa",
+	"@badge-info=;badges=;color=;display-name=User3;emotes=;"
+	"id=12121212-3434-5656-7878-909090909090;mod=0;"
+	"reply-parent-display-name=User1;reply-parent-msg-body=!song;"
+	"reply-parent-msg-id=11111111-2222-3333-4444-555555555555;"
+	"reply-parent-user-id=5678;reply-parent-user-login=user1;"
+	"reply-thread-parent-msg-id=11111111-2222-3333-4444-555555555555;"
+	"reply-thread-parent-user-login=user1;subscriber=0;"
+	"tmi-sent-ts=1700000000456;turbo=0;user-id=1213;user-type= "
+	":user3!user3@user3.tmi.twitch.tv PRIVMSG #channel :@User1 same",
+	"@badges=;color=;display-name=User4;emotes=;message-id=1;"
+	"thread-id=1213_91011;turbo=0;user-id=1213;user-type= "
+	":user4!user4@user4.tmi.twitch.tv WHISPER bot :hi",
+	"@msg-id=subs_on :tmi.twitch.tv NOTICE #channel "
+	":This room is now in subscribers-only mode.",
+	":user5!user5@user5.tmi.twitch.tv PART #channel",
+	"PING :tmi.twitch.tv",
+	":tmi.twitch.tv RECONNECT",
+};
+
+static std::string joinMessages(const std::vector<std::string> &messages)
+{
+	std::string result;
+	for (const auto &message : messages) {
+		result += message + "\r\n";
+	}
+	return result;
+}
+
+TEST_CASE("Parse chat message", "[irc-parser]")
+{
+	advss::IRCMessage message;
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[4], message));
+	REQUIRE(message.command.command == "PRIVMSG");
+	REQUIRE(std::get<std::string>(message.command.parameters) ==
+		"#channel");
+	REQUIRE(message.source.nick == "user2");
+	REQUIRE(message.source.host == "user2@user2.tmi.twitch.tv");
+	REQUIRE(message.message == "Kappa");
+	REQUIRE(message.properties.badgesString == "moderator/1,partner/1");
+	REQUIRE(message.properties.badges.size() == 2);
+	REQUIRE(message.properties.badges[0].name == "moderator");
+	REQUIRE(message.properties.badges[0].enabled);
+	REQUIRE(message.properties.badges[1].name == "partner");
+	REQUIRE(message.properties.bits == 100);
+	REQUIRE(message.properties.displayName == "User2");
+	REQUIRE(message.properties.isUsingOnlyEmotes);
+	REQUIRE(message.properties.emotesString == "25:0-4");
+	REQUIRE(message.properties.isFirstMessage);
+	REQUIRE(message.properties.isMod);
+	REQUIRE_FALSE(message.properties.isSubscriber);
+	REQUIRE(message.properties.timestamp == 1700000000123);
+	REQUIRE(message.properties.isTurbo);
+	REQUIRE(message.properties.userId == "91011");
+	REQUIRE(message.properties.userType == "mod");
+	REQUIRE(message.properties.isVIP);
+
+	// Fields of the previous message must not leak into the next one
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[5], message));
+	REQUIRE(message.message == "@User1 same");
+	REQUIRE(message.properties.badges.empty());
+	REQUIRE(message.properties.badgesString.empty());
+	REQUIRE(message.properties.bits == 0);
+	REQUIRE_FALSE(message.properties.isMod);
+	REQUIRE_FALSE(message.properties.isVIP);
+	REQUIRE(message.properties.replyParentBody == "!song");
+	REQUIRE(message.properties.replyParentDisplayName == "User1");
+	REQUIRE(message.properties.replyParentId ==
+		"11111111-2222-3333-4444-555555555555");
+	REQUIRE(message.properties.replyParentUserId == "5678");
+	REQUIRE(message.properties.replyParentUserLogin == "user1");
+	REQUIRE(message.properties.rootParentId ==
+		"11111111-2222-3333-4444-555555555555");
+	REQUIRE(message.properties.rootParentUserLogin == "user1");
+}
+
+TEST_CASE("Parse commands", "[irc-parser]")
+{
+	advss::IRCMessage message;
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[1], message));
+	REQUIRE(message.command.command == "CAP");
+	REQUIRE(std::get<bool>(message.command.parameters));
+
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[2], message));
+	REQUIRE(message.command.command == "JOIN");
+	REQUIRE(std::get<std::string>(message.command.parameters) ==
+		"#channel");
+	REQUIRE(message.properties.joinedChannel);
+	REQUIRE(message.source.nick == "bot");
+
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[8], message));
+	REQUIRE(message.command.command == "PART");
+	REQUIRE(message.properties.leftChannel);
+	REQUIRE_FALSE(message.properties.joinedChannel);
+
+	REQUIRE(advss::ParseIRCMessage(recordedTraffic[9], message));
+	REQUIRE(message.command.command == "PING");
+	REQUIRE(std::get<std::string>(message.command.parameters).empty());
+	REQUIRE(message.message == "tmi.twitch.tv");
+	REQUIRE(message.source.host.empty());
+
+	REQUIRE_FALSE(advss::ParseIRCMessage("", message));
+	REQUIRE_FALSE(advss::ParseIRCMessage("@a=b", message));
+	REQUIRE_FALSE(advss::ParseIRCMessage(":tmi.twitch.tv", message));
+}
+
+TEST_CASE("Parse multiple messages", "[irc-parser]")
+{
+	advss::IRCMessage message;
+	std::vector<std::string> commands;
+	auto collectCommands = [&commands](const advss::IRCMessage &message) {
+		commands.emplace_back(message.command.command);
+	};
+
+	advss::ParseIRCMessages(joinMessages(recordedTraffic), message,
+				collectCommands);
+	REQUIRE(commands.size() == recordedTraffic.size());
+	REQUIRE(commands[3] == "PRIVMSG");
+	REQUIRE(commands[6] == "WHISPER");
+	REQUIRE(commands[7] == "NOTICE");
+
+	// Whitespace only lines and a missing final delimiter
+	commands.clear();
+	advss::ParseIRCMessages("\r\n \r\n\t\r\nPING :a\r\n  \r\nPING :b",
+				message, collectCommands);
+	REQUIRE(commands.size() == 2);
+	REQUIRE(message.message == "b");
+}
+
+TEST_CASE("Fuzz", "[irc-parser]")
+{
+	static constexpr char interestingChars[] = "@:;=, /!\r\n\t0";
+	std::mt19937 rng(42);
+	advss::IRCMessage message;
+	const auto traffic = joinMessages(recordedTraffic);
+
+	for (int i = 0; i < 20000; i++) {
+		auto input = traffic;
+		const int mutations = 1 + rng() % 8;
+		for (int j = 0; j < mutations && !input.empty(); j++) {
+			const size_t pos = rng() % input.size();
+			switch (rng() % 4) {
+			case 0:
+				input[pos] = static_cast<char>(rng());
+				break;
+			case 1:
+				input[pos] = interestingChars
+					[rng() % (sizeof(interestingChars) - 1)];
+				break;
+			case 2:
+				input.erase(pos, rng() % 32);
+				break;
+			case 3:
+				input.resize(pos);
+				break;
+			}
+		}
+		advss::ParseIRCMessages(input, message,
+					[](const advss::IRCMessage &message) {
+						REQUIRE_FALSE(
+							message.command.command
+								.empty());
+					});
+	}
+
+	for (int i = 0; i < 20000; i++) {
+		std::string input(rng() % 64, '\0');
+		for (auto &c : input) {
+			c = static_cast<char>(rng());
+		}
+		advss::ParseIRCMessage(input, message);
+	}
+}
+
+TEST_CASE("Throughput", "[.benchmark][irc-parser]")
+{
+	static constexpr int iterations = 100000;
+	const auto traffic = joinMessages(recordedTraffic);
+	advss::IRCMessage message;
+	size_t parsed = 0;
+
+	const auto start = std::chrono::steady_clock::now();
+	for (int i = 0; i < iterations; i++) {
+		advss::ParseIRCMessages(
+			traffic, message,
+			[&parsed](const advss::IRCMessage &) { parsed++; });
+	}
+	const auto duration = std::chrono::duration<double>(
+		std::chrono::steady_clock::now() - start);
+
+	REQUIRE(parsed == iterations * recordedTraffic.size());
+	WARN("Parsed " << static_cast<size_t>(parsed / duration.count())
+		       << " messages per second ("
+		       << traffic.size() * iterations / duration.count() /
+				  (1024 * 1024)
+		       << " MiB/s)");
+}
@@ -51,3 +51,32 @@ TEST_CASE("MatchJson", "[json-helpers]")
 	result = advss::MatchJson("{\n    \"test\": true\n}\n", "(", regex);
 	REQUIRE(result == false);
 }
+
+TEST_CASE("MatchJson only compares specified values", "[json-helpers]")
+{
+	advss::RegexConfig regex;
+	const std::string settings =
+		"{\"a\":1,\"b\":\"text\",\"c\":{\"d\":true,\"e\":[1,2]}}";
+
+	bool result = advss::MatchJson(settings, "{\"a\":1}", regex);
+	REQUIRE(result == true);
+
+	result = advss::MatchJson(settings, "{\"a\":1.0,\"b\":\"text\"}",
+				  regex);
+	REQUIRE(result == true);
+
+	result = advss::MatchJson(settings, "{\"c\":{\"d\":true}}", regex);
+	REQUIRE(result == true);
+
+	result = advss::MatchJson(settings, "{\"a\":2}", regex);
+	REQUIRE(result == false);
+
+	result = advss::MatchJson(settings, "{\"f\":1}", regex);
+	REQUIRE(result == false);
+
+	result = advss::MatchJson(settings, "{\"c\":{\"e\":[1]}}", regex);
+	REQUIRE(result == false);
+
+	result = advss::MatchJson("{\"a\":1}", settings, regex);
+	REQUIRE(result == false);
+}
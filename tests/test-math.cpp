@@ -2,6 +2,8 @@
 
 #include <math-helpers.hpp>
 
+#include <map>
+
 TEST_CASE("Expressions are evaluated successfully", "[math-helpers]")
 {
 	auto expressionResult = advss::EvalMathExpression("1");
@@ -94,6 +96,52 @@ TEST_CASE("Invalid expressions are not evaluated", "[math-helpers]")
 	REQUIRE(doubleValuePtr == nullptr);
 }
 
+TEST_CASE("Variables are bound to expressions", "[math-helpers]")
+{
+	std::map<std::string, double> values = {{"a", 1.0}, {"b c", 2.0}};
+	auto lookup = [&values](const std::string &name)
+		-> std::optional<double> {
+		auto it = values.find(name);
+		if (it == values.end()) {
+			return {};
+		}
+		return it->second;
+	};
+
+	auto expressionResult =
+		advss::EvalMathExpression("${a} + ${b c} * ${a}", lookup);
+	auto *doubleValuePtr = std::get_if<double>(&expressionResult);
+
+	REQUIRE(doubleValuePtr != nullptr);
+	REQUIRE(*doubleValuePtr == 3.0);
+
+	// The same expression is evaluated using the updated values
+	values["a"] = -2.0;
+	expressionResult =
+		advss::EvalMathExpression("${a} + ${b c} * ${a}", lookup);
+	doubleValuePtr = std::get_if<double>(&expressionResult);
+
+	REQUIRE(doubleValuePtr != nullptr);
+	REQUIRE(*doubleValuePtr == -6.0);
+
+	expressionResult = advss::EvalMathExpression("2 ^ ${a}", lookup);
+	doubleValuePtr = std::get_if<double>(&expressionResult);
+
+	REQUIRE(doubleValuePtr != nullptr);
+	REQUIRE(*doubleValuePtr == 0.25);
+
+	expressionResult = advss::EvalMathExpression("${unknown} + 1", lookup);
+	doubleValuePtr = std::get_if<double>(&expressionResult);
+
+	REQUIRE(doubleValuePtr == nullptr);
+
+	// References are not resolved without a lookup function
+	expressionResult = advss::EvalMathExpression("${a} + 1");
+	doubleValuePtr = std::get_if<double>(&expressionResult);
+
+	REQUIRE(doubleValuePtr == nullptr);
+}
+
 TEST_CASE("IsValidNumber", "[math-helpers]")
 {
 	REQUIRE(advss::IsValidNumber("1"));
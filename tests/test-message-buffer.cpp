@@ -0,0 +1,216 @@
+#include "catch.hpp"
+
+#include <message-dispatcher.hpp>
+
+#include <string>
+#include <thread>
+
+TEST_CASE("Dispatch", "[message-buffer]")
+{
+	advss::MessageDispatcher<std::string> dispatcher;
+	auto buffer = dispatcher.RegisterClient();
+	REQUIRE(buffer->Empty());
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+
+	dispatcher.DispatchMessage(std::string("a"));
+	dispatcher.DispatchMessage(std::string("b"));
+	REQUIRE_FALSE(buffer->Empty());
+
+	auto message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == "a");
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == "b");
+	REQUIRE(buffer->Empty());
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+}
+
+TEST_CASE("Multiple clients", "[message-buffer]")
+{
+	advss::MessageDispatcher<std::string> dispatcher;
+	auto buffer1 = dispatcher.RegisterClient();
+	dispatcher.DispatchMessage(std::string("a"));
+	auto buffer2 = dispatcher.RegisterClient();
+	dispatcher.DispatchMessage(std::string("b"));
+
+	// Clients only receive messages dispatched after registering
+	auto message1 = buffer1->ConsumeMessage();
+	REQUIRE(message1);
+	REQUIRE(*message1 == "a");
+	auto message2 = buffer2->ConsumeMessage();
+	REQUIRE(message2);
+	REQUIRE(*message2 == "b");
+
+	// Messages are shared between clients
+	message1 = buffer1->ConsumeMessage();
+	REQUIRE(message1);
+	REQUIRE(message1 == message2);
+
+	REQUIRE(buffer1->Empty());
+	REQUIRE(buffer2->Empty());
+}
+
+TEST_CASE("Clear", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto buffer1 = dispatcher.RegisterClient();
+	auto buffer2 = dispatcher.RegisterClient();
+	dispatcher.DispatchMessage(1);
+	dispatcher.DispatchMessage(2);
+
+	buffer1->Clear();
+	REQUIRE(buffer1->Empty());
+	REQUIRE_FALSE(buffer1->ConsumeMessage());
+
+	// Other clients are not affected
+	auto message = buffer2->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 1);
+
+	dispatcher.DispatchMessage(3);
+	message = buffer1->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 3);
+}
+
+TEST_CASE("Overflow", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher(4);
+	auto buffer = dispatcher.RegisterClient();
+	for (int i = 0; i < 10; i++) {
+		dispatcher.DispatchMessage(i);
+	}
+
+	// Only the most recent messages are still available
+	auto message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 7);
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 8);
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 9);
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+}
+
+TEST_CASE("Concurrent dispatch and consume", "[message-buffer]")
+{
+	constexpr int messageCount = 100000;
+	advss::MessageDispatcher<int> dispatcher(16);
+	auto buffer = dispatcher.RegisterClient();
+
+	std::thread producer([&dispatcher]() {
+		for (int i = 1; i <= messageCount; i++) {
+			dispatcher.DispatchMessage(i);
+		}
+	});
+
+	// Messages might be skipped, but must be received in order
+	int last = 0;
+	while (last != messageCount) {
+		auto message = buffer->ConsumeMessage();
+		if (!message) {
+			continue;
+		}
+		REQUIRE(*message > last);
+		last = *message;
+	}
+	producer.join();
+	REQUIRE(buffer->Empty());
+}
+
+TEST_CASE("Drop oldest", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto buffer = dispatcher.RegisterClient();
+	buffer->SetLimit(3, advss::MessageBufferPolicy::DROP_OLDEST);
+	for (int i = 0; i < 5; i++) {
+		dispatcher.DispatchMessage(i);
+	}
+
+	for (int expected : {2, 3, 4}) {
+		auto message = buffer->ConsumeMessage();
+		REQUIRE(message);
+		REQUIRE(*message == expected);
+	}
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+
+	auto stats = buffer->GetStats();
+	REQUIRE(stats.pending == 0);
+	REQUIRE(stats.highWaterMark == 5);
+	REQUIRE(stats.dropped == 2);
+}
+
+TEST_CASE("Drop newest", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto buffer = dispatcher.RegisterClient();
+	buffer->SetLimit(2, advss::MessageBufferPolicy::DROP_NEWEST);
+	for (int i = 0; i < 5; i++) {
+		dispatcher.DispatchMessage(i);
+	}
+
+	auto message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 0);
+
+	// Messages received after the limit was reached are dropped, even
+	// if they arrive while the kept messages are consumed
+	dispatcher.DispatchMessage(5);
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 1);
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 5);
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+
+	auto stats = buffer->GetStats();
+	REQUIRE(stats.dropped == 3);
+	REQUIRE(stats.highWaterMark == 5);
+}
+
+TEST_CASE("Coalesce", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher;
+	auto buffer = dispatcher.RegisterClient();
+	buffer->SetLimit(2, advss::MessageBufferPolicy::COALESCE);
+	dispatcher.DispatchMessage(0);
+	dispatcher.DispatchMessage(1);
+
+	// Limit not exceeded
+	auto message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 0);
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 1);
+
+	for (int i = 2; i < 6; i++) {
+		dispatcher.DispatchMessage(i);
+	}
+	message = buffer->ConsumeMessage();
+	REQUIRE(message);
+	REQUIRE(*message == 5);
+	REQUIRE_FALSE(buffer->ConsumeMessage());
+	REQUIRE(buffer->GetStats().dropped == 3);
+}
+
+TEST_CASE("Pending messages", "[message-buffer]")
+{
+	advss::MessageDispatcher<int> dispatcher(4);
+	auto buffer = dispatcher.RegisterClient();
+	dispatcher.DispatchMessage(0);
+	dispatcher.DispatchMessage(1);
+	REQUIRE(buffer->GetStats().pending == 2);
+
+	for (int i = 2; i < 10; i++) {
+		dispatcher.DispatchMessage(i);
+	}
+	REQUIRE(buffer->GetStats().pending == 3);
+	(void)buffer->ConsumeMessage();
+	REQUIRE(buffer->GetStats().dropped == 7);
+	REQUIRE(buffer->GetStats().pending == 2);
+}
@@ -0,0 +1,57 @@
+#include "catch.hpp"
+
+#include <message-id-history.hpp>
+
+#include <string>
+
+TEST_CASE("Duplicate IDs are detected", "[message-id-history]")
+{
+	advss::MessageIDHistory history;
+	REQUIRE(history.Add("a"));
+	REQUIRE(history.Add("b"));
+	REQUIRE_FALSE(history.Add("a"));
+	REQUIRE_FALSE(history.Add("b"));
+	REQUIRE(history.Add("c"));
+
+	// Detection does not only consider the last received ID
+	REQUIRE(history.Add("d"));
+	REQUIRE_FALSE(history.Add("c"));
+	REQUIRE_FALSE(history.Add("a"));
+}
+
+TEST_CASE("Oldest IDs are forgotten", "[message-id-history]")
+{
+	advss::MessageIDHistory history(3);
+	REQUIRE(history.Add("1"));
+	REQUIRE(history.Add("2"));
+	REQUIRE(history.Add("3"));
+	REQUIRE(history.Add("4"));
+
+	// "1" was dropped to make room for "4"
+	REQUIRE(history.Add("1"));
+	REQUIRE_FALSE(history.Add("3"));
+	REQUIRE_FALSE(history.Add("4"));
+
+	// Duplicates do not change the order, so "2" was dropped for "1"
+	REQUIRE(history.Add("2"));
+	REQUIRE_FALSE(history.Add("1"));
+}
+
+TEST_CASE("Many unique IDs", "[message-id-history]")
+{
+	advss::MessageIDHistory history;
+	for (int i = 0; i < 1000; i++) {
+		REQUIRE(history.Add(std::to_string(i)));
+	}
+	REQUIRE_FALSE(history.Add("999"));
+	REQUIRE_FALSE(history.Add("744"));
+	REQUIRE(history.Add("743"));
+}
+
+TEST_CASE("Clear", "[message-id-history]")
+{
+	advss::MessageIDHistory history;
+	REQUIRE(history.Add("a"));
+	history.Clear();
+	REQUIRE(history.Add("a"));
+}
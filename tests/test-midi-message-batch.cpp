@@ -0,0 +1,74 @@
+#include "catch.hpp"
+
+#include <midi-message-batch.hpp>
+
+static advss::RawMidiMessage controlChange(unsigned char channel,
+					   unsigned char controller,
+					   unsigned char value)
+{
+	return {{static_cast<unsigned char>(0xB0 | channel), controller,
+		 value},
+		3};
+}
+
+static advss::RawMidiMessage noteOn(unsigned char note, unsigned char velocity)
+{
+	return {{0x90, note, velocity}, 3};
+}
+
+static std::vector<int> values(const std::vector<advss::RawMidiMessage> &batch)
+{
+	std::vector<int> result;
+	for (const auto &message : batch) {
+		result.emplace_back(message.bytes[2]);
+	}
+	return result;
+}
+
+TEST_CASE("Fader updates are coalesced", "[midi-message-batch]")
+{
+	advss::MidiMessageBatch batch;
+	REQUIRE(batch.Empty());
+	for (unsigned char value = 0; value < 100; value++) {
+		batch.Add(controlChange(0, 7, value));
+	}
+	REQUIRE(batch.All().size() == 100);
+	REQUIRE(values(batch.Coalesced()) == std::vector<int>{99});
+}
+
+TEST_CASE("Button press and release", "[midi-message-batch]")
+{
+	advss::MidiMessageBatch batch;
+	batch.Add(controlChange(0, 64, 127));
+	batch.Add(controlChange(0, 64, 0));
+
+	// Listeners checking the value need to receive both
+	REQUIRE(values(batch.All()) == std::vector<int>{127, 0});
+	REQUIRE(values(batch.Coalesced()) == std::vector<int>{0});
+
+	// Both views stay available until the batch is cleared
+	REQUIRE(values(batch.All()) == std::vector<int>{127, 0});
+
+	batch.Clear();
+	REQUIRE(batch.Empty());
+	REQUIRE(batch.Coalesced().empty());
+	batch.Add(controlChange(0, 64, 127));
+	REQUIRE(values(batch.Coalesced()) == std::vector<int>{127});
+}
+
+TEST_CASE("Coalescing keeps other messages", "[midi-message-batch]")
+{
+	advss::MidiMessageBatch batch;
+	batch.Add(controlChange(0, 1, 10));
+	batch.Add(noteOn(60, 100));
+	batch.Add(controlChange(1, 1, 20));
+	batch.Add(controlChange(0, 2, 30));
+	batch.Add(controlChange(0, 1, 11));
+	batch.Add(noteOn(60, 0));
+
+	// Different channels and controllers are not combined and the order
+	// of the remaining messages is kept
+	REQUIRE(values(batch.Coalesced()) ==
+		std::vector<int>{100, 20, 30, 11, 0});
+	REQUIRE(batch.All().size() == 6);
+}
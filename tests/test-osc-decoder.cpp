@@ -0,0 +1,201 @@
+#include "catch.hpp"
+
+#include <osc-decoder.hpp>
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using Packet = std::vector<char>;
+
+static void appendInt32(Packet &packet, uint32_t value)
+{
+	for (int shift = 24; shift >= 0; shift -= 8) {
+		packet.push_back(static_cast<char>((value >> shift) & 0xFF));
+	}
+}
+
+static void appendString(Packet &packet, const std::string &value)
+{
+	packet.insert(packet.end(), value.begin(), value.end());
+	do {
+		packet.push_back('\0');
+	} while (packet.size() % 4 != 0);
+}
+
+static Packet createMessage(const std::string &address, int32_t value)
+{
+	Packet message;
+	appendString(message, address);
+	appendString(message, ",is");
+	appendInt32(message, static_cast<uint32_t>(value));
+	appendString(message, "text");
+	return message;
+}
+
+static Packet createBundle(const std::vector<Packet> &elements)
+{
+	Packet bundle;
+	appendString(bundle, "#bundle");
+	appendInt32(bundle, 0);
+	appendInt32(bundle, 1);
+	for (const auto &element : elements) {
+		appendInt32(bundle, static_cast<uint32_t>(element.size()));
+		bundle.insert(bundle.end(), element.begin(), element.end());
+	}
+	return bundle;
+}
+
+static bool decode(const Packet &packet,
+		   std::vector<advss::OSCReceivedMessage> &messages)
+{
+	return advss::DecodeOSCPacket(packet.data(), packet.size(), messages);
+}
+
+TEST_CASE("Message", "[osc-decoder]")
+{
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE(decode(createMessage("/test", -5), messages));
+	REQUIRE(messages.size() == 1);
+	REQUIRE(messages[0].address == "/test");
+	REQUIRE(messages[0].arguments ==
+		std::vector<std::string>{"-5", "text"});
+	REQUIRE(messages[0].ToString() == "/test -5 text");
+}
+
+TEST_CASE("Nested bundles", "[osc-decoder]")
+{
+	auto innermost = createBundle({createMessage("/c", 3)});
+	auto inner = createBundle({createMessage("/b", 2), innermost});
+	auto outer = createBundle({createMessage("/a", 1), inner});
+
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE(decode(outer, messages));
+	REQUIRE(messages.size() == 3);
+	REQUIRE(messages[0].ToString() == "/a 1 text");
+	REQUIRE(messages[1].ToString() == "/b 2 text");
+	REQUIRE(messages[2].ToString() == "/c 3 text");
+
+	// Empty bundles are valid
+	messages.clear();
+	REQUIRE(decode(createBundle({}), messages));
+	REQUIRE(messages.empty());
+}
+
+TEST_CASE("Bundles nested too deeply", "[osc-decoder]")
+{
+	auto packet = createMessage("/deep", 1);
+	for (int i = 0; i < 8; i++) {
+		packet = createBundle({packet});
+	}
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE(decode(packet, messages));
+	REQUIRE(messages.size() == 1);
+
+	packet = createBundle({packet});
+	messages.clear();
+	REQUIRE_FALSE(decode(packet, messages));
+}
+
+TEST_CASE("Truncated packets", "[osc-decoder]")
+{
+	const auto message = createMessage("/test", 1);
+	const auto bundle =
+		createBundle({createMessage("/a", 1), createMessage("/b", 2)});
+
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE_FALSE(decode({}, messages));
+
+	// Every truncation, which keeps the size aligned
+	for (size_t size = 4; size < message.size(); size += 4) {
+		Packet truncated(message.begin(), message.begin() + size);
+		// A message without type tags
+		if (size == 8) {
+			continue;
+		}
+		messages.clear();
+		INFO("message size " << size);
+		REQUIRE_FALSE(decode(truncated, messages));
+	}
+	for (size_t size = 4; size < bundle.size(); size += 4) {
+		Packet truncated(bundle.begin(), bundle.begin() + size);
+		// The bundle is valid, if it ends after a complete element
+		if (size == 16 || size == 40) {
+			continue;
+		}
+		messages.clear();
+		INFO("bundle size " << size);
+		REQUIRE_FALSE(decode(truncated, messages));
+	}
+
+	// String argument without terminator
+	Packet unterminated;
+	appendString(unterminated, "/test");
+	appendString(unterminated, ",s");
+	unterminated.insert(unterminated.end(), {'a', 'b', 'c', 'd'});
+	messages.clear();
+	REQUIRE_FALSE(decode(unterminated, messages));
+}
+
+TEST_CASE("Misaligned packets", "[osc-decoder]")
+{
+	auto message = createMessage("/test", 1);
+	message.push_back('\0');
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE_FALSE(decode(message, messages));
+
+	// Element size, which is not a multiple of 4
+	Packet element;
+	appendString(element, "/a");
+	element.push_back('\0');
+	auto bundle = createBundle({element});
+	bundle.insert(bundle.end(), 3, '\0');
+	messages.clear();
+	REQUIRE_FALSE(decode(bundle, messages));
+}
+
+TEST_CASE("Oversized elements", "[osc-decoder]")
+{
+	auto bundle = createBundle({createMessage("/a", 1)});
+	// Overwrite the element size with a value exceeding the packet
+	for (uint32_t size : {0x00000100u, 0x7FFFFFFCu, 0xFFFFFFFCu}) {
+		Packet oversized(bundle.begin(), bundle.begin() + 16);
+		appendInt32(oversized, size);
+		oversized.insert(oversized.end(), bundle.begin() + 20,
+				 bundle.end());
+		std::vector<advss::OSCReceivedMessage> messages;
+		INFO("element size " << size);
+		REQUIRE_FALSE(decode(oversized, messages));
+	}
+
+	// Blob size exceeding the packet
+	Packet blob;
+	appendString(blob, "/blob");
+	appendString(blob, ",b");
+	appendInt32(blob, 0xFFFFFFFF);
+	appendInt32(blob, 0);
+	std::vector<advss::OSCReceivedMessage> messages;
+	REQUIRE_FALSE(decode(blob, messages));
+}
+
+TEST_CASE("Invalid content", "[osc-decoder]")
+{
+	std::vector<advss::OSCReceivedMessage> messages;
+
+	Packet noAddress;
+	appendString(noAddress, "test");
+	REQUIRE_FALSE(decode(noAddress, messages));
+
+	Packet unknownType;
+	appendString(unknownType, "/test");
+	appendString(unknownType, ",x");
+	appendInt32(unknownType, 0);
+	REQUIRE_FALSE(decode(unknownType, messages));
+
+	// Type tags might be omitted
+	Packet noTypeTags;
+	appendString(noTypeTags, "/test");
+	REQUIRE(decode(noTypeTags, messages));
+	REQUIRE(messages.size() == 1);
+	REQUIRE(messages[0].arguments.empty());
+}
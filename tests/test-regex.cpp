@@ -88,3 +88,44 @@ TEST_CASE("EscapeForRegex , [text-helpers]")
 	REQUIRE(advss::EscapeForRegex("(abcdefg)") == "\\(abcdefg\\)");
 	REQUIRE(advss::EscapeForRegex("\\(abcdefg)") == "\\\\(abcdefg\\)");
 }
+
+TEST_CASE("Matches (literal prefix)", "[regex-config]")
+{
+	advss::RegexConfig regex(true);
+	REQUIRE(regex.Matches(std::string("!song abc"), "!song.*"));
+	REQUIRE_FALSE(regex.Matches(std::string("x !song"), "!song.*"));
+	REQUIRE(regex.Matches(std::string("ac"), "ab*c"));
+	REQUIRE(regex.Matches(std::string("ac"), "ab?c"));
+	REQUIRE(regex.Matches(std::string("b"), "a|b"));
+
+	regex.SetPatternOptions(QRegularExpression::CaseInsensitiveOption);
+	REQUIRE(regex.Matches(std::string("!song abc"), "!SONG.*"));
+
+	regex = advss::RegexConfig::PartialMatchRegexConfig(true);
+	REQUIRE(regex.Matches(std::string("x !song"), "!song"));
+	REQUIRE_FALSE(regex.Matches(std::string("x !song"), "^!song"));
+	REQUIRE(regex.Matches(std::string("!song"), "^!song"));
+}
+
+TEST_CASE("Matches (cached expressions)", "[regex-config]")
+{
+	// The same expression has to be compiled separately for each
+	// combination of options
+	advss::RegexConfig regex(true);
+	REQUIRE_FALSE(regex.Matches(std::string("abc"), "a"));
+	REQUIRE_FALSE(regex.Matches(std::string("A"), "a"));
+
+	auto partialRegex = advss::RegexConfig::PartialMatchRegexConfig(true);
+	REQUIRE(partialRegex.Matches(std::string("abc"), "a"));
+	REQUIRE_FALSE(regex.Matches(std::string("abc"), "a"));
+
+	regex.SetPatternOptions(QRegularExpression::CaseInsensitiveOption);
+	REQUIRE(regex.Matches(std::string("A"), "a"));
+
+	// Exceeding the size of the cache must not affect the results
+	for (int i = 0; i < 1000; i++) {
+		const auto value = std::to_string(i);
+		REQUIRE(regex.Matches(value, value));
+		REQUIRE_FALSE(regex.Matches(value + "x", value));
+	}
+}
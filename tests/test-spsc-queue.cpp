@@ -0,0 +1,61 @@
+#include "catch.hpp"
+
+#include <spsc-queue.hpp>
+
+#include <thread>
+
+TEST_CASE("Push and pop", "[spsc-queue]")
+{
+	advss::SPSCQueue<int> queue(3);
+	REQUIRE(queue.Capacity() == 4);
+	REQUIRE(queue.Empty());
+
+	int value = 0;
+	REQUIRE_FALSE(queue.Pop(value));
+
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(queue.Push(i));
+	}
+	REQUIRE_FALSE(queue.Empty());
+
+	// The oldest entries are kept if the queue is full
+	REQUIRE_FALSE(queue.Push(4));
+	for (int i = 0; i < 4; i++) {
+		REQUIRE(queue.Pop(value));
+		REQUIRE(value == i);
+	}
+	REQUIRE(queue.Empty());
+	REQUIRE_FALSE(queue.Pop(value));
+
+	// Wrap around
+	REQUIRE(queue.Push(5));
+	REQUIRE(queue.Pop(value));
+	REQUIRE(value == 5);
+}
+
+TEST_CASE("Concurrent push and pop", "[spsc-queue]")
+{
+	constexpr int valueCount = 100000;
+	advss::SPSCQueue<int> queue(16);
+
+	std::thread producer([&queue]() {
+		for (int i = 1; i <= valueCount; i++) {
+			while (!queue.Push(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	// No value must be lost or reordered
+	int expected = 1;
+	while (expected <= valueCount) {
+		int value;
+		if (!queue.Pop(value)) {
+			continue;
+		}
+		REQUIRE(value == expected);
+		expected++;
+	}
+	producer.join();
+	REQUIRE(queue.Empty());
+}
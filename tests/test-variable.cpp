@@ -1,7 +1,11 @@
 #include "catch.hpp"
 
 #include <variable.hpp>
+
+#include <atomic>
+#include <chrono>
 #include <thread>
+#include <vector>
 
 TEST_CASE("Variable", "[variable]")
 {
@@ -50,3 +54,85 @@ TEST_CASE("Variable", "[variable]")
 	variable.SetValue(123);
 	REQUIRE(*variable.GetSecondsSinceLastChange() > 0);
 }
+
+TEST_CASE("Numeric values", "[variable]")
+{
+	advss::Variable variable;
+	REQUIRE_FALSE(variable.DoubleValue());
+	REQUIRE_FALSE(variable.IncrementValue(1.0));
+
+	variable.SetValue("5");
+	REQUIRE(*variable.DoubleValue() == 5.0);
+	REQUIRE(*variable.IntValue() == 5);
+
+	REQUIRE(variable.IncrementValue(2.0));
+	REQUIRE(*variable.DoubleValue() == 7.0);
+	REQUIRE(*variable.IntValue() == 7);
+	REQUIRE(variable.Value() == "7");
+	REQUIRE(variable.GetPreviousValue() == "5");
+	REQUIRE(variable.GetValueChangeCount() == 2);
+
+	REQUIRE(variable.IncrementValue(-0.5));
+	REQUIRE(*variable.DoubleValue() == 6.5);
+	REQUIRE_FALSE(variable.IntValue());
+	REQUIRE(variable.Value() == "6.5");
+
+	variable.SetValue(6.5);
+	REQUIRE(variable.GetValueChangeCount() == 3);
+
+	variable.SetValue("1.0");
+	REQUIRE(*variable.DoubleValue() == 1.0);
+	REQUIRE_FALSE(variable.IntValue());
+	variable.SetValue(1.0);
+	REQUIRE(variable.Value() == "1");
+	REQUIRE(variable.GetValueChangeCount() == 5);
+
+	variable.SetValue("abc");
+	REQUIRE_FALSE(variable.DoubleValue());
+	REQUIRE_FALSE(variable.IncrementValue(1.0));
+	REQUIRE(variable.Value() == "abc");
+}
+
+TEST_CASE("Concurrent access", "[.benchmark][variable]")
+{
+	constexpr int readerCount = 8;
+	constexpr auto duration = std::chrono::seconds(2);
+
+	advss::Variable variable;
+	variable.SetValue("0");
+	std::atomic_bool stop{false};
+	std::atomic_bool invalidValueRead{false};
+	std::atomic<uint64_t> reads{0};
+
+	std::vector<std::thread> readers;
+	for (int i = 0; i < readerCount; i++) {
+		readers.emplace_back([&]() {
+			uint64_t count = 0;
+			while (!stop) {
+				if (variable.Value().empty()) {
+					invalidValueRead = true;
+				}
+				count++;
+			}
+			reads += count;
+		});
+	}
+
+	uint64_t writes = 0;
+	const auto start = std::chrono::steady_clock::now();
+	while (std::chrono::steady_clock::now() - start < duration) {
+		// Values set as strings are published right away, so readers
+		// never have to lock to format a numeric value
+		variable.SetValue(std::to_string(writes));
+		writes++;
+	}
+	stop = true;
+	for (auto &reader : readers) {
+		reader.join();
+	}
+
+	WARN(readerCount << " readers: " << reads << " reads, 1 writer: "
+			 << writes << " writes in " << duration.count()
+			 << " s");
+	REQUIRE_FALSE(invalidValueRead);
+}